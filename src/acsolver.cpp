@@ -38,6 +38,7 @@
 #include "analysis.h"
 #include "nasolver.h"
 #include "acsolver.h"
+#include "profile.h"
 
 namespace qucs {
 
@@ -81,6 +82,10 @@ int acsolver::solve (void) {
   // run additional noise analysis ?
   noise = !strcmp (getPropertyString ("Noise"), "yes") ? 1 : 0;
 
+  // compute sensitivities of some output ?
+  const char * sens = isPropertyGiven ("SensOutput") ?
+    getPropertyString ("SensOutput") : NULL;
+
   // create frequency sweep if necessary
   if (swp == NULL) {
     swp = createSweep ("acfrequency");
@@ -90,6 +95,7 @@ int acsolver::solve (void) {
   // generate extra circuits if necessary
   init ();
   setCalculation ((calculate_func_t) &calc);
+  setStamping ((stamp_func_t) &stamp);
   solve_pre ();
 
   swp->reset ();
@@ -106,6 +112,10 @@ int acsolver::solve (void) {
     eqnAlgo = ALGO_LU_DECOMPOSITION;
     solve_linear ();
 
+    // compute sensitivities if requested, before the noise analysis
+    // replaces the LU decomposition of the MNA matrix
+    if (sens) solve_sensitivity (sens, "v", "i", frequencyDependency ());
+
     // compute noise if requested
     if (noise) solve_noise ();
 
@@ -122,11 +132,19 @@ int acsolver::solve (void) {
 void acsolver::calc (acsolver * self) {
   circuit * root = self->getNet()->getRoot ();
   for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ()) {
+    profile_device pd (c);
     c->calcAC (self->freq);
     if (self->noise) c->calcNoiseAC (self->freq);
   }
 }
 
+/* Stamps the given circuit alone, used to obtain the derivatives of
+   its MNA entries with respect to its properties. */
+void acsolver::stamp (acsolver * self, circuit * c) {
+  c->initAC ();
+  c->calcAC (self->freq);
+}
+
 /* Goes through the list of circuit objects and runs its initAC()
    function. */
 void acsolver::init (void) {
@@ -141,12 +159,8 @@ void acsolver::init (void) {
 /* This function saves the results of a single solve() functionality
    (for the given frequency) into the output dataset. */
 void acsolver::saveAllResults (nr_double_t freq) {
-  qucs::vector * f;
+  qucs::vector * f = frequencyDependency ();
   // add current frequency to the dependency of the output dataset
-  if ((f = data->findDependency ("acfrequency")) == NULL) {
-    f = new qucs::vector ("acfrequency");
-    data->addDependency (f);
-  }
   if (runs == 1) f->add (freq);
   saveResults ("v", "i", 0, f);
 
@@ -156,6 +170,17 @@ void acsolver::saveAllResults (nr_double_t freq) {
   }
 }
 
+/* Returns the frequency dependency of the output dataset, created if
+   necessary. */
+qucs::vector * acsolver::frequencyDependency (void) {
+  qucs::vector * f;
+  if ((f = data->findDependency ("acfrequency")) == NULL) {
+    f = new qucs::vector ("acfrequency");
+    data->addDependency (f);
+  }
+  return f;
+}
+
 /* The function computes the final noise results and puts them into
    the output dataset. */
 void acsolver::saveNoiseResults (qucs::vector * f) {
@@ -197,7 +222,7 @@ void acsolver::solve_noise (void) {
   // create noise result vector if necessary
   if (xn == NULL) xn = new tvector<nr_double_t> (N + M);
 
-  // temporary result vector for transimpedances
+  // preallocated product of transimpedances and correlation matrix
   tvector<nr_complex_t> zn = tvector<nr_complex_t> (N + M);
 
   // create the MNA matrix once again and LU decompose the adjoint matrix
@@ -215,10 +240,12 @@ void acsolver::solve_noise (void) {
   for (int i = 0; i < N + M; i++) {
     z->set (0); z->set (i, -1); // modify right hand side appropriately
     runMNA ();                  // solve
-    zn = *x;                    // save transimpedance vector
 
-    // compute actual noise voltage
-    xn->set (i, sqrt (real (scalar (zn * (*C), conj (zn)))));
+    // compute actual noise voltage x^T * C * conj (x)
+    gevm (*x, *C, zn);
+    nr_complex_t n = 0.0;
+    for (int c = 0; c < N + M; c++) n += zn (c) * conj ((*x) (c));
+    xn->set (i, sqrt (real (n)));
   }
 
   // restore usual AC results
@@ -235,6 +262,8 @@ PROP_OPT [] = {
   { "Stop", PROP_REAL, { 10e9, PROP_NO_STR }, PROP_POS_RANGE },
   { "Points", PROP_INT, { 10, PROP_NO_STR }, PROP_MIN_VAL (2) },
   { "Values", PROP_LIST, { 10, PROP_NO_STR }, PROP_POS_RANGE },
+  { "Ordering", PROP_STR, { PROP_NO_VAL, "none" }, PROP_RNG_ORD },
+  { "SensOutput", PROP_STR, { PROP_NO_VAL, "" }, PROP_NO_RANGE },
   PROP_NO_PROP };
 struct define_t acsolver::anadef =
   { "AC", 0, PROP_ACTION, PROP_NO_SUBSTRATE, PROP_LINEAR, PROP_DEF };
@@ -42,8 +42,10 @@ class acsolver : public nasolver<nr_complex_t>
   int  solve (void);
   void solve_noise (void);
   static void calc (acsolver *);
+  static void stamp (acsolver *, circuit *);
   void init (void);
   void saveAllResults (nr_double_t);
+  qucs::vector * frequencyDependency (void);
   void saveNoiseResults (qucs::vector *);
 
  private:
@@ -37,9 +37,11 @@
 #include "spsolver.h"
 #include "dcsolver.h"
 #include "parasweep.h"
+#include "montecarlo.h"
 #include "acsolver.h"
 #include "trsolver.h"
 #include "hbsolver.h"
+#include "psssolver.h"
 #include "e_trsolver.h"
 
 #endif /* __ANALYSES_H__ */
@@ -67,7 +67,8 @@ enum analysis_type
     ANALYSIS_HBALANCE,
     ANALYSIS_TRANSIENT,
     ANALYSIS_SPARAMETER,
-    ANALYSIS_E_TRANSIENT
+    ANALYSIS_E_TRANSIENT,
+    ANALYSIS_PSS
 };
 
 /*! \class analysis
@@ -244,7 +245,7 @@ public:
      * Saves the given variable into the dataset associated with the
      * analysis.  Creates the dataset vector if necessary.
      */
-    void saveVariable (const std::string &, nr_complex_t, qucs::vector *);
+    virtual void saveVariable (const std::string &, nr_complex_t, qucs::vector *);
 
     /*! \fn getProgress
      * \brief get
@@ -1045,6 +1045,12 @@ struct application_t qucs::eqn::applications[] = {
 
   { "random",  TAG_DOUBLE, evaluate::rand,    0, { TAG_UNKNOWN } },
   { "srandom", TAG_DOUBLE, evaluate::srand_d, 1, { TAG_DOUBLE  } },
+  { "gauss",     TAG_DOUBLE, evaluate::gauss_d_d,     2,
+    { TAG_DOUBLE, TAG_DOUBLE } },
+  { "uniform",   TAG_DOUBLE, evaluate::uniform_d_d,   2,
+    { TAG_DOUBLE, TAG_DOUBLE } },
+  { "lognormal", TAG_DOUBLE, evaluate::lognormal_d_d, 2,
+    { TAG_DOUBLE, TAG_DOUBLE } },
 
   { "vector", TAG_VECTOR, evaluate::vector_x, -1, { TAG_UNKNOWN } },
   { "matrix", TAG_MATRIX, evaluate::matrix_x, -1, { TAG_UNKNOWN } },
@@ -51,6 +51,11 @@ struct definition_t * definition_root = NULL;
 struct definition_t * subcircuit_root = NULL;
 environment * env_root = NULL;
 
+/* A trusted netlist (e.g. loaded from the netlist cache) has passed
+   the checker before, thus the checker omits all validations which do
+   not modify the definitions. */
+int netlist_trusted = 0;
+
 /* The function counts the nodes in a definition line. */
 static int checker_count_nodes (struct definition_t * def)
 {
@@ -266,8 +271,9 @@ static int checker_resolve_variable (struct definition_t * root,
             value->var = TAG_DOUBLE;
             found++;
         }
-        /* 2. find analysis in parameter sweeps */
-        if ((val = checker_find_variable (root, "SW", "Sim", value->ident)))
+        /* 2. find analysis in parameter sweeps and Monte-Carlo analyses */
+        if ((val = checker_find_variable (root, "SW", "Sim", value->ident)) ||
+                (val = checker_find_variable (root, "MC", "Sim", value->ident)))
         {
             found++;
         }
@@ -573,6 +579,14 @@ static int checker_count_action (struct definition_t * root, char * instance)
     return count;
 }
 
+/* Returns non-zero if the given definition is an analysis running
+   another one, i.e. a parameter sweep or a Monte-Carlo analysis. */
+static int checker_is_sweep (struct definition_t * def)
+{
+    return def->action == 1 &&
+           (!strcmp (def->type, "SW") || !strcmp (def->type, "MC"));
+}
+
 /* This (recursive) function detects any kind of cyclic definitions of
    parameter sweeps for the given instance name.  The string list
    argument is used to pass the dependencies.  The function returns
@@ -596,7 +610,7 @@ static int checker_validate_para_cycles (struct definition_t * root,
             }
             deps->append (instance);
             /* recurse into parameter sweeps */
-            if (!strcmp (def->type, "SW"))
+            if (checker_is_sweep (def))
             {
                 if ((val = checker_find_reference (def, "Sim")) != NULL)
                 {
@@ -618,7 +632,7 @@ static int checker_validate_para (struct definition_t * root)
     for (struct definition_t * def = root; def != NULL; def = def->next)
     {
         /* find parameter sweep */
-        if (def->action == 1 && !strcmp (def->type, "SW"))
+        if (checker_is_sweep (def))
         {
             /* the 'Sim' property must be an identifier */
             if ((val = checker_validate_reference (def, "Sim")) == NULL)
@@ -847,6 +861,8 @@ static int checker_validate_lists (struct definition_t * root)
 static int checker_validate_actions (struct definition_t * root)
 {
     int a, c, n, errors = 0;
+    if (netlist_trusted)
+        return checker_validate_lists (root);
     if ((n = checker_count_definitions (root, NULL, 1)) < 1)
     {
         logprint (LOG_ERROR, "checker error, no actions defined: nothing to do\n");
@@ -1773,7 +1789,7 @@ static int checker_validate_properties (struct definition_t * root,
     int i, n, errors = 0;
 
     /* check whether the required properties are given */
-    for (i = 0; PROP_IS_PROP (available->required[i]); i++)
+    for (i = 0; !netlist_trusted && PROP_IS_PROP (available->required[i]); i++)
     {
         n = checker_find_property (available->required[i].key, def->pairs);
         if (n != 1)
@@ -1785,7 +1801,7 @@ static int checker_validate_properties (struct definition_t * root,
         }
     }
     /* check whether the optional properties are given zero/once */
-    for (i = 0; PROP_IS_PROP (available->optional[i]); i++)
+    for (i = 0; !netlist_trusted && PROP_IS_PROP (available->optional[i]); i++)
     {
         n = checker_find_property (available->optional[i].key, def->pairs);
         if (n >= 2)
@@ -1802,7 +1818,7 @@ static int checker_validate_properties (struct definition_t * root,
     {
         /* check whether properties are either required or optional */
         int type = checker_is_property (available, pair->key);
-        if (type == PROP_NONE)
+        if (type == PROP_NONE && !netlist_trusted)
         {
             if (strcmp (def->type, "Def"))
             {
@@ -1878,6 +1894,8 @@ static int checker_validate_subcircuits (struct definition_t * root)
                     struct define_t * available = netlist_create_define (sub);
                     errors += checker_validate_properties (root, def, available);
                     netlist_free_define (available);
+                    if (netlist_trusted)
+                        continue;
                     // and finally check for cyclic definitions
                     strlist * deps = new strlist ();
                     int err = checker_validate_sub_cycles (sub, sub->instance,
@@ -2080,6 +2098,8 @@ static int netlist_checker_intern (struct definition_t * root)
                 errors += checker_validate_properties (root, def, available);
             }
         }
+        if (netlist_trusted)
+            continue;
         /* check the number of definitions */
         n = checker_count_definition (root, def->type, def->instance);
         if (n != 1 && def->duplicate == 0)
@@ -2089,10 +2109,12 @@ static int netlist_checker_intern (struct definition_t * root)
             errors++;
         }
     }
-    /* check microstrip definitions */
-    errors += checker_validate_strips (root);
     /* check subcircuit definitions */
     errors += checker_validate_subcircuits (root);
+    if (netlist_trusted)
+        return errors;
+    /* check microstrip definitions */
+    errors += checker_validate_strips (root);
     /* check nodeset definitions */
     errors += checker_validate_nodesets (root);
     return errors;
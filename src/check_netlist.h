@@ -41,6 +41,9 @@ __BEGIN_DECLS
 /* Externalize variables used by the scanner and parser. */
 extern struct definition_t * definition_root;
 
+/* Non-zero if the definitions have been checked before. */
+extern int netlist_trusted;
+
 /* Available functions of the checker. */
 void netlist_status (void);
 void netlist_list (void);
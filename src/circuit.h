@@ -58,6 +58,7 @@
 #include <map>
 #include <string>
 
+#include "precision.h"
 #include "integrator.h"
 #include "valuelist.h"
 
@@ -73,6 +74,9 @@ enum circuit_flag {
   CIRCUIT_VARSIZE     = 64,
   CIRCUIT_PROBE       = 128,
   CIRCUIT_HISTORY     = 256,
+  CIRCUIT_EVENT       = 512,
+  CIRCUIT_SWITCH      = 1024,
+  CIRCUIT_CONVOLVED   = 2048,
 };
 
 class node;
@@ -142,6 +146,10 @@ class circuit : public object, public integrator
   virtual void calcCharacteristics (nr_double_t) { }
   virtual void saveCharacteristics (nr_double_t) { }
   virtual void saveCharacteristics (nr_complex_t) { }
+  /*! Returns the first time point after the given one where the
+      transient waveform of the circuit has a corner (a discontinuity
+      in value or slope), or NR_MAX if there is none. */
+  virtual nr_double_t nextBreakpoint (nr_double_t) { return NR_MAX; }
 
   // basic circuit element functionality
   void   setNode (int, const std::string&, int intern = 0);
@@ -182,6 +190,12 @@ class circuit : public object, public integrator
   void   setVariableSized (bool v) { MODFLAG (v, CIRCUIT_VARSIZE); }
   bool   isProbe (void) { return RETFLAG (CIRCUIT_PROBE); }
   void   setProbe (bool p) { MODFLAG (p, CIRCUIT_PROBE); }
+  bool   isEventDriven (void) { return RETFLAG (CIRCUIT_EVENT); }
+  void   setEventDriven (bool e) { MODFLAG (e, CIRCUIT_EVENT); }
+  bool   isSwitch (void) { return RETFLAG (CIRCUIT_SWITCH); }
+  void   setSwitch (bool s) { MODFLAG (s, CIRCUIT_SWITCH); }
+  bool   isConvolved (void) { return RETFLAG (CIRCUIT_CONVOLVED); }
+  void   setConvolved (bool c) { MODFLAG (c, CIRCUIT_CONVOLVED); }
   void   setNet (net * n) { subnet = n; }
   net *  getNet (void) { return subnet; }
 
@@ -167,6 +167,23 @@ void coaxline::calcNoiseAC (nr_double_t) {
   setMatrixN (4 * celsius2kelvin (T) / T0 * real (getMatrixY ()));
 }
 
+/* The transient model covers the frequencies up to the cutoff of the
+   first higher order mode. */
+void coaxline::initTR (void) {
+  nr_double_t l = getPropertyDouble ("L");
+  initCheck ();
+  auto propagation = [this] (nr_double_t f, nr_complex_t & g,
+			     nr_complex_t & z) {
+    calcPropagation (f);
+    g = nr_complex_t (alpha, beta); z = zl;
+  };
+  if (l == 0.0 || trModel.initTR (this, l, propagation, fc)) initDC ();
+}
+
+void coaxline::calcTR (nr_double_t t) {
+  trModel.calcTR (this, t);
+}
+
 // properties
 PROP_REQ [] = {
   { "D", PROP_REAL, { 2.95e-3, PROP_NO_STR }, PROP_POS_RANGEX },
@@ -35,6 +35,8 @@ class coaxline : public qucs::circuit
   void initDC (void);
   void initAC (void);
   void calcAC (nr_double_t);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void calcNoiseAC (nr_double_t);
   void saveCharacteristics (nr_double_t);
 
@@ -42,6 +44,7 @@ class coaxline : public qucs::circuit
   void calcPropagation (nr_double_t);
   void initCheck (void);
   nr_double_t alpha, beta, zl, fc;
+  qucs::rconvline trModel;
 };
 
 #endif /* __COAXLINE_H__ */
@@ -41,6 +41,7 @@
 #include "node.h"
 #include "net.h"
 #include "circuit.h"
+#include "rconv.h"
 #include "component_id.h"
 #include "constants.h"
 #include "netdefs.h"
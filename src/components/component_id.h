@@ -38,6 +38,7 @@ enum circuit_type {
   CIR_TEE,
   CIR_CROSS,
   CIR_ITRAFO,
+  CIR_ROM,
 
   // linear components
   CIR_RESISTOR,
@@ -32,6 +32,7 @@
 #include "object.h"
 #include "node.h"
 #include "circuit.h"
+#include "rconv.h"
 #include "component_id.h"
 #include "ground.h"
 #include "open.h"
@@ -39,6 +40,7 @@
 #include "tee.h"
 #include "cross.h"
 #include "itrafo.h"
+#include "rom.h"
 
 #include "resistor.h"
 #include "capacitor.h"
@@ -80,6 +80,19 @@ void digisource::calcTR (nr_double_t t) {
   setE (VSRC_1, lo ? 0 : v);
 }
 
+// Returns the next level change after the given time.
+nr_double_t digisource::nextBreakpoint (nr_double_t t) {
+  qucs::vector * values = getPropertyVector ("times");
+  nr_double_t base = T * qucs::floor (t / T);
+  nr_double_t ti = base;
+
+  for (int i = 0; i < values->getSize (); i++) {
+    ti += real (values->get (i));
+    if (ti > t) return ti;
+  }
+  return base + T + real (values->get (0));
+}
+
 // properties
 PROP_REQ [] = {
   { "init", PROP_STR, { PROP_NO_VAL, "low" }, PROP_RNG_STR2 ("low", "high") },
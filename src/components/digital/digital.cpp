@@ -160,11 +160,16 @@ void digital::calcAC (nr_double_t frequency) {
   }
 }
 
-// Initialize transient analysis.
+/* Initialize transient analysis.  Event driven gates are plain
+   voltage sources whose values are set by the digital kernel. */
 void digital::initTR (void) {
   nr_double_t t = getPropertyDouble ("t");
   initDC ();
   deleteHistory ();
+  if (isEventDriven ()) {
+    setC (VSRC_1, NODE_OUT, 1);
+    return;
+  }
   if (t > 0.0) {
     delay = true;
     setHistory (true);
@@ -175,6 +180,7 @@ void digital::initTR (void) {
 
 // Computes MNA entries during transient analysis.
 void digital::calcTR (nr_double_t t) {
+  if (isEventDriven ()) return;
   if (delay) {
     Tdelay = t - getPropertyDouble ("t");
     calcOutput ();
@@ -124,6 +124,13 @@ void ifile::calcTR (nr_double_t t) {
   setI (NODE_1, +G * i); setI (NODE_2, -G * i);
 }
 
+// Returns the next data point of the file after the given time.
+nr_double_t ifile::nextBreakpoint (nr_double_t t) {
+  nr_double_t T = getPropertyDouble ("T");
+  nr_double_t bp = inter->nextBreakpoint (t - T);
+  return bp < NR_MAX ? bp + T : bp;
+}
+
 // properties
 PROP_REQ [] = {
   { "File", PROP_STR, { PROP_NO_VAL, "ifile.dat" }, PROP_NO_RANGE },
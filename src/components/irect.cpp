@@ -95,6 +95,25 @@ void irect::calcTR (nr_double_t t) {
   setI (NODE_1, +it * s); setI (NODE_2, -it * s);
 }
 
+// Returns the next corner of the periodic waveform after the given time.
+nr_double_t irect::nextBreakpoint (nr_double_t t) {
+  nr_double_t th = getPropertyDouble ("TH");
+  nr_double_t tl = getPropertyDouble ("TL");
+  nr_double_t tr = getPropertyDouble ("Tr");
+  nr_double_t tf = getPropertyDouble ("Tf");
+  nr_double_t td = getPropertyDouble ("Td");
+
+  if (tr > th) tr = th;
+  if (tf > tl) tf = tl;
+
+  if (t < td) return td;
+  nr_double_t base = td + (th + tl) * qucs::floor ((t - td) / (th + tl));
+  nr_double_t bp[5] = { 0, tr, th, th + tf, th + tl };
+  for (int i = 0; i < 5; i++)
+    if (base + bp[i] > t) return base + bp[i];
+  return base + th + tl + tr;
+}
+
 // properties
 PROP_REQ [] = {
   { "I", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_NO_RANGE },
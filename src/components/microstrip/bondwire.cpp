@@ -417,6 +417,14 @@ void bondwire::calcNoiseAC (nr_double_t) {
   setN (NODE_1, NODE_2, -f); setN (NODE_2, NODE_1, -f);
 }
 
+void bondwire::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void bondwire::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "D", PROP_REAL, { 25e-6, PROP_NO_STR }, PROP_POS_RANGE },
@@ -35,6 +35,8 @@ class bondwire : public qucs::circuit
   void calcSP (const nr_double_t);
   void calcNoiseSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void initAC (void);
   void calcAC (nr_double_t);
   void calcNoiseAC (nr_double_t);
@@ -55,6 +57,7 @@ class bondwire : public qucs::circuit
   int model;         /*!< model number */
   nr_double_t R, L;
   nr_double_t temp;  /*!< ambient temperature */
+  qucs::rconvnport trModel;
 };
 
 #endif /* __BONDWIRE_H__ */
@@ -143,6 +143,14 @@ void circularloop::calcNoiseAC (nr_double_t) {
   setMatrixN (4 * celsius2kelvin (T) / T0 * real (getMatrixY ()));
 }
 
+void circularloop::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void circularloop::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "Subst", PROP_STR, { PROP_NO_VAL, "Subst1" }, PROP_NO_RANGE },
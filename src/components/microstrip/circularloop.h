@@ -32,6 +32,8 @@ class circularloop : public qucs::circuit
   void calcSP (nr_double_t);
   void calcNoiseSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void initAC (void);
   void calcNoiseAC (nr_double_t);
   void initSP (void);
@@ -40,6 +42,7 @@ private:
   void calcABCDparams(nr_double_t);
   qucs::matrix ABCD;
   nr_double_t R;//Equivalent series resistance of the spiral inductor
+  qucs::rconvnport trModel;
 };
 
 #endif /* CIRCULARLOOP_H */
@@ -72,6 +72,14 @@ void cpwgap::calcAC (nr_double_t frequency) {
   setMatrixY (calcMatrixY (frequency));
 }
 
+void cpwgap::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void cpwgap::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
@@ -31,8 +31,13 @@ class cpwgap : public qucs::circuit
   CREATOR (cpwgap);
   void calcSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void calcAC (nr_double_t);
   qucs::matrix calcMatrixY (nr_double_t);
+
+ private:
+  qucs::rconvnport trModel;
 };
 
 #endif /* __CPWGAP_H__ */
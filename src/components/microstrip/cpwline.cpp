@@ -32,6 +32,7 @@
 #include "component.h"
 #include "substrate.h"
 #include "cpwline.h"
+#include "fspecial.h"
 
 using namespace qucs;
 
@@ -40,42 +41,15 @@ cpwline::cpwline () : circuit (2) {
   type = CIR_CPWLINE;
 }
 
-/*! K(k)
-
- The function computes the complete elliptic integral of first kind
-   K() and the second kind E() using the arithmetic-geometric mean
-   algorithm (AGM) by Abramowitz and Stegun.
-\todo move to common math
-*/
-/* The function computes the complete elliptic integral of first kind
-   K(k) using the arithmetic-geometric mean algorithm (AGM) found e.g.
-   in Abramowitz and Stegun (17.6.1). 
-   Note that the argument of the function here is the elliptic modulus k
-   and not the parameter m=k^2 . */
-/* \todo move to common math */
+/* The complete elliptic integral of first kind K(k) and the ratio
+   K(k)/K'(k) are provided by the special functions, the ratio is
+   cached there since it only depends on the geometry. */
 nr_double_t cpwline::ellipk (nr_double_t k) {
-  if ((k < 0.0) || (k >= 1.0))
-    // we use only the range from 0 <= k < 1
-    return std::numeric_limits<nr_double_t>::quiet_NaN();
-
-  nr_double_t a = 1.0;
-  nr_double_t b = qucs::sqrt(1-k*k);
-  nr_double_t c = k;
-
-  while (c > std::numeric_limits<nr_double_t>::epsilon()) {
-    nr_double_t tmp = (a + b) / 2.0;
-    c = (a - b) / 2.0;
-    b = qucs::sqrt(a * b);
-    a = tmp;
-  }
-  return (pi_over_2 / a);
+  return fspecial::ellipk (k);
 }
 
 nr_double_t cpwline::KoverKp(nr_double_t k) {
-  if ((k < 0.0) || (k >= 1.0))
-    return std::numeric_limits<nr_double_t>::quiet_NaN();
-
-  return (ellipk(k) / ellipk(qucs::sqrt(1-k*k)));
+  return fspecial::KoverKp (k);
 }
 
 /* Approximation of K(k)/K'(k).
@@ -142,7 +116,7 @@ void cpwline::initPropagation (void) {
     if (approx) {
       q3 = ellipa (k3);
     } else {
-      q3 = ellipk (k3) / ellipk (qucs::sqrt (1 - k3 * k3));
+      q3 = KoverKp (k3);
     }
     qz  = 1 / (q1 + q3);
     er0 = 1 + q3 * qz * (er - 1);
@@ -154,7 +128,7 @@ void cpwline::initPropagation (void) {
     if (approx) {
       q2 = ellipa (k2);
     } else {
-      q2 = ellipk (k2) / ellipk (qucs::sqrt (1 - k2 * k2));
+      q2 = KoverKp (k2);
     }
     er0 = 1 + (er - 1) / 2 * q2 / q1;
     zl_factor = Z0 / 4 / q1;
@@ -170,7 +144,7 @@ void cpwline::initPropagation (void) {
     if (approx) {
       qe = ellipa (ke);
     } else {
-      qe = ellipk (ke) / ellipk (qucs::sqrt (1 - ke * ke));
+      qe = KoverKp (ke);
     }
     // backside is metal
     if (backMetal) {
@@ -285,12 +259,12 @@ void cpwline::analyseQuasiStatic (nr_double_t W, nr_double_t s, nr_double_t h,
 
   // compute the necessary quasi-static approx. (K1, K3, er(0) and Z(0))
   k1 = W / (W + s + s);
-  q1 = ellipk (k1) / ellipk (qucs::sqrt (1 - k1 * k1));
+  q1 = KoverKp (k1);
 
   // backside is metal
   if (backMetal) {
     k3  = qucs::tanh ((pi / 4) * (W / h)) / qucs::tanh ((pi / 4) * (W + s + s) / h);
-    q3 = ellipk (k3) / ellipk (qucs::sqrt (1 - k3 * k3));
+    q3 = KoverKp (k3);
     qz  = 1 / (q1 + q3);
     ErEff = 1 + q3 * qz * (er - 1);
     ZlEff = Z0 / 2 * qz;
@@ -298,7 +272,7 @@ void cpwline::analyseQuasiStatic (nr_double_t W, nr_double_t s, nr_double_t h,
   // backside is air
   else {
     k2  = qucs::sinh ((pi / 4) * (W / h)) / qucs::sinh ((pi / 4) * (W + s + s) / h);
-    q2 = ellipk (k2) / ellipk (qucs::sqrt (1 - k2 * k2));
+    q2 = KoverKp (k2);
     ErEff = 1 + (er - 1) / 2 * q2 / q1;
     ZlEff = Z0 / 4 / q1;
   }
@@ -310,7 +284,7 @@ void cpwline::analyseQuasiStatic (nr_double_t W, nr_double_t s, nr_double_t h,
 
     // modifies k1 accordingly (k1 = ke)
     ke = k1 + (1 - k1 * k1) * d / 2 / s;
-    qe = ellipk (ke) / ellipk (qucs::sqrt (1 - ke * ke));
+    qe = KoverKp (ke);
 
     // backside is metal
     if (backMetal) {
@@ -379,7 +353,18 @@ void cpwline::initDC (void) {
 }
 
 void cpwline::initTR (void) {
-  initDC ();
+  initPropagation ();
+  auto propagation = [this] (nr_double_t f, nr_complex_t & g,
+			     nr_complex_t & z) {
+    nr_double_t zl = zl_factor, beta = bt_factor, alpha;
+    calcAB (f, zl, alpha, beta);
+    g = nr_complex_t (alpha, beta); z = zl;
+  };
+  if (len == 0.0 || trModel.initTR (this, len, propagation)) initDC ();
+}
+
+void cpwline::calcTR (nr_double_t t) {
+  trModel.calcTR (this, t);
 }
 
 void cpwline::initAC (void) {
@@ -35,6 +35,7 @@ class cpwline : public qucs::circuit
   void calcNoiseSP (nr_double_t);
   void initDC (void);
   void initTR (void);
+  void calcTR (nr_double_t);
   void initAC (void);
   void calcAC (nr_double_t);
   void calcNoiseAC (nr_double_t);
@@ -66,6 +67,7 @@ class cpwline : public qucs::circuit
   nr_double_t fte, G;
   nr_double_t len, tand, rho;
   nr_double_t Zl, Er;
+  qucs::rconvline trModel;
 };
 
 #endif /* __CPWLINE_H__ */
@@ -101,6 +101,14 @@ void cpwopen::calcAC (nr_double_t frequency) {
   setY (NODE_1, NODE_1, calcY (frequency));
 }
 
+void cpwopen::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void cpwopen::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
@@ -103,6 +103,14 @@ void cpwshort::calcAC (nr_double_t frequency) {
   setY (NODE_1, NODE_1, 1.0 / calcZ (frequency));
 }
 
+void cpwshort::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void cpwshort::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
@@ -32,12 +32,17 @@ class cpwshort : public qucs::circuit
   void initSP (void);
   void calcSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void initAC (void);
   void calcAC (nr_double_t);
 
   void checkProperties (void);
   nr_double_t calcLend (nr_double_t);
   nr_complex_t calcZ (nr_double_t);
+
+ private:
+  qucs::rconvnport trModel;
 };
 
 #endif /* __CPWSHORT_H__ */
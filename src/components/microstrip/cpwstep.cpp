@@ -142,6 +142,14 @@ void cpwstep::calcAC (nr_double_t frequency) {
   setD (VSRC_1, VSRC_2, z); setD (VSRC_2, VSRC_1, z);
 }
 
+void cpwstep::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void cpwstep::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W1", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
@@ -109,6 +109,14 @@ void mscorner::calcAC (nr_double_t frequency) {
   setMatrixY (ztoy (calcMatrixZ (frequency)));
 }
 
+void mscorner::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void mscorner::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
@@ -33,6 +33,8 @@ class mscorner : public qucs::circuit
   void calcSP (nr_double_t);
   void initSP (void);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void initAC (void);
   void calcAC (nr_double_t);
 
@@ -40,6 +42,7 @@ class mscorner : public qucs::circuit
   void initCheck (void);
   qucs::matrix calcMatrixZ (nr_double_t);
   nr_double_t L, C, h;
+  qucs::rconvnport trModel;
 };
 
 #endif /* __MSCORNER_H__ */
@@ -35,6 +35,7 @@ using namespace qucs;
 
 mscoupled::mscoupled () : circuit (4) {
   type = CIR_MSCOUPLED;
+  qsValid = false;
 }
 
 void mscoupled::calcPropagation (nr_double_t frequency) {
@@ -54,9 +55,16 @@ void mscoupled::calcPropagation (nr_double_t frequency) {
   nr_double_t rho   = subst->getPropertyDouble ("rho");
   nr_double_t D     = subst->getPropertyDouble ("D");
 
-  // quasi-static analysis
-  nr_double_t Zle, ErEffe, Zlo, ErEffo;
-  analysQuasiStatic (W, h, s, t, er, SModel, Zle, Zlo, ErEffe, ErEffo);
+  // quasi-static analysis, depends on the geometry only
+  if (!qsValid || W != qsW || h != qsh || s != qss || t != qst ||
+      er != qser || qsModel != SModel) {
+    analysQuasiStatic (W, h, s, t, er, SModel, qsZle, qsZlo, qsErEffe,
+		       qsErEffo);
+    qsW = W; qsh = h; qss = s; qst = t; qser = er;
+    qsModel = SModel;
+    qsValid = true;
+  }
+  nr_double_t Zle = qsZle, ErEffe = qsErEffe, Zlo = qsZlo, ErEffo = qsErEffo;
 
   // analyse dispersion of Zl and Er
   nr_double_t ZleFreq, ErEffeFreq, ZloFreq, ErEffoFreq;
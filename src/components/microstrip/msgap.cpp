@@ -116,6 +116,14 @@ void msgap::calcAC (nr_double_t frequency) {
   setMatrixY (calcMatrixY (frequency));
 }
 
+void msgap::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void msgap::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W1", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
@@ -32,8 +32,13 @@ class msgap : public qucs::circuit
   CREATOR (msgap);
   void calcSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void calcAC (nr_double_t);
   qucs::matrix calcMatrixY (nr_double_t);
+
+ private:
+  qucs::rconvnport trModel;
 };
 
 #endif /* __MSGAP_H__ */
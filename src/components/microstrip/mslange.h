@@ -50,6 +50,12 @@ class mslange : public qucs::circuit
 
  private:
   nr_double_t ae, be, ze, ao, bo, zo, ee, eo;
+
+  // cached quasi-static analysis and its arguments
+  bool qsValid;
+  nr_double_t qsW, qsh, qss, qst, qser;
+  std::string qsModel;
+  nr_double_t qsZle, qsZlo, qsErEffe, qsErEffo;
 };
 
 #endif /* __MSLANGE_H__ */
@@ -485,6 +485,20 @@ void msline::calcNoiseAC (nr_double_t) {
   setMatrixN (4 * celsius2kelvin (T) / T0 * real (getMatrixY ()));
 }
 
+void msline::initTR (void) {
+  nr_double_t l = getPropertyDouble ("L");
+  auto propagation = [this] (nr_double_t f, nr_complex_t & g,
+			     nr_complex_t & z) {
+    calcPropagation (f);
+    g = nr_complex_t (alpha, beta); z = zl;
+  };
+  if (l == 0.0 || trModel.initTR (this, l, propagation)) initDC ();
+}
+
+void msline::calcTR (nr_double_t t) {
+  trModel.calcTR (this, t);
+}
+
 // properties
 PROP_REQ [] = {
   { "W", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
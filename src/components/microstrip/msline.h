@@ -35,6 +35,8 @@ class msline : public qucs::circuit
   void calcPropagation (nr_double_t);
   void initAC (void);
   void calcAC (nr_double_t);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void calcNoiseAC (nr_double_t);
   void saveCharacteristics (nr_double_t);
 
@@ -64,6 +66,7 @@ class msline : public qucs::circuit
 
  private:
   nr_double_t alpha, beta, zl, ereff;
+  qucs::rconvline trModel;
 };
 
 #endif /* __MSLINE_H__ */
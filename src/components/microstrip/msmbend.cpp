@@ -103,6 +103,14 @@ void msmbend::calcAC (nr_double_t frequency) {
   setMatrixY (ztoy (calcMatrixZ (frequency)));
 }
 
+void msmbend::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void msmbend::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
@@ -32,9 +32,14 @@ class msmbend : public qucs::circuit
   CREATOR (msmbend);
   void calcSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void initAC (void);
   void calcAC (nr_double_t);
   qucs::matrix calcMatrixZ (nr_double_t);
+
+ private:
+  qucs::rconvnport trModel;
 };
 
 #endif /* __MSMBEND_H__ */
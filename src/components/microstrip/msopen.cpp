@@ -133,6 +133,14 @@ void msopen::calcAC (nr_double_t frequency) {
   setY (NODE_1, NODE_1, calcY (frequency));
 }
 
+void msopen::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void msopen::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "W", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
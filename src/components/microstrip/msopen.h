@@ -35,8 +35,13 @@ class msopen : public qucs::circuit
 			       const char * const);
   void calcSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void calcAC (nr_double_t);
   nr_complex_t calcY (nr_double_t);
+
+ private:
+  qucs::rconvnport trModel;
 };
 
 #endif /* __MSOPEN_H__ */
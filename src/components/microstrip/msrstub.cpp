@@ -89,6 +89,14 @@ void msrstub::calcAC (nr_double_t frequency) {
   setY (NODE_1, NODE_1, 1.0 / calcZ (frequency));
 }
 
+void msrstub::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void msrstub::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "ri", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_POS_RANGE },
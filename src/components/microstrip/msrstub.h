@@ -33,8 +33,13 @@ class msrstub : public qucs::circuit
 				    nr_double_t, nr_double_t, nr_double_t);
   void calcSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void calcAC (nr_double_t);
   nr_complex_t calcZ (nr_double_t);
+
+ private:
+  qucs::rconvnport trModel;
 };
 
 #endif /* __MSRSTUB_H__ */
@@ -113,7 +113,11 @@ void msstep::calcAC (nr_double_t frequency) {
 }
 
 void msstep::initTR (void) {
-  initDC ();
+  if (trModel.initTR (this)) initDC ();
+}
+
+void msstep::calcTR (nr_double_t) {
+  trModel.calcTR (this);
 }
 
 // properties
@@ -35,7 +35,11 @@ class msstep : public qucs::circuit
   void initAC (void);
   void calcAC (nr_double_t);
   void initTR (void);
+  void calcTR (nr_double_t);
   qucs::matrix calcMatrixZ (nr_double_t);
+
+ private:
+  qucs::rconvnport trModel;
 };
 
 #endif /* __MSSTEP_H__ */
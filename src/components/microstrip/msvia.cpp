@@ -136,6 +136,14 @@ void msvia::calcNoiseAC (nr_double_t) {
   setN (NODE_1, NODE_2, -f); setN (NODE_2, NODE_1, -f);
 }
 
+void msvia::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void msvia::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "D", PROP_REAL, { 100e-6, PROP_NO_STR }, PROP_POS_RANGE },
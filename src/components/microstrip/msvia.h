@@ -33,6 +33,8 @@ class msvia : public qucs::circuit
   void initSP (void);
   void calcNoiseSP (nr_double_t);
   void initDC (void);
+  void initTR (void);
+  void calcTR (nr_double_t);
   void initAC (void);
   void calcAC (nr_double_t);
   void calcNoiseAC (nr_double_t);
@@ -42,6 +44,7 @@ class msvia : public qucs::circuit
  private:
   nr_double_t R;
   nr_complex_t Z;
+  qucs::rconvnport trModel;
 };
 
 #endif /* __MSVIA_H__ */
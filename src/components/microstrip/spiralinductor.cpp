@@ -153,6 +153,14 @@ void spiralinductor::calcNoiseAC (nr_double_t) {
   setMatrixN (4 * celsius2kelvin (T) / T0 * real (getMatrixY ()));
 }
 
+void spiralinductor::initTR (void) {
+  if (trModel.initTR (this)) initDC ();
+}
+
+void spiralinductor::calcTR (nr_double_t) {
+  trModel.calcTR (this);
+}
+
 // properties
 PROP_REQ [] = {
   { "Subst", PROP_STR, { PROP_NO_VAL, "Subst1" }, PROP_NO_RANGE },
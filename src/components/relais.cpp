@@ -34,6 +34,7 @@ using namespace qucs;
 relais::relais () : circuit (4) {
   type = CIR_RELAIS;
   setVoltageSources (1);
+  setSwitch (true);
 }
 
 void relais::initSP (void) {
@@ -124,7 +124,17 @@ void rlcg::calcAC (nr_double_t frequency) {
 }
 
 void rlcg::initTR (void) {
-  initDC ();
+  nr_double_t l = getPropertyDouble ("Length");
+  auto propagation = [this] (nr_double_t f, nr_complex_t & gl,
+			     nr_complex_t & zl) {
+    calcPropagation (f);
+    gl = g; zl = z;
+  };
+  if (l == 0.0 || trModel.initTR (this, l, propagation)) initDC ();
+}
+
+void rlcg::calcTR (nr_double_t t) {
+  trModel.calcTR (this, t);
 }
 
 // properties
@@ -34,6 +34,7 @@ class rlcg : public qucs::circuit
   void initAC (void);
   void calcAC (nr_double_t);
   void initTR (void);
+  void calcTR (nr_double_t);
   void calcNoiseAC (nr_double_t);
   void calcNoiseSP (nr_double_t);
   void saveCharacteristics (nr_double_t);
@@ -42,6 +43,7 @@ class rlcg : public qucs::circuit
   void calcPropagation (nr_double_t);
   nr_complex_t g;
   nr_complex_t z;
+  qucs::rconvline trModel;
 };
 
 #endif /* __RLCG_H__ */
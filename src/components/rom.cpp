@@ -0,0 +1,116 @@
+/*
+ * rom.cpp - reduced order model class implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include "component.h"
+#include "rom.h"
+
+using namespace qucs;
+
+rom::rom (int nodes) : circuit (nodes) {
+  type = CIR_ROM;
+}
+
+// Sets the conductance and capacitance matrices (row major).
+void rom::setModel (const std::vector<nr_double_t> &g,
+		    const std::vector<nr_double_t> &c) {
+  G = g;
+  C = c;
+}
+
+void rom::initSP (void) {
+  allocMatrixS ();
+}
+
+void rom::calcSP (nr_double_t frequency) {
+  int n = getSize ();
+  nr_double_t o = 2 * pi * frequency;
+  matrix y (n);
+  for (int r = 0; r < n; r++)
+    for (int c = 0; c < n; c++)
+      y.set (r, c, nr_complex_t (G[r * n + c], o * C[r * n + c]));
+  setMatrixS (ytos (y, nr_complex_t (z0)));
+}
+
+void rom::initDC (void) {
+  int n = getSize ();
+  allocMatrixMNA ();
+  for (int r = 0; r < n; r++)
+    for (int c = 0; c < n; c++)
+      setY (r, c, G[r * n + c]);
+}
+
+void rom::initAC (void) {
+  allocMatrixMNA ();
+}
+
+void rom::calcAC (nr_double_t frequency) {
+  int n = getSize ();
+  nr_double_t o = 2 * pi * frequency;
+  for (int r = 0; r < n; r++)
+    for (int c = 0; c < n; c++)
+      setY (r, c, nr_complex_t (G[r * n + c], o * C[r * n + c]));
+}
+
+void rom::initTR (void) {
+  setStates (2 * getSize ());
+  initDC ();
+}
+
+/* Each node gets the charge of its row of the capacitance matrix,
+   the linearization of the charge with respect to each node voltage
+   goes into the Jacobian. */
+void rom::calcTR (nr_double_t) {
+  int n = getSize ();
+  std::vector<nr_double_t> v (n);
+  for (int r = 0; r < n; r++) v[r] = real (getV (r));
+
+  for (int r = 0; r < n; r++) {
+    for (int c = 0; c < n; c++) setY (r, c, G[r * n + c]);
+    setI (r, 0);
+  }
+  for (int r = 0; r < n; r++) {
+    nr_double_t q = 0;
+    bool dynamic = false;
+    for (int c = 0; c < n; c++) {
+      q += C[r * n + c] * v[c];
+      if (C[r * n + c] != 0) dynamic = true;
+    }
+    if (!dynamic) continue;
+    transientCapacitanceQ (2 * r, r, q);
+    for (int c = 0; c < n; c++) {
+      if (C[r * n + c] != 0)
+	transientCapacitanceC (r, c, C[r * n + c], v[c]);
+    }
+  }
+}
+
+void rom::initHB (void) {
+  initAC ();
+}
+
+void rom::calcHB (nr_double_t frequency) {
+  calcAC (frequency);
+}
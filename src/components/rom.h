@@ -0,0 +1,54 @@
+/*
+ * rom.h - reduced order model class definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __ROM_H__
+#define __ROM_H__
+
+#include <vector>
+
+/* The reduced order model of a linear subnetwork.  Its first nodes
+   are the ports of the subnetwork, the remaining internal nodes carry
+   the reduced state variables.  It stamps Y = G + sC with dense real
+   matrices G and C, thus the charges in transient analysis are
+   C times the node voltages. */
+class rom : public qucs::circuit
+{
+ public:
+  rom (int);
+  void setModel (const std::vector<nr_double_t> &,
+		 const std::vector<nr_double_t> &);
+  void initSP (void);
+  void calcSP (nr_double_t);
+  void initDC (void);
+  void initAC (void);
+  void calcAC (nr_double_t);
+  void initTR (void);
+  void calcTR (nr_double_t);
+  void initHB (void);
+  void calcHB (nr_double_t);
+
+ private:
+  std::vector<nr_double_t> G;
+  std::vector<nr_double_t> C;
+};
+
+#endif /* __ROM_H__ */
@@ -45,6 +45,7 @@ using namespace qucs;
 tswitch::tswitch () : circuit (2) {
   type = CIR_TSWITCH;
   setVoltageSources (1);
+  setSwitch (true);
 }
 
 nr_double_t tswitch::initState (void) {
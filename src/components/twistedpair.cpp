@@ -191,8 +191,22 @@ void twistedpair::calcNoiseAC (nr_double_t) {
   setMatrixN (4 * celsius2kelvin (T) / T0 * real (getMatrixY ()));
 }
 
+/* The transient model is differential like the AC model, the ports
+   are between the ends of the two wires. */
 void twistedpair::initTR (void) {
-  initDC ();
+  calcLength ();
+  auto propagation = [this] (nr_double_t f, nr_complex_t & g,
+			     nr_complex_t & z) {
+    calcPropagation (f);
+    g = nr_complex_t (alpha, beta); z = zl;
+  };
+  if (len == 0.0 ||
+      trModel.initTR (this, len, propagation, 100e9, NODE_4, NODE_3))
+    initDC ();
+}
+
+void twistedpair::calcTR (nr_double_t t) {
+  trModel.calcTR (this, t);
 }
 
 // properties
@@ -37,6 +37,7 @@ class twistedpair : public qucs::circuit
   void calcAC (nr_double_t);
   void calcNoiseAC (nr_double_t);
   void initTR (void);
+  void calcTR (nr_double_t);
   void saveCharacteristics (nr_double_t);
 
  private:
@@ -46,6 +47,7 @@ class twistedpair : public qucs::circuit
 
  private:
   nr_double_t zl, ereff, alpha, beta, len, angle;
+  qucs::rconvline trModel;
 };
 
 #endif /* __TWISTEDPAIR_H__ */
@@ -129,6 +129,13 @@ void vfile::calcTR (nr_double_t t) {
   setE (VSRC_1, G * u);
 }
 
+// Returns the next data point of the file after the given time.
+nr_double_t vfile::nextBreakpoint (nr_double_t t) {
+  nr_double_t T = getPropertyDouble ("T");
+  nr_double_t bp = inter->nextBreakpoint (t - T);
+  return bp < NR_MAX ? bp + T : bp;
+}
+
 // properties
 PROP_REQ [] = {
   { "File", PROP_STR, { PROP_NO_VAL, "vfile.dat" }, PROP_NO_RANGE },
@@ -88,6 +88,20 @@ void vpulse::calcTR (nr_double_t t) {
   setE (VSRC_1, ut * s);
 }
 
+// Returns the next corner of the pulse after the given time.
+nr_double_t vpulse::nextBreakpoint (nr_double_t t) {
+  nr_double_t t1 = getPropertyDouble ("T1");
+  nr_double_t t2 = getPropertyDouble ("T2");
+  nr_double_t tr = getPropertyDouble ("Tr");
+  nr_double_t tf = getPropertyDouble ("Tf");
+  nr_double_t bp[4] = { t1, t1 + tr, t2 - tf, t2 };
+  nr_double_t next = NR_MAX;
+
+  for (int i = 0; i < 4; i++)
+    if (bp[i] > t && bp[i] < next) next = bp[i];
+  return next;
+}
+
 // properties
 PROP_REQ [] = {
   { "U1", PROP_REAL, { 0, PROP_NO_STR }, PROP_NO_RANGE },
@@ -341,6 +341,16 @@ void dataset::print (void) {
     }
   }
 
+  print (f);
+
+  // close file if necessary
+  if (file) fclose (f);
+}
+
+/* Prints the current dataset representation into the given file
+   descriptor. */
+void dataset::print (FILE * f) {
+
   // print header
   fprintf (f, "<Qucs Dataset " PACKAGE_VERSION ">\n");
 
@@ -356,9 +366,6 @@ void dataset::print (void) {
     else
       printDependency (v, f);
   }
-
-  // close file if necessary
-  if (file) fclose (f);
 }
 
 /* Prints the given vector as independent dataset vector into the
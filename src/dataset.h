@@ -54,6 +54,7 @@ class dataset : public object
   char * getFile (void);
   void setFile (const char *);
   void print (void);
+  void print (FILE *);
   void printData (qucs::vector *, FILE *);
   void printDependency (qucs::vector *, FILE *);
   void printVariable (qucs::vector *, FILE *);
@@ -36,6 +36,7 @@
 #include "analysis.h"
 #include "nasolver.h"
 #include "dcsolver.h"
+#include "profile.h"
 
 namespace qucs {
 
@@ -70,11 +71,13 @@ int dcsolver::solve (void) {
   saveOPs |= !strcmp (getPropertyString ("saveOPs"), "yes") ? SAVE_OPS : 0;
   saveOPs |= !strcmp (getPropertyString ("saveAll"), "yes") ? SAVE_ALL : 0;
   const char * const solver = getPropertyString ("Solver");
+  chord = !strcmp (getPropertyString ("Newton"), "chord");
 
   // initialize node voltages, first guess for non-linear circuits and
   // generate extra circuits if necessary
   init ();
   setCalculation ((calculate_func_t) &calc);
+  setStamping ((stamp_func_t) &stamp);
 
   // start the iterative solver
   solve_pre ();
@@ -165,6 +168,10 @@ int dcsolver::solve (void) {
   saveOperatingPoints ();
   saveResults ("V", "I", saveOPs);
 
+  // compute the sensitivities of the requested output
+  if (!error && isPropertyGiven ("SensOutput"))
+    solve_sensitivity (getPropertyString ("SensOutput"), "V", "I");
+
   solve_post ();
   return 0;
 }
@@ -174,10 +181,18 @@ int dcsolver::solve (void) {
 void dcsolver::calc (dcsolver * self) {
   circuit * root = self->getNet()->getRoot ();
   for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ()) {
+    profile_device pd (c);
     c->calcDC ();
   }
 }
 
+/* Stamps the given circuit alone, used to obtain the derivatives of
+   its MNA entries with respect to its properties. */
+void dcsolver::stamp (dcsolver *, circuit * c) {
+  c->initDC ();
+  c->calcDC ();
+}
+
 /* Goes through the list of circuit objects and runs its initDC()
    function. */
 void dcsolver::init (void) {
@@ -220,6 +235,10 @@ PROP_OPT [] = {
     PROP_RNG_STR6 ("none", "SourceStepping", "gMinStepping",
 		   "LineSearch", "Attenuation", "SteepestDescent") },
   { "Solver", PROP_STR, { PROP_NO_VAL, "CroutLU" }, PROP_RNG_SOL },
+  { "Ordering", PROP_STR, { PROP_NO_VAL, "none" }, PROP_RNG_ORD },
+  { "SensOutput", PROP_STR, { PROP_NO_VAL, "" }, PROP_NO_RANGE },
+  { "Newton", PROP_STR, { PROP_NO_VAL, "full" },
+    PROP_RNG_STR2 ("full", "chord") },
   PROP_NO_PROP };
 struct define_t dcsolver::anadef =
   { "DC", 0, PROP_ACTION, PROP_NO_SUBSTRATE, PROP_LINEAR, PROP_DEF };
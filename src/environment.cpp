@@ -37,6 +37,7 @@
 #include "equation.h"
 #include "logging.h"
 #include "environment.h"
+#include "sampler.h"
 
 using namespace qucs::eqn;
 
@@ -210,8 +211,16 @@ void environment::equationSolver (void) {
 
 /* The function solves the equations of the current environment object
    as well as these of its children, updates the variables and passes
-   the arguments to each children. */
+   the arguments to each children.  The random circuit parameters are
+   rewound first, they are the same in each run within a Monte-Carlo
+   sample. */
 int environment::runSolver (void) {
+  sampler::restart ();
+  return runSolvers ();
+}
+
+// Recursively solves the equations of the environment and its children.
+int environment::runSolvers (void) {
   int ret = 0;
 
   // solve equations in current environment
@@ -225,7 +234,7 @@ int environment::runSolver (void) {
     // pass references
     (*it)->updateReferences (this);
     // actually run the solver
-    ret |= (*it)->runSolver ();
+    ret |= (*it)->runSolvers ();
 #if 0
     // save local results
     (*it)->saveResults ();
@@ -115,6 +115,9 @@ class environment
     return this->name;
   }
 
+ private:
+  int runSolvers (void);
+
  private:
   std::string name;
   variable * root;
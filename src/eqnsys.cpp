@@ -44,6 +44,7 @@
 #include "eqnsys.h"
 #include "exception.h"
 #include "exceptionstack.h"
+#include "profile.h"
 
 //! Little helper macro.
 #define Swap(type,a,b) { type t; t = a; a = b; b = t; }
@@ -58,7 +59,7 @@ eqnsys<nr_type_t>::eqnsys () {
   S = E = NULL;
   T = R = NULL;
   nPvt = NULL;
-  cMap = rMap = NULL;
+  cMap = rMap = rEnv = NULL;
   update = 1;
   pivoting = PIVOT_PARTIAL;
   N = 0;
@@ -75,6 +76,7 @@ eqnsys<nr_type_t>::~eqnsys () {
   delete V;
   delete[] rMap;
   delete[] cMap;
+  delete[] rEnv;
   delete[] nPvt;
 }
 
@@ -87,7 +89,7 @@ eqnsys<nr_type_t>::eqnsys (eqnsys & e) {
   S = E = NULL;
   T = R = NULL;
   B = e.B ? new tvector<nr_type_t> (*(e.B)) : NULL;
-  cMap = rMap = NULL;
+  cMap = rMap = rEnv = NULL;
   nPvt = NULL;
   update = 1;
   X = e.X;
@@ -110,6 +112,7 @@ void eqnsys<nr_type_t>::passEquationSys (tmatrix<nr_type_t> * nA,
       N = A->getCols ();
       delete[] cMap; cMap = new int[N];
       delete[] rMap; rMap = new int[N];
+      delete[] rEnv; rEnv = new int[N];
       delete[] nPvt; nPvt = new nr_double_t[N];
     }
   }
@@ -126,6 +129,11 @@ void eqnsys<nr_type_t>::passEquationSys (tmatrix<nr_type_t> * nA,
    pointed to by the X matrix reference. */
 template <class nr_type_t>
 void eqnsys<nr_type_t>::solve (void) {
+  profile_timer t (algo == ALGO_LU_SUBSTITUTION_CROUT ||
+		   algo == ALGO_LU_SUBSTITUTION_DOOLITTLE ||
+		   algo == ALGO_LU_SUBSTITUTION_CROUT_T ||
+		   algo == ALGO_LU_SUBSTITUTION_DOOLITTLE_T ?
+		   PROFILE_SUBSTITUTION : PROFILE_FACTORIZATION);
 #if DEBUG && 0
   time_t t = time (NULL);
 #endif
@@ -157,6 +165,12 @@ void eqnsys<nr_type_t>::solve (void) {
   case ALGO_LU_SUBSTITUTION_DOOLITTLE:
     substitute_lu_doolittle ();
     break;
+  case ALGO_LU_SUBSTITUTION_CROUT_T:
+    substitute_lu_crout_t ();
+    break;
+  case ALGO_LU_SUBSTITUTION_DOOLITTLE_T:
+    substitute_lu_doolittle_t ();
+    break;
   case ALGO_JACOBI: case ALGO_GAUSS_SEIDEL:
     solve_iterative ();
     break;
@@ -318,18 +332,22 @@ void eqnsys<nr_type_t>::solve_lu_doolittle (void) {
 /*! This function decomposes the left hand matrix into an upper U and
    lower L matrix.  The algorithm is called LU decomposition (Crout's
    definition).  The function performs the actual LU decomposition of
-   the matrix A using (implicit) partial row pivoting. */
+   the matrix A using (implicit) partial row pivoting.  Leading zeros
+   of each row (its envelope) are skipped; these stay zero in L, so
+   a well ordered, banded matrix is decomposed much faster. */
 template <class nr_type_t>
 void eqnsys<nr_type_t>::factorize_lu_crout (void) {
   nr_double_t d, MaxPivot;
   nr_type_t f;
   int k, c, r, pivot;
 
-  // initialize pivot exchange table
+  // initialize pivot exchange table and row envelopes
   for (r = 0; r < N; r++) {
-    for (MaxPivot = 0, c = 0; c < N; c++)
+    for (rEnv[r] = N, MaxPivot = 0, c = 0; c < N; c++) {
       if ((d = abs (A_(r, c))) > MaxPivot)
 	MaxPivot = d;
+      if (d > 0 && rEnv[r] == N) rEnv[r] = c;
+    }
     if (MaxPivot <= 0) MaxPivot = NR_TINY;
     nPvt[r] = 1 / MaxPivot;
     rMap[r] = r;
@@ -340,13 +358,13 @@ void eqnsys<nr_type_t>::factorize_lu_crout (void) {
     // upper matrix entries
     for (r = 0; r < c; r++) {
       f = A_(r, c);
-      for (k = 0; k < r; k++) f -= A_(r, k) * A_(k, c);
+      for (k = rEnv[r]; k < r; k++) f -= A_(r, k) * A_(k, c);
       A_(r, c) = f / A_(r, r);
     }
     // lower matrix entries
     for (MaxPivot = 0, pivot = r; r < N; r++) {
       f = A_(r, c);
-      for (k = 0; k < c; k++) f -= A_(r, k) * A_(k, c);
+      for (k = rEnv[r]; k < c; k++) f -= A_(r, k) * A_(k, c);
       A_(r, c) = f;
       // larger pivot ?
       if ((d = nPvt[r] * abs (f)) > MaxPivot) {
@@ -373,8 +391,10 @@ void eqnsys<nr_type_t>::factorize_lu_crout (void) {
     if (c != pivot) {
       A->exchangeRows (c, pivot);
       Swap (int, rMap[c], rMap[pivot]);
+      Swap (int, rEnv[c], rEnv[pivot]);
       Swap (nr_double_t, nPvt[c], nPvt[pivot]);
     }
+    if (rEnv[c] > c) rEnv[c] = c;
   }
 #if LU_FAILURE
  fail:
@@ -384,18 +404,21 @@ void eqnsys<nr_type_t>::factorize_lu_crout (void) {
 /*! This function decomposes the left hand matrix into an upper U and
    lower L matrix.  The algorithm is called LU decomposition
    (Doolittle's definition).  The function performs the actual LU
-   decomposition of the matrix A using (implicit) partial row pivoting. */
+   decomposition of the matrix A using (implicit) partial row pivoting.
+   As in Crout's decomposition the row envelopes are skipped. */
 template <class nr_type_t>
 void eqnsys<nr_type_t>::factorize_lu_doolittle (void) {
   nr_double_t d, MaxPivot;
   nr_type_t f;
   int k, c, r, pivot;
 
-  // initialize pivot exchange table
+  // initialize pivot exchange table and row envelopes
   for (r = 0; r < N; r++) {
-    for (MaxPivot = 0, c = 0; c < N; c++)
+    for (rEnv[r] = N, MaxPivot = 0, c = 0; c < N; c++) {
       if ((d = abs (A_(r, c))) > MaxPivot)
 	MaxPivot = d;
+      if (d > 0 && rEnv[r] == N) rEnv[r] = c;
+    }
     if (MaxPivot <= 0) MaxPivot = NR_TINY;
     nPvt[r] = 1 / MaxPivot;
     rMap[r] = r;
@@ -406,13 +429,13 @@ void eqnsys<nr_type_t>::factorize_lu_doolittle (void) {
     // upper matrix entries
     for (r = 0; r < c; r++) {
       f = A_(r, c);
-      for (k = 0; k < r; k++) f -= A_(r, k) * A_(k, c);
+      for (k = rEnv[r]; k < r; k++) f -= A_(r, k) * A_(k, c);
       A_(r, c) = f;
     }
     // lower matrix entries
     for (MaxPivot = 0, pivot = r; r < N; r++) {
       f = A_(r, c);
-      for (k = 0; k < c; k++) f -= A_(r, k) * A_(k, c);
+      for (k = rEnv[r]; k < c; k++) f -= A_(r, k) * A_(k, c);
       A_(r, c) = f;
       // larger pivot ?
       if ((d = nPvt[r] * abs (f)) > MaxPivot) {
@@ -439,8 +462,10 @@ void eqnsys<nr_type_t>::factorize_lu_doolittle (void) {
     if (c != pivot) {
       A->exchangeRows (c, pivot);
       Swap (int, rMap[c], rMap[pivot]);
+      Swap (int, rEnv[c], rEnv[pivot]);
       Swap (nr_double_t, nPvt[c], nPvt[pivot]);
     }
+    if (rEnv[c] > c) rEnv[c] = c;
 
     // finally divide by the pivot element
     if (c < N - 1) {
@@ -502,6 +527,61 @@ void eqnsys<nr_type_t>::substitute_lu_doolittle (void) {
   }
 }
 
+/*! The function solves the transposed equation system A^T X = B
+   using the LU decomposition of A (Crout's definition).  With PA = LU
+   the system reads U^T L^T P X = B, thus a forward substitution with
+   U^T is followed by a backward substitution with L^T and the inverse
+   row permutation.  No additional decomposition is necessary. */
+template <class nr_type_t>
+void eqnsys<nr_type_t>::substitute_lu_crout_t (void) {
+  nr_type_t f;
+  int i, c;
+
+  // forward substitution in order to solve U^T Y = B
+  for (i = 0; i < N; i++) {
+    f = B_(i);
+    for (c = 0; c < i; c++) f -= A_(c, i) * X_(c);
+    X_(i) = f;
+  }
+
+  // backward substitution in order to solve L^T Z = Y
+  for (i = N - 1; i >= 0; i--) {
+    f = X_(i);
+    for (c = i + 1; c < N; c++) f -= A_(c, i) * X_(c);
+    X_(i) = f / A_(i, i);
+  }
+
+  // undo the row exchanges, i.e. X = P^T Z
+  for (i = 0; i < N; i++) B_(i) = X_(i);
+  for (i = 0; i < N; i++) X_(rMap[i]) = B_(i);
+}
+
+/*! The function solves the transposed equation system A^T X = B
+   using the LU decomposition of A (Doolittle's definition). */
+template <class nr_type_t>
+void eqnsys<nr_type_t>::substitute_lu_doolittle_t (void) {
+  nr_type_t f;
+  int i, c;
+
+  // forward substitution in order to solve U^T Y = B
+  for (i = 0; i < N; i++) {
+    f = B_(i);
+    for (c = 0; c < i; c++) f -= A_(c, i) * X_(c);
+    X_(i) = f / A_(i, i);
+  }
+
+  // backward substitution in order to solve L^T Z = Y
+  for (i = N - 1; i >= 0; i--) {
+    f = X_(i);
+    for (c = i + 1; c < N; c++) f -= A_(c, i) * X_(c);
+    X_(i) = f;
+  }
+
+  // undo the row exchanges, i.e. X = P^T Z
+  for (i = 0; i < N; i++) B_(i) = X_(i);
+  for (i = 0; i < N; i++) X_(rMap[i]) = B_(i);
+}
+
 /*! The function solves the equation system using a full-step iterative
    method (called Jacobi's method) or a single-step method (called
    Gauss-Seidel) depending on the given algorithm.  If the current X
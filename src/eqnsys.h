@@ -47,6 +47,9 @@ enum algo_type {
   ALGO_SV_DECOMPOSITION           = 0x1000,
   // testing
   ALGO_QR_DECOMPOSITION_2         = 0x2000,
+  // solving the transposed system with a given LU decomposition
+  ALGO_LU_SUBSTITUTION_CROUT_T     = 0x4000,
+  ALGO_LU_SUBSTITUTION_DOOLITTLE_T = 0x8000,
 };
 
 //! Definition of pivoting strategies.
@@ -80,6 +83,7 @@ class eqnsys
   int pivoting;
   int * rMap;
   int * cMap;
+  int * rEnv;
   int N;
   nr_double_t * nPvt;
 
@@ -101,6 +105,8 @@ class eqnsys
   void factorize_lu_doolittle (void);
   void substitute_lu_crout (void);
   void substitute_lu_doolittle (void);
+  void substitute_lu_crout_t (void);
+  void substitute_lu_doolittle_t (void);
   void solve_qr (void);
   void solve_qr_ls (void);
   void solve_qrh (void);
@@ -51,6 +51,7 @@
 #include "exception.h"
 #include "exceptionstack.h"
 #include "strlist.h"
+#include "sampler.h"
 
 using namespace qucs;
 using namespace qucs::eqn;
@@ -4686,6 +4687,29 @@ constant * evaluate::srand_d (constant * args) {
   }
 }
 
+/* Statistical circuit parameters, given by nominal value and spread.
+   They are nominal unless a Monte-Carlo analysis is running. */
+constant * evaluate::gauss_d_d (constant * args) {
+  _ARD0 (d0);
+  _ARD1 (d1);
+  _DEFD ();
+  _RETD (sampler::draw (sampler::GAUSS, d0, d1));
+}
+
+constant * evaluate::uniform_d_d (constant * args) {
+  _ARD0 (d0);
+  _ARD1 (d1);
+  _DEFD ();
+  _RETD (sampler::draw (sampler::UNIFORM, d0, d1));
+}
+
+constant * evaluate::lognormal_d_d (constant * args) {
+  _ARD0 (d0);
+  _ARD1 (d1);
+  _DEFD ();
+  _RETD (sampler::draw (sampler::LOGNORMAL, d0, d1));
+}
+
 
 // ******************* assert test *************************
 constant * evaluate::assert_b(constant *args)
@@ -785,6 +785,9 @@ public:
 
   static constant * rand (constant *);
   static constant * srand_d (constant *);
+  static constant * gauss_d_d (constant *);
+  static constant * uniform_d_d (constant *);
+  static constant * lognormal_d_d (constant *);
 
   static constant * vector_x (constant *);
   static constant * matrix_x (constant *);
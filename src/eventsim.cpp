@@ -0,0 +1,358 @@
+/*
+ * eventsim.cpp - event-driven digital simulation kernel implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <cmath>
+#include <algorithm>
+
+#include "object.h"
+#include "complex.h"
+#include "node.h"
+#include "circuit.h"
+#include "component_id.h"
+#include "logging.h"
+#include "eventsim.h"
+
+// Number of slots of the timing wheel.
+#define WHEEL_SIZE 256
+
+namespace qucs {
+
+// Constructor creates an empty kernel.
+eventsim::eventsim () {
+  wheel.resize (WHEEL_SIZE);
+  resolution = 1e-9;
+  base = 0;
+  now = 0;
+  pending = 0;
+  events = 0;
+}
+
+// Destructor deletes the kernel.
+eventsim::~eventsim () {
+}
+
+/* Returns the digital net connected to the given port of the given
+   circuit, creates it if necessary. */
+int eventsim::findNet (circuit * c, int port) {
+  std::string name = c->getNode (port)->getName ();
+  auto it = netIndex.find (name);
+  if (it != netIndex.end ()) return it->second;
+
+  net_t n;
+  n.value = LOGIC_X;
+  n.driver = -1;
+  n.probe = c;
+  n.port = port;
+  n.threshold = c->getPropertyDouble ("V") / 2;
+  nets.push_back (n);
+  int idx = (int) nets.size () - 1;
+  netIndex[name] = idx;
+  return idx;
+}
+
+/* The function adds the given circuit to the kernel if it is a
+   digital gate and marks it as event driven.  Returns true in this
+   case. */
+bool eventsim::addCircuit (circuit * c) {
+  switch (c->getType ()) {
+  case CIR_AND: case CIR_NAND: case CIR_OR: case CIR_NOR:
+  case CIR_XOR: case CIR_XNOR: case CIR_INVERTER: case CIR_BUFFER:
+    break;
+  default:
+    return false;
+  }
+
+  gate_t g;
+  int idx = (int) gates.size ();
+  g.cir = c;
+  g.type = c->getType ();
+  g.delay = c->getPropertyDouble ("t");
+  g.level = c->getPropertyDouble ("V");
+  g.scheduled = LOGIC_X;
+  g.output = findNet (c, 0);
+  for (int i = 1; i < c->getSize (); i++) {
+    int n = findNet (c, i);
+    g.inputs.push_back (n);
+    nets[n].fanout.push_back (idx);
+  }
+  if (nets[g.output].driver >= 0) {
+    logprint (LOG_ERROR, "WARNING: digital net `%s' driven by `%s' and `%s'\n",
+	      c->getNode (0)->getName (),
+	      gates[nets[g.output].driver].cir->getName (), c->getName ());
+  }
+  else {
+    nets[g.output].driver = idx;
+  }
+  gates.push_back (g);
+  c->setEventDriven (true);
+  return true;
+}
+
+/* Returns the output value of the given gate according to the current
+   values of its input nets. */
+int eventsim::evaluate (gate_t & g) {
+  int zeros = 0, ones = 0, unknown = 0;
+  for (int n : g.inputs) {
+    switch (nets[n].value) {
+    case LOGIC_0: zeros++; break;
+    case LOGIC_1: ones++; break;
+    default: unknown++; break;
+    }
+  }
+
+  int v, invert = 0;
+  switch (g.type) {
+  case CIR_NAND:
+    invert = 1; // fallthrough
+  case CIR_AND:
+    v = zeros ? LOGIC_0 : unknown ? LOGIC_X : LOGIC_1;
+    break;
+  case CIR_NOR:
+    invert = 1; // fallthrough
+  case CIR_OR:
+    v = ones ? LOGIC_1 : unknown ? LOGIC_X : LOGIC_0;
+    break;
+  case CIR_XNOR:
+    invert = 1; // fallthrough
+  case CIR_XOR:
+    v = unknown ? LOGIC_X : (ones & 1) ? LOGIC_1 : LOGIC_0;
+    break;
+  case CIR_INVERTER:
+    invert = 1; // fallthrough
+  default:
+    v = nets[g.inputs[0]].value;
+    break;
+  }
+  if (invert && v != LOGIC_X) v = (v == LOGIC_1) ? LOGIC_0 : LOGIC_1;
+  return v;
+}
+
+// Applies the given logic value to the output voltage of a gate.
+void eventsim::drive (gate_t & g, int value) {
+  nr_double_t v = value == LOGIC_1 ? g.level :
+    value == LOGIC_0 ? 0 : g.level / 2;
+  g.cir->setE (VSRC_1, v);
+}
+
+/* This function changes the value of the given net, drives the
+   analog output of its gate and schedules the resulting changes of
+   the gates reading the net. */
+void eventsim::setNet (int n, int value) {
+  net_t & net = nets[n];
+  if (net.value == value) return;
+  net.value = value;
+  if (net.driver >= 0) drive (gates[net.driver], value);
+  for (int i : net.fanout) {
+    gate_t & g = gates[i];
+    int v = evaluate (g);
+    if (v != g.scheduled) {
+      g.scheduled = v;
+      schedule (now + g.delay, g.output, v);
+    }
+  }
+}
+
+// Orders the overflow heap by time.
+bool eventsim::earlier (const event_t & a, const event_t & b) {
+  return a.time > b.time;
+}
+
+/* Puts a change of the given net at the given time into the timing
+   wheel.  Changes in the past go into the current slot. */
+void eventsim::schedule (nr_double_t t, int n, int value) {
+  event_t e = { t, n, value };
+  long slot = (long) std::floor (t / resolution);
+  if (slot < base) slot = base;
+  if (slot - base < WHEEL_SIZE) {
+    wheel[slot % WHEEL_SIZE].push_back (e);
+  }
+  else {
+    overflow.push_back (e);
+    std::push_heap (overflow.begin (), overflow.end (), earlier);
+  }
+  pending++;
+}
+
+// Moves the overflowing events falling into the wheel back into it.
+void eventsim::refill (void) {
+  while (!overflow.empty ()) {
+    event_t & e = overflow.front ();
+    long slot = (long) std::floor (e.time / resolution);
+    if (slot - base >= WHEEL_SIZE) break;
+    if (slot < base) slot = base;
+    wheel[slot % WHEEL_SIZE].push_back (e);
+    std::pop_heap (overflow.begin (), overflow.end (), earlier);
+    overflow.pop_back ();
+  }
+}
+
+/* The function initializes the kernel at the given time.  The nets
+   take the values of the current (DC) solution and the gates settle
+   without delays. */
+void eventsim::start (nr_double_t t) {
+  // choose the wheel resolution according to the gate delays
+  resolution = NR_MAX;
+  for (gate_t & g : gates)
+    if (g.delay > 0 && g.delay < resolution) resolution = g.delay;
+  if (resolution == NR_MAX) resolution = 1e-9;
+
+  for (auto & slot : wheel) slot.clear ();
+  overflow.clear ();
+  base = (long) std::floor (t / resolution);
+  now = t;
+  pending = 0;
+  events = 0;
+
+  // sample the nets driven by the analog circuit
+  analogNets.clear ();
+  for (int n = 0; n < (int) nets.size (); n++) {
+    net_t & net = nets[n];
+    if (net.driver >= 0) continue;
+    analogNets.push_back (n);
+    nr_double_t v = real (net.probe->getV (net.port));
+    net.value = v > net.threshold ? LOGIC_1 : LOGIC_0;
+  }
+
+  // settle the gates, oscillating loops remain unknown
+  bool changed = true;
+  for (size_t pass = 0; changed && pass <= gates.size (); pass++) {
+    changed = false;
+    for (gate_t & g : gates) {
+      int v = evaluate (g);
+      if (nets[g.output].value != v) {
+	nets[g.output].value = v;
+	changed = true;
+      }
+    }
+  }
+  for (gate_t & g : gates) {
+    g.scheduled = nets[g.output].value;
+    drive (g, g.scheduled);
+  }
+}
+
+/* The function detaches the kernel from its gates, which are solved
+   by the analog solver again afterwards. */
+void eventsim::release (void) {
+  for (gate_t & g : gates) g.cir->setEventDriven (false);
+  gates.clear ();
+  nets.clear ();
+  netIndex.clear ();
+  analogNets.clear ();
+  for (auto & slot : wheel) slot.clear ();
+  overflow.clear ();
+  pending = 0;
+}
+
+/* This function samples the nets driven by the analog circuit at the
+   given (accepted) time.  Threshold crossings with a small hysteresis
+   become events at that time. */
+void eventsim::sample (nr_double_t t) {
+  if (t > now) now = t;
+  for (int n : analogNets) {
+    net_t & net = nets[n];
+    nr_double_t v = real (net.probe->getV (net.port));
+    nr_double_t h = net.threshold / 10;
+    int value = net.value;
+    if (value == LOGIC_1)
+      value = v < net.threshold - h ? LOGIC_0 : LOGIC_1;
+    else if (value == LOGIC_0)
+      value = v > net.threshold + h ? LOGIC_1 : LOGIC_0;
+    else
+      value = v > net.threshold ? LOGIC_1 : LOGIC_0;
+    if (value != net.value) schedule (t, n, value);
+  }
+}
+
+/* Processes all events up to the given time in order and returns
+   their number.  Changes of the gate outputs are applied to the
+   analog voltage sources of the gates. */
+int eventsim::advance (nr_double_t t) {
+  long last = (long) std::floor (t / resolution);
+  int count = 0, limit = 100 * ((int) gates.size () + 1);
+  nr_double_t at = now;
+  int same = 0;
+
+  while (pending > 0) {
+    refill ();
+    std::vector<event_t> & slot = wheel[base % WHEEL_SIZE];
+
+    // find the earliest due event of the current slot
+    int k = -1;
+    for (int i = 0; i < (int) slot.size (); i++)
+      if (slot[i].time <= t && (k < 0 || slot[i].time < slot[k].time))
+	k = i;
+    if (k < 0) {
+      if (base >= last || !slot.empty ()) break;
+      base++;
+      continue;
+    }
+
+    event_t e = slot[k];
+    slot[k] = slot.back ();
+    slot.pop_back ();
+    pending--;
+    if (e.time > now) now = e.time;
+
+    // zero delay loops never advance in time
+    if (now == at) {
+      if (++same > limit) {
+	logprint (LOG_ERROR, "WARNING: digital circuit oscillates at "
+		  "t = %.3e\n", (double) now);
+	break;
+      }
+    }
+    else {
+      at = now;
+      same = 0;
+    }
+
+    setNet (e.net, e.value);
+    events++;
+    count++;
+  }
+
+  if (pending == 0 && base < last) base = last;
+  if (t > now) now = t;
+  return count;
+}
+
+/* Returns the time of the next pending event, or NR_MAX if there is
+   none. */
+nr_double_t eventsim::nextEvent (void) {
+  if (pending == 0) return NR_MAX;
+  for (int i = 0; i < WHEEL_SIZE; i++) {
+    std::vector<event_t> & slot = wheel[(base + i) % WHEEL_SIZE];
+    if (slot.empty ()) continue;
+    nr_double_t t = slot[0].time;
+    for (event_t & e : slot) t = std::min (t, e.time);
+    return t;
+  }
+  return overflow.empty () ? NR_MAX : overflow.front ().time;
+}
+
+} // namespace qucs
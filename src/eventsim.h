@@ -0,0 +1,120 @@
+/*
+ * eventsim.h - event-driven digital simulation kernel definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __EVENTSIM_H__
+#define __EVENTSIM_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace qucs {
+
+class circuit;
+
+// Logic values.
+enum logic_value_t {
+  LOGIC_0 = 0,
+  LOGIC_1,
+  LOGIC_X
+};
+
+/*!\brief Event-driven digital simulation kernel
+
+   The kernel evaluates the digital gates of a netlist during a
+   transient analysis.  Each node connected to a gate is a digital net
+   with a logic value.  Gate outputs change after their delay, the
+   pending changes are kept in a timing wheel.  Nets driven by gates
+   propagate their values directly to the gates reading them.  Nets
+   driven by the analog part of the circuit are sampled after each
+   accepted time step and change their values when crossing the input
+   threshold.  The analog solver in turn sees the gates as ideal
+   voltage sources, which are updated only when their outputs
+   change.
+*/
+class eventsim
+{
+ public:
+  eventsim ();
+  ~eventsim ();
+  bool addCircuit (circuit *);
+  void start (nr_double_t);
+  void release (void);
+  void sample (nr_double_t);
+  int  advance (nr_double_t);
+  nr_double_t nextEvent (void);
+  int  getGates (void) { return (int) gates.size (); }
+  unsigned long getEvents (void) { return events; }
+
+ private:
+  struct event_t {
+    nr_double_t time;
+    int net;
+    int value;
+  };
+  struct gate_t {
+    circuit * cir;
+    int type;
+    int output;              // driven net
+    std::vector<int> inputs; // nets read
+    nr_double_t delay;
+    nr_double_t level;       // output high level
+    int scheduled;           // last value scheduled at the output
+  };
+  struct net_t {
+    int value;
+    int driver;              // gate driving the net, or -1 for analog
+    std::vector<int> fanout; // gates reading the net
+    circuit * probe;         // circuit and port to sample analog nets
+    int port;
+    nr_double_t threshold;
+  };
+
+  int  findNet (circuit *, int);
+  int  evaluate (gate_t &);
+  void setNet (int, int);
+  void drive (gate_t &, int);
+  void schedule (nr_double_t, int, int);
+  void refill (void);
+  static bool earlier (const event_t &, const event_t &);
+
+ private:
+  std::vector<gate_t> gates;
+  std::vector<net_t> nets;
+  std::map<std::string, int> netIndex;
+  std::vector<int> analogNets;
+
+  // the timing wheel: slots of the given resolution starting at the
+  // slot with the absolute number base, later events overflow into a
+  // heap
+  std::vector< std::vector<event_t> > wheel;
+  std::vector<event_t> overflow;
+  nr_double_t resolution;
+  long base;
+  nr_double_t now;
+  int pending;
+  unsigned long events;
+};
+
+} // namespace qucs
+
+#endif /* __EVENTSIM_H__ */
@@ -36,8 +36,8 @@
 
 using namespace qucs;
 
-// Global exception stack.
-exceptionstack qucs::estack;
+// Exception stack of the current thread.
+thread_local exceptionstack qucs::estack;
 
 // Constructor creates an instance of the exception stack class.
 exceptionstack::exceptionstack () {
@@ -44,8 +44,8 @@ class exceptionstack
   exception * root;
 };
 
-// Global exception stack.
-extern exceptionstack estack;
+// Exception stack of the current thread.
+extern thread_local exceptionstack estack;
 
 } /* namespace qucs */
 
@@ -48,6 +48,8 @@
 #include "dataset.h"
 #include "fourier.h"
 #include "hbsolver.h"
+#include "profile.h"
+#include "threadpool.h"
 
 #define HB_DEBUG 0
 
@@ -66,6 +68,10 @@ hbsolver::hbsolver () : analysis () {
   vs = x = NULL;
   runs = 0;
   ndfreqs = NULL;
+  pool = NULL;
+  lnfreqs = nlfreqs = 0;
+  VH1 = VH2 = NULL;
+  solutions = 0;
 }
 
 // Constructor creates a named instance of the hbsolver class.
@@ -79,6 +85,10 @@ hbsolver::hbsolver (char * n) : analysis (n) {
   vs = x = NULL;
   runs = 0;
   ndfreqs = NULL;
+  pool = NULL;
+  lnfreqs = nlfreqs = 0;
+  VH1 = VH2 = NULL;
+  solutions = 0;
 }
 
 // Destructor deletes the hbsolver class object.
@@ -119,6 +129,9 @@ hbsolver::~hbsolver () {
 
   delete x;
   delete[] ndfreqs;
+  delete pool;
+  delete VH1;
+  delete VH2;
 }
 
 /* The copy constructor creates a new instance of the hbsolver class
@@ -137,26 +150,39 @@ hbsolver::hbsolver (hbsolver & o) : analysis (o) {
   vs = x = NULL;
   runs = o.runs;
   ndfreqs = NULL;
+  pool = NULL;
+  lnfreqs = nlfreqs = 0;
+  VH1 = VH2 = NULL;
+  solutions = 0;
 }
 
 #define VS_(r) (*VS) (r)
 #define OM_(r) (*OM) (r)
 
 /* This is the HB netlist solver.  It prepares the circuit list and
-   solves it then. */
+   solves it then.  When run repeatedly, e.g. by a parameter sweep, the
+   circuit topology and the linear network are kept as far as possible
+   and the balancing starts at the solutions of the previous points. */
 int hbsolver::solve (void) {
 
-  int iterations = 0, done = 0;
+  int iterations;
   int MaxIterations = getPropertyInteger ("MaxIter");
 
-  // collect different parts of the circuit
-  splitCircuits ();
+  // threads evaluating independent frequencies and devices
+  delete pool;
+  pool = new threadpool (getPropertyInteger ("Threads"));
+
+  // collect different parts of the circuit, the topology does not
+  // change between the points of a sweep
+  if (runs == 0) splitCircuits ();
 
   // create frequency array
+  int nprev = nlfreqs;
   collectFrequencies ();
+  if (nlfreqs != nprev) resetNonLinear ();
 
   // find interconnects between the linear and non-linear subcircuit
-  getNodeLists ();
+  if (runs == 0) getNodeLists ();
 
   // prepares the linear part --> 0 = IC + [YV] * VS
   prepareLinear ();
@@ -179,120 +205,177 @@ int hbsolver::solve (void) {
       fprintf (stderr, "IC -- constant current in f:\n"); IC->print ();
 #endif
 
-    // start iteration
-    do {
-      iterations++;
+    // choose initial voltages and run the iteration, an extrapolated
+    // guess may be too far off, then use the previous solution
+    int guess = initialVoltages ();
+    iterations = balance (MaxIterations);
+    if (iterations < 0 && guess == HB_START_EXTRAPOLATE) {
+      logprint (LOG_STATUS, "NOTIFY: %s: restarting at the previous "
+		"solution\n", getName ());
+      *VS = *VH1;
+      *vs = *VS;
+      VectorIFFT (vs);
+      iterations = balance (MaxIterations);
+    }
+
+    if (iterations < 0) {
+      qucs::exception * e = new qucs::exception (EXCEPTION_NO_CONVERGENCE);
+      e->setText ("no convergence in %s analysis after %d iterations",
+		  getName (), MaxIterations);
+      throw_exception (e);
+      logprint (LOG_ERROR, "%s: no convergence after %d iterations\n",
+		getName (), MaxIterations);
+      solutions = 0;
+    }
+    else {
+      logprint (LOG_STATUS, "%s: convergence reached after %d iterations\n",
+		getName (), iterations);
+      // keep the solution for the next point
+      if (VH1 == NULL) VH1 = new tvector<nr_complex_t> (VS->size ());
+      if (VH2 == NULL) VH2 = new tvector<nr_complex_t> (VS->size ());
+      std::swap (VH1, VH2);
+      *VH1 = *VS;
+      if (solutions < 2) solutions++;
+    }
+  }
+  else {
+    // no balancing necessary
+    logprint (LOG_STATUS, "NOTIFY: %s: no balancing necessary\n", getName ());
+  }
+
+  // print exception stack
+  estack.print ();
+
+  // apply AC analysis to the complete network in order to obtain the
+  // final results
+  finalSolution ();
+
+  // save results into dataset
+  saveResults ();
+
+  delete pool; pool = NULL;
+  return 0;
+}
+
+/* The function sets up the initial voltages of the balancing.  These
+   are zero, the solution of the previous point or linearly
+   extrapolated from the last two points depending on the
+   "Continuation" property and the available solutions.  Returns the
+   kind of initial voltages used. */
+int hbsolver::initialVoltages (void) {
+  const char * const c = getPropertyString ("Continuation");
+  int guess = HB_START_ZERO;
+  if (!strcmp (c, "linear") && solutions > 1)
+    guess = HB_START_EXTRAPOLATE;
+  else if (strcmp (c, "none") && solutions > 0)
+    guess = HB_START_PREVIOUS;
+
+  switch (guess) {
+  case HB_START_EXTRAPOLATE:
+    *VS = 2.0 * *VH1 - *VH2;
+    break;
+  case HB_START_PREVIOUS:
+    *VS = *VH1;
+    break;
+  default:
+    VS->set (0.0);
+    break;
+  }
+  *vs = *VS;
+  if (guess != HB_START_ZERO) VectorIFFT (vs);
+  return guess;
+}
+
+/* This function runs the Newton iteration balancing the currents of
+   the linear and non-linear part starting at the current voltages.
+   Returns the number of iterations or -1 if there was no
+   convergence. */
+int hbsolver::balance (int MaxIterations) {
+  int iterations = 0;
+
+  // start iteration
+  do {
+    iterations++;
 
 #if HB_DEBUG
-      fprintf (stderr, "\n   -- iteration step: %d\n", iterations);
-      fprintf (stderr, "vs -- voltage in t:\n"); vs->print ();
+    fprintf (stderr, "\n   -- iteration step: %d\n", iterations);
+    fprintf (stderr, "vs -- voltage in t:\n"); vs->print ();
 #endif
 
-      // evaluate component functionality and fill matrices and vectors
-      loadMatrices ();
+    // evaluate component functionality and fill matrices and vectors
+    loadMatrices ();
 
 #if HB_DEBUG
-      fprintf (stderr, "FQ -- charge in t:\n"); FQ->print ();
-      fprintf (stderr, "IG -- current in t:\n"); IG->print ();
+    fprintf (stderr, "FQ -- charge in t:\n"); FQ->print ();
+    fprintf (stderr, "IG -- current in t:\n"); IG->print ();
 #endif
 
-      // currents into frequency domain
-      VectorFFT (IG);
+    // currents into frequency domain
+    VectorFFT (IG);
 
-      // charges into frequency domain
-      VectorFFT (FQ);
+    // charges into frequency domain
+    VectorFFT (FQ);
 
-      // right hand side currents and charges into the frequency domain
-      VectorFFT (IR);
-      VectorFFT (QR);
+    // right hand side currents and charges into the frequency domain
+    VectorFFT (IR);
+    VectorFFT (QR);
 
 #if HB_DEBUG
-      fprintf (stderr, "VS -- voltage in f:\n"); VS->print ();
-      fprintf (stderr, "FQ -- charge in f:\n"); FQ->print ();
-      fprintf (stderr, "IG -- current in f:\n"); IG->print ();
-      fprintf (stderr, "IR -- corrected Jacobi current in f:\n"); IR->print ();
+    fprintf (stderr, "VS -- voltage in f:\n"); VS->print ();
+    fprintf (stderr, "FQ -- charge in f:\n"); FQ->print ();
+    fprintf (stderr, "IG -- current in f:\n"); IG->print ();
+    fprintf (stderr, "IR -- corrected Jacobi current in f:\n"); IR->print ();
 #endif
 
-      // solve HB equation --> FV = IC + [YV] * VS + j[O] * FQ + IG
-      solveHB ();
+    // solve HB equation --> FV = IC + [YV] * VS + j[O] * FQ + IG
+    solveHB ();
 
 #if HB_DEBUG
-      fprintf (stderr, "FV -- error vector F(V) in f:\n"); FV->print ();
-      fprintf (stderr, "IL -- linear currents in f:\n"); IL->print ();
-      fprintf (stderr, "IN -- non-linear currents in f:\n"); IN->print ();
-      fprintf (stderr, "RH -- right-hand side currents in f:\n"); RH->print ();
+    fprintf (stderr, "FV -- error vector F(V) in f:\n"); FV->print ();
+    fprintf (stderr, "IL -- linear currents in f:\n"); IL->print ();
+    fprintf (stderr, "IN -- non-linear currents in f:\n"); IN->print ();
+    fprintf (stderr, "RH -- right-hand side currents in f:\n"); RH->print ();
 #endif
 
-      // termination criteria met
-      if (iterations > 1 && checkBalance ()) {
-	done = 1;
-	break;
-      }
+    // termination criteria met
+    if (iterations > 1 && checkBalance ()) return iterations;
 
 #if HB_DEBUG
-      fprintf (stderr, "JG -- G-Jacobian in t:\n"); JG->print ();
-      fprintf (stderr, "JQ -- C-Jacobian in t:\n"); JQ->print ();
+    fprintf (stderr, "JG -- G-Jacobian in t:\n"); JG->print ();
+    fprintf (stderr, "JQ -- C-Jacobian in t:\n"); JQ->print ();
 #endif
 
-      // G-Jacobian into frequency domain
-      MatrixFFT (JG);
+    // G-Jacobian into frequency domain
+    MatrixFFT (JG);
 
-      // C-Jacobian into frequency domain
-      MatrixFFT (JQ);
+    // C-Jacobian into frequency domain
+    MatrixFFT (JQ);
 
 #if HB_DEBUG
-      fprintf (stderr, "JQ -- dQ/dV C-Jacobian in f:\n"); JQ->print ();
-      fprintf (stderr, "JG -- dI/dV G-Jacobian in f:\n"); JG->print ();
+    fprintf (stderr, "JQ -- dQ/dV C-Jacobian in f:\n"); JQ->print ();
+    fprintf (stderr, "JG -- dI/dV G-Jacobian in f:\n"); JG->print ();
 #endif
 
-      // calculate Jacobian --> JF = [YV] + j[O] * JQ + JG
-      calcJacobian ();
+    // calculate Jacobian --> JF = [YV] + j[O] * JQ + JG
+    calcJacobian ();
 
 #if HB_DEBUG
-      fprintf (stderr, "JF -- full Jacobian in f:\n"); JF->print ();
+    fprintf (stderr, "JF -- full Jacobian in f:\n"); JF->print ();
 #endif
 
-      // solve equation system --> JF * VS(n+1) = JF * VS(n) - FV
-      solveVoltages ();
+    // solve equation system --> JF * VS(n+1) = JF * VS(n) - FV
+    solveVoltages ();
 
 #if HB_DEBUG
-      fprintf (stderr, "VS -- next voltage in f:\n"); VS->print ();
+    fprintf (stderr, "VS -- next voltage in f:\n"); VS->print ();
 #endif
 
-      // inverse FFT of frequency domain voltage vector VS(n+1)
-      VectorIFFT (vs);
-    }
-    // check termination criteria (balanced frequency domain currents)
-    while (!done && iterations < MaxIterations);
-
-    if (iterations >= MaxIterations) {
-      qucs::exception * e = new qucs::exception (EXCEPTION_NO_CONVERGENCE);
-      e->setText ("no convergence in %s analysis after %d iterations",
-		  getName (), iterations);
-      throw_exception (e);
-      logprint (LOG_ERROR, "%s: no convergence after %d iterations\n",
-		getName (), iterations);
-    }
-    else {
-      logprint (LOG_STATUS, "%s: convergence reached after %d iterations\n",
-		getName (), iterations);
-    }
+    // inverse FFT of frequency domain voltage vector VS(n+1)
+    VectorIFFT (vs);
   }
-  else {
-    // no balancing necessary
-    logprint (LOG_STATUS, "NOTIFY: %s: no balancing necessary\n", getName ());
-  }
-
-  // print exception stack
-  estack.print ();
-
-  // apply AC analysis to the complete network in order to obtain the
-  // final results
-  finalSolution ();
-
-  // save results into dataset
-  saveResults ();
-  return 0;
+  // check termination criteria (balanced frequency domain currents)
+  while (iterations < MaxIterations);
+  return -1;
 }
 
 /* Goes through the list of circuit objects and runs its calcHB()
@@ -300,6 +383,7 @@ int hbsolver::solve (void) {
 void hbsolver::calc (hbsolver * self) {
   circuit * root = self->getNet()->getRoot ();
   for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ()) {
+    profile_device pd (c);
     c->calcHB (self->frequency);
   }
 }
@@ -381,6 +465,7 @@ void hbsolver::collectFrequencies (void) {
   rfreqs.clear ();
   dfreqs.clear ();
   delete[] ndfreqs;
+  delete OM;
 
   // obtain order
   int i, n = calcOrder (getPropertyInteger ("n"));
@@ -558,15 +643,22 @@ void hbsolver::prepareLinear (void) {
   nbanodes = banodes->length ();
   assignNodes (lincircuits, nanodes);
   assignNodes (excitations, nanodes);
-  createMatrixLinearA ();
-  createMatrixLinearY ();
+  if (createMatrixLinearA ()) {
+    createMatrixLinearY ();
+  }
+  else {
+    // only the excitations may have changed
+    logprint (LOG_STATUS, "NOTIFY: %s: reusing linear network\n", getName ());
+    delete A; A = NULL;
+  }
   calcConstantCurrent ();
 }
 
 /* The function creates the complex linear network MNA matrix.  It
    contains the MNA entries for all linear components for each
-   requested frequency. */
-void hbsolver::createMatrixLinearA (void) {
+   requested frequency.  Returns zero if the matrix equals the one of
+   the previous run, non-zero otherwise. */
+int hbsolver::createMatrixLinearA (void) {
   int M = nlnvsrcs;
   int N = nnanodes;
   int f = 0;
@@ -585,8 +677,16 @@ void hbsolver::createMatrixLinearA (void) {
     fillMatrixLinearA (A, f++);
   }
 
+  // compare with the previous MNA matrix
+  int s = A->getCols ();
+  if (NA != NULL && NA->getCols () == s &&
+      std::equal (A->getData (), A->getData () + s * s, NA->getData ()))
+    return 0;
+
   // save a copy of the original MNA matrix
+  delete NA;
   NA = new tmatrix<nr_complex_t> (*A);
+  return 1;
 }
 
 // some definitions for the linear matrix filler
@@ -691,14 +791,8 @@ void hbsolver::invertMatrix (tmatrix<nr_complex_t> * A,
 #undef  A_
 #define A_(r,c) (*A) (r,c)
 
-#define Z_(r,c) (*Z) (r,c)
 #define Y_(r,c) (*Y) (r,c)
 
-#define ZVU_(r,c) Z_(r,c)
-#define ZVL_(r,c) Z_((r)*lnfreqs+f+sn,c)
-#define ZCU_(r,c) Z_(r,(c)*lnfreqs+f+sn)
-#define ZCL_(r,c) Z_((r)*lnfreqs+f+sn,(c)*lnfreqs+f+sn)
-
 #define YV_(r,c) (*YV) (r,c)
 #define NA_(r,c) (*NA) (r,c)
 #define JF_(r,c) (*JF) (r,c)
@@ -712,159 +806,153 @@ void hbsolver::invertMatrix (tmatrix<nr_complex_t> * A,
       current vector caused by the excitations
    4. invert this overall transimpedance matrix
    5. extract the variable transadmittance matrix entries
+   The linear network does not couple different frequencies, thus the
+   steps 2 to 4 are done for each frequency separately (and in
+   parallel) using the blocks of the matrices for that frequency.
 */
 void hbsolver::createMatrixLinearY (void) {
   int M = nlnvsrcs;
   int N = nnanodes;
-  int c, r, f;
 
-  // size of overall MNA matrix
-  int sa = (N + M) * lnfreqs;
+  // size of the MNA matrix blocks and the transimpedance matrix
   int sv = nbanodes;
   int se = nnlvsrcs;
   int sy = sv + se;
+  int sn = sv * lnfreqs;
 
-  // allocate new transimpedance matrix
-  Z = new tmatrix<nr_complex_t> (sy * lnfreqs);
-
-  // prepare equation system
-  eqnsys<nr_complex_t> eqns;
-  tvector<nr_complex_t> * V;
-  tvector<nr_complex_t> * I;
+  // allocate new transadmittance matrix
+  delete Y;
+  Y = new tmatrix<nr_complex_t> (sy * lnfreqs);
 
-  // 1. create variable transimpedance matrix entries relating
-  // voltages at the balanced nodes to the currents through these
-  // nodes into the non-linear part
-  int sn = sv * lnfreqs;
-  V = new tvector<nr_complex_t> (sa);
-  I = new tvector<nr_complex_t> (sa);
+  pool->run (lnfreqs, [&] (int f) {
+    int r, c, sa = N + M;
 
-  // connect a 100 Ohm resistor (to ground) to balanced node in the MNA matrix
-  for (c = 0; c < sv * lnfreqs; c++) A_(c, c) += 0.01;
+    // extract the MNA matrix block of the given frequency
+    tmatrix<nr_complex_t> Af (sa);
+    for (r = 0; r < sa; r++)
+      for (c = 0; c < sa; c++) Af (r, c) = A_(r * lnfreqs + f, c * lnfreqs + f);
 
-  // connect a 100 Ohm resistor (in parallel) to each excitation
-  for (auto *vs : excitations) {
-    // get positive and negative node
-    int pnode = vs->getNode(NODE_1)->getNode ();
-    int nnode = vs->getNode(NODE_2)->getNode ();
-    for (f = 0; f < lnfreqs; f++) { // for each frequency
-      int pn = (pnode - 1) * lnfreqs + f;
-      int nn = (nnode - 1) * lnfreqs + f;
-      if (pnode) A_(pn, pn) += 0.01;
-      if (nnode) A_(nn, nn) += 0.01;
-      if (pnode && nnode) {
-	A_(pn, nn) -= 0.01;
-	A_(nn, pn) -= 0.01;
+    // prepare equation system
+    eqnsys<nr_complex_t> eqns;
+    tvector<nr_complex_t> V (sa);
+    tvector<nr_complex_t> I (sa);
+
+    // connect a 100 Ohm resistor (to ground) to balanced node in the MNA
+    // matrix
+    for (c = 0; c < sv; c++) Af (c, c) += 0.01;
+
+    // connect a 100 Ohm resistor (in parallel) to each excitation
+    for (auto *vs : excitations) {
+      // get positive and negative node
+      int pn = vs->getNode(NODE_1)->getNode () - 1;
+      int nn = vs->getNode(NODE_2)->getNode () - 1;
+      if (pn >= 0) Af (pn, pn) += 0.01;
+      if (nn >= 0) Af (nn, nn) += 0.01;
+      if (pn >= 0 && nn >= 0) {
+	Af (pn, nn) -= 0.01;
+	Af (nn, pn) -= 0.01;
       }
     }
-  }
 
-  // LU decompose the MNA matrix
-  try_running () {
-    eqns.setAlgo (ALGO_LU_FACTORIZATION_CROUT);
-    eqns.passEquationSys (A, V, I);
-    eqns.solve ();
-  }
-  // appropriate exception handling
-  catch_exception () {
-  case EXCEPTION_PIVOT:
-  default:
-    logprint (LOG_ERROR, "WARNING: %s: during A factorization\n", getName ());
-    estack.print ();
-  }
+    // LU decompose the MNA matrix
+    try_running () {
+      eqns.setAlgo (ALGO_LU_FACTORIZATION_CROUT);
+      eqns.passEquationSys (&Af, &V, &I);
+      eqns.solve ();
+    }
+    // appropriate exception handling
+    catch_exception () {
+    case EXCEPTION_PIVOT:
+    default:
+      logprint (LOG_ERROR, "WARNING: %s: during A factorization\n",
+		getName ());
+      estack.print ();
+    }
 
-  // aquire variable transimpedance matrix entries
-  eqns.setAlgo (ALGO_LU_SUBSTITUTION_CROUT);
-  for (c = 0; c < sn; c++) {
-    I->set (0.0);
-    I_(c) = 1.0;
-    eqns.passEquationSys (A, V, I);
-    eqns.solve ();
-    // ZV | ..
-    // ---+---
-    // .. | ..
-    for (r = 0; r < sn; r++) ZVU_(r, c) = V_(r);
-    // .. | ..
-    // ---+---
-    // ZV | ..
-    r = 0;
-    for (auto ite = excitations.begin(); ite != excitations.end(); ++ite, r++) {
-      // lower part entries
-      for (f = 0; f < lnfreqs; f++) {
-	ZVL_(r, c) = excitationZ (V, *ite, f);
-      }
+    // transimpedance matrix of the given frequency
+    tmatrix<nr_complex_t> Zf (sy);
+    eqns.setAlgo (ALGO_LU_SUBSTITUTION_CROUT);
+
+    // 1. create variable transimpedance matrix entries relating
+    // voltages at the balanced nodes to the currents through these
+    // nodes into the non-linear part
+    for (c = 0; c < sv; c++) {
+      I.set (0.0);
+      I (c) = 1.0;
+      eqns.passEquationSys (&Af, &V, &I);
+      eqns.solve ();
+      // ZV | ..
+      // ---+---
+      // .. | ..
+      for (r = 0; r < sv; r++) Zf (r, c) = V (r);
+      // .. | ..
+      // ---+---
+      // ZV | ..
+      r = sv;
+      for (auto *vs : excitations) Zf (r++, c) = excitationZ (&V, vs);
     }
-  }
 
-  // create constant transimpedance matrix entries relating the
-  // source voltages to the interconnection currents
-  int vsrc = 0;
-  // aquire constant transadmittance matrix entries
-  for (auto it = excitations.begin(); it != excitations.end(); ++it, vsrc++) {
-    circuit * vs = *it;
-    // get positive and negative node
-    int pnode = vs->getNode(NODE_1)->getNode ();
-    int nnode = vs->getNode(NODE_2)->getNode ();
-    for (f = 0; f < lnfreqs; f++) { // for each frequency
-      int pn = (pnode - 1) * lnfreqs + f;
-      int nn = (nnode - 1) * lnfreqs + f;
-      I->set (0.0);
-      if (pnode) I_(pn) = +1.0;
-      if (nnode) I_(nn) = -1.0;
-      eqns.passEquationSys (A, V, I);
+    // create constant transimpedance matrix entries relating the
+    // source voltages to the interconnection currents
+    c = sv;
+    for (auto *vs : excitations) {
+      // get positive and negative node
+      int pn = vs->getNode(NODE_1)->getNode () - 1;
+      int nn = vs->getNode(NODE_2)->getNode () - 1;
+      I.set (0.0);
+      if (pn >= 0) I (pn) = +1.0;
+      if (nn >= 0) I (nn) = -1.0;
+      eqns.passEquationSys (&Af, &V, &I);
       eqns.solve ();
       // .. | ZC
       // ---+---
       // .. | ..
-      for (r = 0; r < sn; r++) {
-	// upper part of the entries
-	ZCU_(r, vsrc) = V_(r);
-      }
+      for (r = 0; r < sv; r++) Zf (r, c) = V (r);
       // .. | ..
       // ---+---
       // .. | ZC
-      r = 0;
-      for (auto ite = excitations.begin(); ite != excitations.end(); ++ite, r++) {
-	// lower part entries
-	ZCL_(r, vsrc) = excitationZ (V, *ite, f);
-      }
+      r = sv;
+      for (auto *ex : excitations) Zf (r++, c) = excitationZ (&V, ex);
+      c++;
     }
-  }
-  delete I;
-  delete V;
 
-  // allocate new transadmittance matrix
-  Y = new tmatrix<nr_complex_t> (sy * lnfreqs);
-
-  // invert the Z matrix to a Y matrix
-  invertMatrix (Z, Y);
-
-  // substract the 100 Ohm resistor
-  for (c = 0; c < sy * lnfreqs; c++) Y_(c, c) -= 0.01;
+    // invert the Z matrix to a Y matrix
+    tmatrix<nr_complex_t> Yf (sy);
+    invertMatrix (&Zf, &Yf);
+
+    // substract the 100 Ohm resistor and save the entries into the
+    // overall transadmittance matrix
+    for (c = 0; c < sy; c++) Yf (c, c) -= 0.01;
+    for (r = 0; r < sy; r++) {
+      int yr = r < sv ? r * lnfreqs + f : sn + (r - sv) * lnfreqs + f;
+      for (c = 0; c < sy; c++) {
+	int yc = c < sv ? c * lnfreqs + f : sn + (c - sv) * lnfreqs + f;
+	Y_(yr, yc) = Yf (r, c);
+      }
+    }
+  });
 
   // extract the variable transadmittance matrix
+  delete YV;
   YV = new tmatrix<nr_complex_t> (sv * nlfreqs);
 
   // variable transadmittance matrix must be continued conjugately
-  *YV = expandMatrix (*Y, sv);
+  expandMatrix (*Y, sv, *YV);
 
   // delete overall temporary MNA matrix
   delete A; A = NULL;
-  // delete transimpedance matrix
-  delete Z; Z = NULL;
 }
 
 /* Little helper function obtaining a transimpedance value for the
-   given voltage source (excitation) and for a given frequency
-   index. */
-nr_complex_t hbsolver::excitationZ (tvector<nr_complex_t> * V, circuit * vs,
-				    int f) {
+   given voltage source (excitation) from the node voltages of a
+   single frequency. */
+nr_complex_t hbsolver::excitationZ (tvector<nr_complex_t> * V, circuit * vs) {
   // get positive and negative node
   int pnode = vs->getNode(NODE_1)->getNode ();
   int nnode = vs->getNode(NODE_2)->getNode ();
   nr_complex_t z = 0.0;
-  if (pnode) z += V_((pnode - 1) * lnfreqs + f);
-  if (nnode) z -= V_((nnode - 1) * lnfreqs + f);
+  if (pnode) z += V_(pnode - 1);
+  if (nnode) z -= V_(nnode - 1);
   return z;
 }
 
@@ -890,6 +978,7 @@ void hbsolver::calcConstantCurrent (void) {
   }
 
   // compute constant current vector for balanced nodes
+  delete IC;
   IC = new tvector<nr_complex_t> (sn);
   // .. | YC * VC
   // ---+---
@@ -904,9 +993,12 @@ void hbsolver::calcConstantCurrent (void) {
     IC->set (r, i);
   }
   // expand the constant current conjugate
-  *IC = expandVector (*IC, nbanodes);
+  tvector<nr_complex_t> ic (nbanodes * nlfreqs);
+  expandVector (*IC, nbanodes, ic);
+  *IC = std::move (ic);
 
   // compute constant current vector for sources itself
+  delete IS;
   IS = new tvector<nr_complex_t> (se);
   // .. | ..
   // ---+---
@@ -918,9 +1010,6 @@ void hbsolver::calcConstantCurrent (void) {
     }
     IS->set (r, i);
   }
-
-  // delete overall transadmittance matrix
-  delete Y; Y = NULL;
 }
 
 /* Checks whether currents through the interconnects of the linear and
@@ -960,7 +1049,8 @@ int hbsolver::checkBalance (void) {
 #define QR_(r) (*qr) ((r)*nlfreqs+f)
 
 /* This function fills in the matrix and vector entries for the
-   non-linear HB equations for a given frequency index. */
+   non-linear HB equations for a given frequency index using the
+   entries saved by loadMatrices(). */
 void hbsolver::fillMatrixNonLinear (tmatrix<nr_complex_t> * jg,
 				    tmatrix<nr_complex_t> * jq,
 				    tvector<nr_complex_t> * ig,
@@ -968,29 +1058,52 @@ void hbsolver::fillMatrixNonLinear (tmatrix<nr_complex_t> * jg,
 				    tvector<nr_complex_t> * ir,
 				    tvector<nr_complex_t> * qr,
 				    int f) {
-  // through each linear circuit
+  int i = 0;
+  // through each non-linear circuit
   for (auto *cir: nolcircuits) {
     int s = cir->getSize ();
     int nr, nc, r, c;
+    // saved entries: Y, QV, I, Q, GV and CV
+    nr_complex_t * y = nlvalues[i++].data () + f * (2 * s * s + 4 * s);
+    nr_complex_t * qv = y + s * s;
+    nr_complex_t * cur = qv + s * s;
+    nr_complex_t * q = cur + s;
+    nr_complex_t * gv = q + s;
+    nr_complex_t * cv = gv + s;
 
     for (r = 0; r < s; r++) {
       if ((nr = cir->getNode(r)->getNode () - 1) < 0) continue;
       // apply G- and C-matrix entries
       for (c = 0; c < s; c++) {
 	if ((nc = cir->getNode(c)->getNode () - 1) < 0) continue;
-	G_(nr, nc) += cir->getY (r, c);
-	C_(nr, nc) += cir->getQV (r, c);
+	G_(nr, nc) += y[r * s + c];
+	C_(nr, nc) += qv[r * s + c];
       }
       // apply I- and Q-vector entries
-      FI_(nr) -= cir->getI (r);
-      FQ_(nr) -= cir->getQ (r);
+      FI_(nr) -= cur[r];
+      FQ_(nr) -= q[r];
       // ThinkME: positive or negative?
-      IR_(nr) += cir->getGV (r) + cir->getI (r);
-      QR_(nr) += cir->getCV (r) + cir->getQ (r);
+      IR_(nr) += gv[r] + cur[r];
+      QR_(nr) += cv[r] + q[r];
     }
   }
 }
 
+/* The function deletes the matrices and vectors of the non-linear
+   part as well as the solutions of previous runs.  Necessary if the
+   number of frequencies changes. */
+void hbsolver::resetNonLinear (void) {
+  delete FQ; delete IG; delete IR; delete QR;
+  delete JG; delete JQ; delete JF;
+  delete VS; delete vs; delete VP;
+  delete FV; delete RH; delete IL; delete IN;
+  delete VH1; delete VH2;
+  JQ = JG = JF = NULL;
+  IR = QR = RH = IG = FQ = VS = VP = FV = IL = IN = NULL;
+  vs = VH1 = VH2 = NULL;
+  solutions = 0;
+}
+
 /* The function initializes the non-linear part of the HB. */
 void hbsolver::prepareNonLinear (void) {
   int N = nbanodes;
@@ -1068,8 +1181,48 @@ void hbsolver::saveNodeVoltages (circuit * cir, int f) {
 
 /* The function saves voltages into non-linear circuits, runs each
    non-linear components' HB calculator for each frequency and applies
-   the matrix and vector entries appropriately. */
+   the matrix and vector entries appropriately.  The circuits are
+   evaluated in parallel, each for all frequencies, and their entries
+   are saved.  The matrices are filled in parallel for the different
+   frequencies afterwards. */
 void hbsolver::loadMatrices (void) {
+  profile_timer t (PROFILE_DEVICES);
+  std::vector<circuit *> cirs (nolcircuits.begin (), nolcircuits.end ());
+  nlvalues.resize (cirs.size ());
+
+  // calculate components' HB matrices and vectors for all frequencies
+  auto evaluate = [&] (int i) {
+    circuit * cir = cirs[i];
+    int r, c, s = cir->getSize ();
+    profile_device pd (cir);
+    nlvalues[i].resize (nlfreqs * (2 * s * s + 4 * s));
+    nr_complex_t * p = nlvalues[i].data ();
+    for (int f = 0; f < nlfreqs; f++) {
+      saveNodeVoltages (cir, f); // node voltages
+      cir->calcHB (f);           // HB calculator
+      for (r = 0; r < s; r++)
+	for (c = 0; c < s; c++) *p++ = cir->getY (r, c);
+      for (r = 0; r < s; r++)
+	for (c = 0; c < s; c++) *p++ = cir->getQV (r, c);
+      for (r = 0; r < s; r++) *p++ = cir->getI (r);
+      for (r = 0; r < s; r++) *p++ = cir->getQ (r);
+      for (r = 0; r < s; r++) *p++ = cir->getGV (r);
+      for (r = 0; r < s; r++) *p++ = cir->getCV (r);
+    }
+  };
+
+  // equation defined devices share the equation solver, these are
+  // evaluated serially
+  std::vector<int> par, ser;
+  for (int i = 0; i < (int) cirs.size (); i++) {
+    if (cirs[i]->getType () == CIR_EQNDEFINED)
+      ser.push_back (i);
+    else
+      par.push_back (i);
+  }
+  pool->run ((int) par.size (), [&] (int n) { evaluate (par[n]); });
+  for (int i : ser) evaluate (i);
+
   // clear matrices and vectors before
   IG->set (0.0);
   FQ->set (0.0);
@@ -1077,16 +1230,10 @@ void hbsolver::loadMatrices (void) {
   QR->set (0.0);
   JG->set (0.0);
   JQ->set (0.0);
-  // through each frequency
-  for (int f = 0; f < nlfreqs; f++) {
-    // calculate components' HB matrices and vector for the given frequency
-    for (auto *cir : nolcircuits) {
-      saveNodeVoltages (cir, f); // node voltages
-      cir->calcHB (f);         // HB calculator
-    }
-    // fill in all matrix entries for the given frequency
+  // fill in all matrix entries for each frequency
+  pool->run (nlfreqs, [&] (int f) {
     fillMatrixNonLinear (JG, JQ, IG, FQ, IR, QR, f);
-  }
+  });
 }
 
 /* The following function transforms a vector using a Fast Fourier
@@ -1224,10 +1371,10 @@ void hbsolver::calcJacobian (void) {
 }
 
 /* The function expands the given vector in the frequency domain to
-   make it a real valued signal in the time domain. */
-tvector<nr_complex_t> hbsolver::expandVector (tvector<nr_complex_t> V,
-					      int nodes) {
-  tvector<nr_complex_t> res (nodes * nlfreqs);
+   make it a real valued signal in the time domain.  The result is
+   stored in the preallocated vector 'res'. */
+void hbsolver::expandVector (tvector<nr_complex_t> & V, int nodes,
+			     tvector<nr_complex_t> & res) {
   int r, ff, rf, rt;
   for (r = 0; r < nodes; r++) {
     rt = r * nlfreqs;
@@ -1241,14 +1388,13 @@ tvector<nr_complex_t> hbsolver::expandVector (tvector<nr_complex_t> V,
       res (rt) = conj (V (rf));
     }
   }
-  return res;
 }
 
 /* The function expands the given matrix in the frequency domain to
-   make it a real valued signal in the time domain. */
-tmatrix<nr_complex_t> hbsolver::expandMatrix (tmatrix<nr_complex_t> M,
-					      int nodes) {
-  tmatrix<nr_complex_t> res (nodes * nlfreqs);
+   make it a real valued signal in the time domain.  The result is
+   stored in the preallocated matrix 'res'. */
+void hbsolver::expandMatrix (tmatrix<nr_complex_t> & M, int nodes,
+			     tmatrix<nr_complex_t> & res) {
   int r, c, rf, rt, cf, ct, ff;
   for (r = 0; r < nodes; r++) {
     for (c = 0; c < nodes; c++) {
@@ -1266,7 +1412,6 @@ tmatrix<nr_complex_t> hbsolver::expandMatrix (tmatrix<nr_complex_t> M,
       }
     }
   }
-  return res;
 }
 
 /* This function solves the equation system
@@ -1348,10 +1493,10 @@ void hbsolver::fillMatrixLinearExtended (tmatrix<nr_complex_t> * Y,
 /* The function calculates and saves the final solution. */
 void hbsolver::finalSolution (void) {
 
-  // extend the linear MNA matrix
-  *NA = extendMatrixLinear (*NA, nnlvsrcs);
+  // extend (a copy of) the linear MNA matrix
+  tmatrix<nr_complex_t> MA = extendMatrixLinear (*NA, nnlvsrcs);
 
-  int S = NA->getCols ();
+  int S = MA.getCols ();
   int N = nnanodes * lnfreqs;
 
   // right hand side vector
@@ -1359,10 +1504,11 @@ void hbsolver::finalSolution (void) {
   // temporary solution
   tvector<nr_complex_t> * V = new tvector<nr_complex_t> (S);
   // final solution
+  delete x;
   x = new tvector<nr_complex_t> (N);
 
   // fill in missing MNA entries
-  fillMatrixLinearExtended (NA, I);
+  fillMatrixLinearExtended (&MA, I);
 
   // put currents through balanced nodes into right hand side
   for (int n = 0; n < nbanodes; n++) {
@@ -1377,7 +1523,7 @@ void hbsolver::finalSolution (void) {
   try_running () {
     eqnsys<nr_complex_t> eqns;
     eqns.setAlgo (ALGO_LU_DECOMPOSITION);
-    eqns.passEquationSys (NA, V, I);
+    eqns.passEquationSys (&MA, V, I);
     eqns.solve ();
   }
   // appropriate exception handling
@@ -1393,6 +1539,7 @@ void hbsolver::finalSolution (void) {
 
 // Saves simulation results.
 void hbsolver::saveResults (void) {
+  profile_timer t (PROFILE_SAVE);
   vector * f;
   // add current frequency to the dependency of the output dataset
   if ((f = data->findDependency ("hbfrequency")) == NULL) {
@@ -1425,6 +1572,9 @@ PROP_OPT [] = {
   { "vabstol", PROP_REAL, { 1e-6, PROP_NO_STR }, PROP_RNG_X01I },
   { "reltol", PROP_REAL, { 1e-3, PROP_NO_STR }, PROP_RNG_X01I },
   { "MaxIter", PROP_INT, { 150, PROP_NO_STR }, PROP_RNGII (2, 10000) },
+  { "Threads", PROP_INT, { 0, PROP_NO_STR }, PROP_RNGII (0, 256) },
+  { "Continuation", PROP_STR, { PROP_NO_VAL, "linear" },
+    PROP_RNG_STR3 ("none", "constant", "linear") },
   PROP_NO_PROP };
 struct define_t hbsolver::anadef =
   { "HB", 0, PROP_ACTION, PROP_NO_SUBSTRATE, PROP_LINEAR, PROP_DEF };
@@ -32,9 +32,17 @@
 
 namespace qucs {
 
+// Initial voltages of the balancing.
+enum hb_start_t {
+  HB_START_ZERO = 0,   // zero
+  HB_START_PREVIOUS,   // solution of the previous run
+  HB_START_EXTRAPOLATE // extrapolated from the previous two runs
+};
+
 class vector;
 class strlist;
 class circuit;
+class threadpool;
 
 class hbsolver : public analysis
 {
@@ -58,19 +66,22 @@ class hbsolver : public analysis
   int  assignVoltageSources (ptrlist<circuit>);
   int  assignNodes (ptrlist<circuit>, strlist *, int offset = 0);
   void prepareLinear (void);
-  void createMatrixLinearA (void);
+  int  createMatrixLinearA (void);
   void fillMatrixLinearA (tmatrix<nr_complex_t> *, int);
   void invertMatrix (tmatrix<nr_complex_t> *, tmatrix<nr_complex_t> *);
   void createMatrixLinearY (void);
   void saveResults (void);
   void calcConstantCurrent (void);
-  nr_complex_t excitationZ (tvector<nr_complex_t> *, circuit *, int);
+  nr_complex_t excitationZ (tvector<nr_complex_t> *, circuit *);
   void finalSolution (void);
   void fillMatrixNonLinear (tmatrix<nr_complex_t> *, tmatrix<nr_complex_t> *,
 			    tvector<nr_complex_t> *, tvector<nr_complex_t> *,
 			    tvector<nr_complex_t> *, tvector<nr_complex_t> *,
 			    int);
   void prepareNonLinear (void);
+  void resetNonLinear (void);
+  int  initialVoltages (void);
+  int  balance (int);
   void solveHB (void);
   void loadMatrices (void);
   void VectorFFT (tvector<nr_complex_t> *, int isign = 1);
@@ -79,8 +90,8 @@ class hbsolver : public analysis
   void MatrixFFT (tmatrix<nr_complex_t> *);
   void calcJacobian (void);
   void solveVoltages (void);
-  tvector<nr_complex_t> expandVector (tvector<nr_complex_t>, int);
-  tmatrix<nr_complex_t> expandMatrix (tmatrix<nr_complex_t>, int);
+  void expandVector (tvector<nr_complex_t> &, int, tvector<nr_complex_t> &);
+  void expandMatrix (tmatrix<nr_complex_t> &, int, tmatrix<nr_complex_t> &);
   tmatrix<nr_complex_t> extendMatrixLinear (tmatrix<nr_complex_t>, int);
   void fillMatrixLinearExtended (tmatrix<nr_complex_t> *,
 				 tvector<nr_complex_t> *);
@@ -125,6 +136,9 @@ class hbsolver : public analysis
   tvector<nr_complex_t> * IS; // currents through sources themselves
   tvector<nr_complex_t> * x;
   tvector<nr_complex_t> * vs;
+  tvector<nr_complex_t> * VH1; // converged voltages of the previous run
+  tvector<nr_complex_t> * VH2; // and of the run before
+  int solutions;               // number of these solutions
 
   int runs;
   int lnfreqs;
@@ -135,6 +149,10 @@ class hbsolver : public analysis
   int nnanodes;
   int nexnodes;
   int nbanodes;
+
+  threadpool * pool;
+  // HB matrix and vector entries of the non-linear circuits in t
+  std::vector< std::vector<nr_complex_t> > nlvalues;
 };
 
 } // namespace qucs
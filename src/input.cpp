@@ -44,6 +44,8 @@
 #include "check_netlist.h"
 #include "equation.h"
 #include "module.h"
+#include "profile.h"
+#include "netcache.h"
 
 namespace qucs {
 
@@ -86,17 +88,33 @@ int input::netlist (net * netlist) {
   // save the netlist object
   subnet = netlist;
 
-  logprint (LOG_STATUS, "parsing netlist...\n");
+  // a cached netlist has been parsed and checked before
+  netcache cache (getFile ());
+  int cached = cache.load () == 0;
 
-  if (netlist_parse () != 0)
-    return -1;
+  if (cached) {
+    logprint (LOG_STATUS, "loading cached netlist...\n");
+  }
+  else {
+    logprint (LOG_STATUS, "parsing netlist...\n");
+
+    if (netlist_parse () != 0)
+      return -1;
+    cache.record ();
+  }
 
   logprint (LOG_STATUS, "checking netlist...\n");
-  if (netlist_checker (env) != 0)
+  netlist_trusted = cached;
+  int err = netlist_checker (env);
+  netlist_trusted = 0;
+  if (err != 0)
     return -1;
 
-  if (netlist_checker_variables (env) != 0)
-    return -1;
+  if (!cached) {
+    if (netlist_checker_variables (env) != 0)
+      return -1;
+    cache.store ();
+  }
 
 #if DEBUG
   netlist_list ();
@@ -236,6 +254,7 @@ void input::factory (void) {
     if (!def->action && !def->substrate && !def->nodeset) {
       c = createCircuit (def->type);
       assert (c != NULL);
+      profile::nameDevice (c->getType (), def->type);
       o = (object *) c;
       c->setName (def->instance);
       c->setNonLinear (def->nonlinear != 0);
@@ -27,8 +27,9 @@
 
 #include "states.h"
 
-#define MODE_NONE 0
-#define MODE_INIT 1
+#define MODE_NONE    0
+#define MODE_INIT    1
+#define MODE_RESTART 2 // with MODE_INIT: restart ignoring initial conditions
 
 namespace qucs {
 
@@ -226,6 +226,9 @@ int e_trsolver::init (nr_double_t start, nr_double_t firstdelta, int mode)
     setCalculation ((calculate_func_t) &calcTR);
     solve_pre ();
 
+    // Node numbers may have changed, drop previously resolved handles.
+    handles.clear ();
+
     // Recall the DC solution.
     recallSolution ();
 
@@ -365,6 +368,8 @@ void e_trsolver::initETR (nr_double_t start, nr_double_t firstdelta, int mode)
     // also initialize the created circuit elements
     for (c = root; c != NULL; c = (circuit *) c->getPrev ())
         initCircuitTR (c);
+    // put the circuit states into one arena
+    initStateArena ();
 }
 
 void e_trsolver::printx()
@@ -899,19 +904,20 @@ int e_trsolver::getNodeV (char * label, nr_double_t& nodeV)
     }
 }
 
-/* Get the voltage reported by a voltage probe */
-int e_trsolver::getVProbeV (char * probename, nr_double_t& probeV)
+/* Looks for the circuit of the given type with the given name.  Inside
+   subcircuits the name is prefixed by the subcircuit type. */
+circuit * e_trsolver::findCircuit (int type, char * name)
 {
     // string to hold the full name of the circuit
     std::string fullname;
 
     // check for NULL name
-    if (probename)
+    if (name)
     {
         circuit * root = subnet->getRoot ();
         for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
         {
-            if (c->getType () == CIR_VPROBE) {
+            if (c->getType () == type) {
 
                 fullname.clear ();
 
@@ -925,107 +931,136 @@ int e_trsolver::getVProbeV (char * probename, nr_double_t& probeV)
                 }
 
                 // append the user supplied name to search for
-                fullname.append (probename);
+                fullname.append (name);
 
-                // Check if it is the desired voltage source
+                // Check if it is the desired circuit
                 if (strcmp (fullname.c_str(), c->getName ()) == 0)
-                {
-                    // Saves the real and imaginary voltages in the probe to the
-                    // named variables Vr and Vi
-                    c->saveOperatingPoints ();
-                    // We are only interested in the real part for transient
-                    // analysis
-                    probeV = c->getOperatingPoint ("Vr");
-
-                    return 0;
-                }
+                    return c;
             }
         }
     }
-    return -1;
+    return NULL;
+}
+
+/* Get the voltage reported by a voltage probe */
+int e_trsolver::getVProbeV (char * probename, nr_double_t& probeV)
+{
+    circuit * c = findCircuit (CIR_VPROBE, probename);
+    if (c == NULL)
+        return -1;
+
+    // Saves the real and imaginary voltages in the probe to the
+    // named variables Vr and Vi
+    c->saveOperatingPoints ();
+    // We are only interested in the real part for transient
+    // analysis
+    probeV = c->getOperatingPoint ("Vr");
+    return 0;
 }
 
 /* Get the current reported by a current probe */
 int e_trsolver::getIProbeI (char * probename, nr_double_t& probeI)
 {
-    // string to hold the full name of the circuit
-    std::string fullname;
+    circuit * c = findCircuit (CIR_IPROBE, probename);
+    if (c == NULL)
+        return -1;
 
-    // check for NULL name
-    if (probename)
-    {
-        circuit * root = subnet->getRoot ();
-        for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
-        {
-            if (c->getType () == CIR_IPROBE) {
+    // Get the current reported by the probe
+    probeI = real (x->get (c->getVoltageSource () + getN ()));
+    return 0;
+}
 
-                fullname.clear ();
+int e_trsolver::setECVSVoltage(char * ecvsname, nr_double_t V)
+{
+    circuit * c = findCircuit (CIR_ECVS, ecvsname);
+    if (c == NULL)
+        return -1;
 
-                // Subcircuit elements top level name is the
-                // subcircuit type (the base name of the subcircuit
-                // file)
-                if (!c->getSubcircuit ().empty())
-                {
-                    fullname.append (c->getSubcircuit ());
-                    fullname.append (".");
-                }
+    // Set the voltage to the desired value
+    c->setProperty("U", V);
+    return 0;
+}
 
-                // append the user supplied name to search for
-                fullname.append (probename);
+/* Resolves the given name into a handle for the batched accessors.
+   Returns -1 if there is no such node, probe or ecvs. */
+int e_trsolver::getHandle (int type, char * name)
+{
+    handle_t h;
+    h.type = type;
+    h.pos = h.neg = -1;
+    h.c = NULL;
 
-                // Check if it is the desired voltage source
-                if (strcmp (fullname.c_str(), c->getName ()) == 0)
-                {
-                    // Get the current reported by the probe
-                    probeI = real (x->get (c->getVoltageSource () + getN ()));
+    switch (type)
+    {
+    case ETR_HANDLE_NODE:
+        if (name == NULL || (h.pos = nlist->getNodeNr (name)) == -1)
+            return -1;
+        // node numbers start at 1 in the solution vector, ground is 0
+        // and thus maps to -1, i.e. reads 0 V
+        h.pos = h.pos - 1;
+        break;
+    case ETR_HANDLE_VPROBE:
+        if ((h.c = findCircuit (CIR_VPROBE, name)) == NULL)
+            return -1;
+        h.pos = nlist->getNodeNr (h.c->getNode (NODE_1)->getName ()) - 1;
+        h.neg = nlist->getNodeNr (h.c->getNode (NODE_2)->getName ()) - 1;
+        break;
+    case ETR_HANDLE_IPROBE:
+        if ((h.c = findCircuit (CIR_IPROBE, name)) == NULL)
+            return -1;
+        h.pos = h.c->getVoltageSource () + getN ();
+        break;
+    case ETR_HANDLE_ECVS:
+        if ((h.c = findCircuit (CIR_ECVS, name)) == NULL)
+            return -1;
+        break;
+    default:
+        return -1;
+    }
+    handles.push_back (h);
+    return handles.size () - 1;
+}
 
-                    return 0;
-                }
-            }
+/* Copies the values of the given node and probe handles into a
+   contiguous buffer. */
+int e_trsolver::getValues (int * hnd, int n, double * values)
+{
+    int error = 0;
+    int size = handles.size ();
+    for (int i = 0; i < n; i++)
+    {
+        if (hnd[i] < 0 || hnd[i] >= size ||
+            handles[hnd[i]].type == ETR_HANDLE_ECVS)
+        {
+            values[i] = 0.0;
+            error = -1;
+            continue;
         }
+        handle_t & h = handles[hnd[i]];
+        nr_double_t v = 0.0;
+        if (h.pos >= 0) v += x->get (h.pos);
+        if (h.neg >= 0) v -= x->get (h.neg);
+        values[i] = (double) v;
     }
-    return -1;
+    return error;
 }
 
-int e_trsolver::setECVSVoltage(char * ecvsname, nr_double_t V)
+/* Sets the voltages of the given ecvs handles. */
+int e_trsolver::setECVSVoltages (int * hnd, int n, double * V)
 {
-    // string to hold the full name of the circuit
-    std::string fullname;
-
-    // check for NULL name
-    if (ecvsname)
+    int error = 0;
+    int size = handles.size ();
+    for (int i = 0; i < n; i++)
     {
-        circuit * root = subnet->getRoot ();
-        for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
+        if (hnd[i] < 0 || hnd[i] >= size ||
+            handles[hnd[i]].type != ETR_HANDLE_ECVS)
         {
-            // examine only ECVS elements
-            if (c->getType () == CIR_ECVS) {
-
-                fullname.clear ();
-
-                // Subcircuit elements top level name is the
-                // subcircuit type (the base name of the subcircuit
-                // file)
-                if (!c->getSubcircuit ().empty())
-                {
-                    fullname.append (c->getSubcircuit ());
-                    fullname.append (".");
-                }
-
-                // append the user supplied name to search for
-                fullname.append (ecvsname);
-
-                // Check if it is the desired voltage source
-                if (strcmp (fullname.c_str(), c->getName ()) == 0)
-                {
-                    // Set the voltage to the desired value
-                    c->setProperty("U", V);
-                    return 0;
-                }
-            }
+            error = -1;
+            continue;
         }
+        handles[hnd[i]].c->setProperty ("U", (nr_double_t) V[i]);
     }
-    return -1;
+    return error;
 }
 
 void e_trsolver::updateExternalInterpTime(nr_double_t t)
@@ -1073,6 +1108,37 @@ void e_trsolver::getJacData(int r, int c, nr_double_t& data)
     data = A->get(r,c);
 }
 
+void e_trsolver::getJacDense(double * data)
+{
+    int rows = A->getRows ();
+    int cols = A->getCols ();
+    for (int c = 0; c < cols; c++)
+        for (int r = 0; r < rows; r++)
+            data[c * rows + r] = (double) A->get (r, c);
+}
+
+int e_trsolver::getJacSparse(int * rows, int * cols, double * data,
+                             int size)
+{
+    int nnz = 0;
+    for (int c = 0; c < A->getCols (); c++)
+    {
+        for (int r = 0; r < A->getRows (); r++)
+        {
+            nr_double_t d = A->get (r, c);
+            if (d == 0.0) continue;
+            if (nnz < size)
+            {
+                if (rows) rows[nnz] = r;
+                if (cols) cols[nnz] = c;
+                if (data) data[nnz] = (double) d;
+            }
+            nnz++;
+        }
+    }
+    return nnz;
+}
+
 // properties
 PROP_REQ [] =
 {
@@ -1097,6 +1163,7 @@ PROP_OPT [] =
     { "LTEfactor", PROP_REAL, { 1, PROP_NO_STR }, PROP_RNGII (1, 16) },
     { "Temp", PROP_REAL, { 26.85, PROP_NO_STR }, PROP_MIN_VAL (K) },
     { "Solver", PROP_STR, { PROP_NO_VAL, "CroutLU" }, PROP_RNG_SOL },
+    { "Ordering", PROP_STR, { PROP_NO_VAL, "none" }, PROP_RNG_ORD },
     { "relaxTSR", PROP_STR, { PROP_NO_VAL, "no" }, PROP_RNG_YESNO },
     { "initialDC", PROP_STR, { PROP_NO_VAL, "yes" }, PROP_RNG_YESNO },
     PROP_NO_PROP
@@ -148,6 +148,62 @@ public:
       */
     int getIProbeI (char * probename, nr_double_t& probeI);
 
+    /** \brief Resolves a node, probe or ecvs name into a handle
+      * \param type Kind of the object, one of the ETR_HANDLE values
+      * \param name Pointer to character array containing the name
+      * \return The handle (>= 0) or -1 if no such object exists
+      *
+      * The name is looked up once and the handle can be used with
+      * getValues() and setECVSVoltages() for the rest of the
+      * simulation, avoiding the string search of the per-value
+      * accessors.  Node and probe names are resolved like in
+      * getNodeV(), getVProbeV() and getIProbeI(), ecvs names like in
+      * setECVSVoltage().  Handles are valid after init() and are
+      * dropped on the next call to init().
+      */
+    int getHandle (int type, char * name);
+
+    /** \brief Obtains the values of a set of node or probe handles
+      * \param handles Array of \a n handles obtained by getHandle()
+      * \param n Number of handles
+      * \param values Array of size \a n receiving the values
+      * \return 0 on success and -1 if any handle is invalid
+      *
+      * Node handles yield node voltages, voltage probe handles the
+      * probe voltage and current probe handles the probe current of
+      * the current solution.
+      */
+    int getValues (int * handles, int n, double * values);
+
+    /** \brief Sets the voltages of a set of ecvs handles
+      * \param handles Array of \a n ecvs handles obtained by getHandle()
+      * \param n Number of handles
+      * \param V Array of size \a n containing the new voltages
+      * \return 0 on success and -1 if any handle is invalid
+      */
+    int setECVSVoltages (int * handles, int n, double * V);
+
+    /** \brief Copies the complete Jacobian matrix into a dense block
+      * \param data Array of size getJacRows() * getJacCols()
+      *
+      * The matrix is stored in column major order, i.e. the element
+      * in row r and column c is placed at data[c * rows + r].
+      */
+    void getJacDense (double * data);
+
+    /** \brief Exports the non-zero Jacobian entries in coordinate format
+      * \param rows Array receiving the row indices, or NULL
+      * \param cols Array receiving the column indices, or NULL
+      * \param data Array receiving the values, or NULL
+      * \param size Capacity of the arrays
+      * \return The number of non-zero entries in the matrix
+      *
+      * At most \a size entries are written in column major order.
+      * Passing NULL arrays only counts the non-zero entries, which
+      * can be used to size the buffers.
+      */
+    int getJacSparse (int * rows, int * cols, double * data, int size);
+
     // debugging functions
     void debug (void);
     void printx (void);
@@ -190,6 +246,17 @@ private:
 //    int solve_nonlinear_step (void);
     void adjustDelta_sync (nr_double_t);
 
+    // Batched access handles, a value is x[pos] - x[neg] where an
+    // index of -1 denotes ground; ecvs handles keep their circuit
+    struct handle_t {
+        int type;
+        int pos;
+        int neg;
+        circuit * c;
+    };
+    std::vector<handle_t> handles;
+    circuit * findCircuit (int, char *);
+
     // Asynchronous specific items
 
     // For going back in history of a solution after multiple
@@ -354,6 +354,44 @@ int trsolver_interface::getIProbeI (char * probename, double& probeI)
     }
 }
 
+int trsolver_interface::getHandle (int type, char * name)
+{
+    if (etr) return etr->getHandle (type, name);
+    else return -2;
+}
+
+int trsolver_interface::getValues (int * handles, int n, double * values)
+{
+    if (etr) return etr->getValues (handles, n, values);
+    else return -2;
+}
+
+int trsolver_interface::setECVSVoltages (int * handles, int n, double * V)
+{
+    if (etr) return etr->setECVSVoltages (handles, n, V);
+    else return -2;
+}
+
+int trsolver_interface::getJacDense (double * data)
+{
+    if (etr)
+    {
+        etr->getJacDense (data);
+        return 0;
+    }
+    else
+    {
+        return -2;
+    }
+}
+
+int trsolver_interface::getJacSparse (int * rows, int * cols, double * data,
+                                      int size)
+{
+    if (etr) return etr->getJacSparse (rows, cols, data, size);
+    else return -2;
+}
+
 //void trsolver_interface::debug (void)
 //{
 //    if (etr) etr->debug ();
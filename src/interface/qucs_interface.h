@@ -95,6 +95,12 @@ protected:
 
 enum ETR_MODE { ETR_MODE_ASYNC, ETR_MODE_SYNC };
 
+/// Kinds of objects which can be resolved into handles for batched access
+enum ETR_HANDLE { ETR_HANDLE_NODE,
+                  ETR_HANDLE_VPROBE,
+                  ETR_HANDLE_IPROBE,
+                  ETR_HANDLE_ECVS };
+
 /** \class trsolver_interface
   * \brief subclass for interfacing to the Qucs transient circuit solvers.
   *
@@ -201,6 +207,47 @@ public:
       */
     int getIProbeI (char * probename, double& probeI);
 
+    /** \brief Resolves a node, probe or ecvs name into a handle
+      * \param type Kind of the object, one of the ETR_HANDLE values
+      * \param name Pointer to character array containing the name
+      * \return The handle (>= 0), -1 if no such object exists
+      *
+      * Handles avoid the name lookup of getNodeV(), getVProbeV(),
+      * getIProbeI() and setECVSVoltage() on every synchronisation
+      * step.  They are valid until the next call to init().
+      */
+    int getHandle (int type, char * name);
+
+    /** \brief Obtains the values of node and probe handles in one call
+      * \param handles Array of \a n handles obtained by getHandle()
+      * \param n Number of handles
+      * \param values Array of size \a n receiving the values
+      * \return 0 on success, -1 if any handle is invalid
+      */
+    int getValues (int * handles, int n, double * values);
+
+    /** \brief Sets the voltages of ecvs handles in one call
+      * \param handles Array of \a n handles obtained by getHandle()
+      * \param n Number of handles
+      * \param V Array of size \a n containing the new voltages
+      * \return 0 on success, -1 if any handle is invalid
+      */
+    int setECVSVoltages (int * handles, int n, double * V);
+
+    /** \brief Copies the Jacobian matrix into a column major dense block
+      * \param data Array of size getJacRows() * getJacCols()
+      */
+    int getJacDense (double * data);
+
+    /** \brief Exports the non-zero Jacobian entries in coordinate format
+      * \param rows Array receiving the row indices, or NULL
+      * \param cols Array receiving the column indices, or NULL
+      * \param data Array receiving the values, or NULL
+      * \param size Capacity of the arrays
+      * \return The number of non-zero entries
+      */
+    int getJacSparse (int * rows, int * cols, double * data, int size);
+
     /** \brief Sets pointer to function used to print messages during a sim
       * \param printing function to be used by e_trsolver
       *
@@ -265,6 +265,28 @@ nr_complex_t interpolator::clinear (nr_double_t x, int idx) {
   return nr_complex_t (r, i);
 }
 
+/* Returns the first data point after the given dependency value.  The
+   piecewise linear and hold interpolations have their corners there.
+   Splines are smooth, so there are no breakpoints. */
+nr_double_t interpolator::nextBreakpoint (nr_double_t x) {
+  nr_double_t base = 0.0;
+
+  if (length <= 1 || !(interpolType & (INTERPOL_LINEAR | INTERPOL_HOLD)))
+    return NR_MAX;
+  if (repeat & REPEAT_YES) {
+    base = std::floor (x / duration) * duration;
+    x = x - base;
+  }
+  int idx = findIndex (x);
+  if (rx[idx] > x)
+    return base + rx[idx];
+  if (idx + 1 < length)
+    return base + rx[idx + 1];
+  if (repeat & REPEAT_YES)
+    return base + duration + rx[0];
+  return NR_MAX;
+}
+
 /* This function interpolates for real values.  Returns the linear
    interpolation of the real y-vector for the given value in the
    x-vector. */
@@ -55,6 +55,7 @@ class interpolator
   void prepare (int, int, int domain = DATA_RECTANGULAR);
   nr_double_t rinterpolate (nr_double_t);
   nr_complex_t cinterpolate (nr_double_t);
+  nr_double_t nextBreakpoint (nr_double_t);
 
 private:
   int findIndex (nr_double_t);
@@ -131,8 +131,7 @@ cbesselj_smallarg (unsigned int n, nr_complex_t z)
     {
       ak = -(z * z) / (4.0 * k * (n + k));
       Rk = ak * Rk;
-      if (fabs (real (Rk)) < fabs (real (R) * std::numeric_limits<nr_double_t>::epsilon()) &&
-	  fabs (imag (Rk)) < fabs (imag (R) * std::numeric_limits<nr_double_t>::epsilon()))
+      if (abs (Rk) < abs (R) * std::numeric_limits<nr_double_t>::epsilon())
 	return R;
 
       R += Rk;
@@ -209,76 +208,63 @@ cbesselj_mediumarg (unsigned int n, nr_complex_t z)
 
 
 
-/*! \brief num of P(k) (n = 8) will overlow above this value */
+/*! \brief maximum number of terms of the asymptotic series */
 #define MAX_LARGE_ITERATION 430
 
 /*!\brief besselj for large argument
 
-    Based on [5] eq (5)
+    Hankel's asymptotic expansion, cf. [2] 9.2.5 to 9.2.10:
+    \{align}
+    J_n(z)&=\sqrt{\frac{2}{\pi z}}\left(P\cos\chi - Q\sin\chi\right) &
+    \chi&=z-\left(\frac{n}{2}+\frac{1}{4}\right)\pi
+    \}
+    The series are summed until their terms become negligible or
+    start to grow again.
 */
 static nr_complex_t
 cbesselj_largearg (unsigned int n, nr_complex_t z)
 {
-  nr_complex_t Pk, P0, P, Qk, Q0, Q_;
-  nr_complex_t tmp;
-  unsigned long num, denum;
-  nr_complex_t m1a8z2;
+  nr_complex_t P, Pk, Q, Qk, r;
+  nr_double_t mu = 4.0 * n * n;
+  nr_double_t eps = std::numeric_limits<nr_double_t>::epsilon();
+  nr_double_t last;
   unsigned int k;
-  nr_double_t l, m;
-
-  /* P0 & Q0 */
-  P0 = 1;
-  P = P0;
-  Pk = P0;
-
-  Q0 = (4.0 * n * n - 1) / (8.0 * z);
-  Q_ = Q0;
-  Qk = Q0;
 
-  m1a8z2 = (-1.0) / (8.0 * sqr (z));
+  /* 1 / (8z)^2 */
+  r = 1.0 / sqr (8.0 * z);
 
   /* P */
-  for (k = 1;; k++)
+  P = Pk = 1.0;
+  last = abs (Pk);
+  for (k = 1; k <= MAX_LARGE_ITERATION; k++)
     {
-      /* Usually converge before overflow */
-      assert (k <= MAX_LARGE_ITERATION);
-
-      num = (4 * sqr (n) - sqr (4 * k - 3)) * (4 * sqr (n) - (4 * k - 1));
-      denum = 2 * k * (2 * k - 1);
-      Pk = Pk * ((nr_double_t) num * m1a8z2) / ((nr_double_t) denum);
-
-      if (real (Pk) < real (P0) * std::numeric_limits<nr_double_t>::epsilon() &&
-	  imag (Pk) < imag (P0) * std::numeric_limits<nr_double_t>::epsilon())
+      Pk *= -(mu - sqr (4.0 * k - 3)) * (mu - sqr (4.0 * k - 1)) * r /
+	((2.0 * k - 1) * (2.0 * k));
+      if (abs (Pk) > last)
 	break;
-
       P += Pk;
+      last = abs (Pk);
+      if (last <= abs (P) * eps)
+	break;
     }
 
-  /* P */
-  for (k = 1;; k++)
+  /* Q */
+  Q = Qk = (mu - 1) / (8.0 * z);
+  last = abs (Qk);
+  for (k = 1; k <= MAX_LARGE_ITERATION && last > 0; k++)
     {
-      /* Usually converge before overflow */
-      assert (k <= MAX_LARGE_ITERATION);
-
-      num = (4 * sqr (n) - sqr (4 * k - 1)) * (4 * sqr (n) - (4 * k - 1));
-      denum = 2 * k * (2 * k - 1);
-      Qk = Qk * ((nr_double_t) num * m1a8z2) / ((nr_double_t) denum);
-
-      if (real (Qk) < real (Q0) * std::numeric_limits<nr_double_t>::epsilon() ||
-	  imag (Qk) < imag (Q0) * std::numeric_limits<nr_double_t>::epsilon())
+      Qk *= -(mu - sqr (4.0 * k - 1)) * (mu - sqr (4.0 * k + 1)) * r /
+	((2.0 * k) * (2.0 * k + 1));
+      if (abs (Qk) > last)
+	break;
+      Q += Qk;
+      last = abs (Qk);
+      if (last <= abs (Q) * eps)
 	break;
-
-      Q_ += Qk;
     }
 
-  /* l, m cf [5] eq (5) */
-  l = (n % 4 == 0) || (n % 4 == 3) ? 1.0 : -1.0;
-  m = (n % 4 == 0) || (n % 4 == 1) ? 1.0 : -1.0;
-
-
-  tmp = (l * P + m * Q_) * cos (z);
-  tmp += (m * P - l * Q_) * sin (z);
-  return tmp / sqrt (M_PI * z);
+  nr_complex_t chi = z - (0.5 * n + 0.25) * M_PI;
+  return sqrt (2.0 / (M_PI * z)) * (P * cos (chi) - Q * sin (chi));
 }
 
 /*!\brief Main entry point for besselj function
@@ -307,3 +293,83 @@ cbesselj (unsigned int n, nr_complex_t z)
 
   return mul * ret;
 }
+
+/*!\brief besselj for medium argument with tabulated sines
+
+   Same as cbesselj_mediumarg(), but the sines of the angles and the
+   factors of the order are taken from the given tables of size m.
+*/
+static nr_complex_t
+cbesselj_mediumarg_table (unsigned int n, nr_complex_t z, unsigned int m,
+			  const nr_double_t * st, const nr_double_t * nt)
+{
+  nr_complex_t first, second = 0.0;
+  unsigned int k;
+
+  if (n % 2 == 0)
+    {
+      nr_double_t m1pna2 = (n / 2) % 2 == 0 ? 1.0 : -1.0;
+      first = (1.0 + m1pna2 * cos (z)) / (2.0 * m);
+      for (k = 1; k <= m - 1; k++)
+	second += cos (z * st[k]) * nt[k];
+    }
+  else
+    {
+      nr_double_t m1pn1a2 = ((n - 1) / 2) % 2 == 0 ? 1.0 : -1.0;
+      first = (m1pn1a2 * sin (z)) / (2.0 * m);
+      for (k = 1; k <= m - 1; k++)
+	second += sin (z * st[k]) * nt[k];
+    }
+  return first + second / (nr_double_t) m;
+}
+
+/*!\brief Batch entry point for besselj function
+
+   Computes the Bessel functions of the given order for all given
+   arguments.  Repeated arguments are computed once and the angle
+   tables of the medium argument range are shared between arguments
+   of similar magnitude.  The result may overwrite the arguments.
+*/
+void
+cbesselj (unsigned int n, const nr_complex_t * z, nr_complex_t * res,
+	  int len)
+{
+  std::vector<nr_double_t> st, nt;
+  unsigned int tm = 0;
+  nr_complex_t last, val;
+
+  for (int i = 0; i < len; i++)
+    {
+      nr_complex_t x = z[i];
+      if (i > 0 && x == last)
+	{
+	  res[i] = val;
+	  continue;
+	}
+      last = x;
+      nr_double_t a = abs (x);
+      if (a < SMALL_JN_BOUND)
+	val = cbesselj_smallarg (n, x);
+      else if (a > BIG_JN_BOUND)
+	val = cbesselj_largearg (n, x);
+      else
+	{
+	  unsigned int m = (2 * a + 0.25 * (n + std::abs (imag (x))));
+	  if (m != tm)
+	    {
+	      // tabulate the angles for this number of terms
+	      tm = m;
+	      st.resize (m);
+	      nt.resize (m);
+	      for (unsigned int k = 1; k < m; k++)
+		{
+		  nr_double_t t = (k * M_PI) / (2 * m);
+		  st[k] = std::sin (t);
+		  nt[k] = n % 2 == 0 ? std::cos (n * t) : std::sin (n * t);
+		}
+	    }
+	  val = cbesselj_mediumarg_table (n, x, m, st.data (), nt.data ());
+	}
+      res[i] = val;
+    }
+}
@@ -36,6 +36,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <vector>
 
 #include "constants.h"
 #include "precision.h"
@@ -716,6 +717,7 @@ nr_complex_t step (const nr_complex_t z)
 /* FIXME : what about libm jn, yn, isn't that enough? */
 
 nr_complex_t cbesselj (unsigned int, nr_complex_t);
+void cbesselj (unsigned int, const nr_complex_t *, nr_complex_t *, int);
 
 #include "cbesselj.cpp"
 
@@ -731,6 +733,18 @@ nr_complex_t jn (const int n, const nr_complex_t z)
     return cbesselj (n, z);
 }
 
+/*!\brief Bessel function of first kind for many arguments
+
+   \param[in] n order
+   \param[in] z arguments
+   \param[out] res results, may be the same as z
+   \param[in] len number of arguments
+*/
+void jn (const int n, const nr_complex_t * z, nr_complex_t * res, int len)
+{
+    cbesselj (n, z, res, len);
+}
+
 
 /*!\brief Bessel function of second kind
 
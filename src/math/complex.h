@@ -131,6 +131,7 @@ nr_complex_t step (const nr_complex_t);
 
 // bessel functions
 nr_complex_t      jn (const int, const nr_complex_t);
+void              jn (const int, const nr_complex_t *, nr_complex_t *, int);
 nr_complex_t      yn (const int, const nr_complex_t);
 nr_complex_t      i0 (const nr_complex_t);
 
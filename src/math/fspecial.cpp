@@ -31,6 +31,7 @@
 #include <string.h>
 #include <cmath>
 #include <float.h>
+#include <stdint.h>
 #include <algorithm>
 
 #include "compat.h"
@@ -92,6 +93,60 @@ void fspecial::ellip_ke (nr_double_t arg, nr_double_t &k, nr_double_t &e) {
   }
 }
 
+/* The function computes the complete elliptic integral of first kind
+   K(k) using the arithmetic-geometric mean algorithm (AGM) found e.g.
+   in Abramowitz and Stegun (17.6.1).  Note that the argument of the
+   function is the elliptic modulus k and not the parameter m = k^2. */
+nr_double_t fspecial::ellipk (nr_double_t k) {
+  if ((k < 0.0) || (k >= 1.0))
+    // we use only the range from 0 <= k < 1
+    return std::numeric_limits<nr_double_t>::quiet_NaN();
+
+  nr_double_t a = 1.0;
+  nr_double_t b = sqrt (1 - k * k);
+  nr_double_t c = k;
+
+  while (c > std::numeric_limits<nr_double_t>::epsilon()) {
+    nr_double_t t = (a + b) / 2;
+    c = (a - b) / 2;
+    b = sqrt (a * b);
+    a = t;
+  }
+  return pi_over_2 / a;
+}
+
+// Size of the K(k)/K'(k) cache, must be a power of two.
+#define KKP_CACHE 64
+
+/* The function returns the ratio K(k)/K'(k) of complete elliptic
+   integrals with K'(k) = K(sqrt(1-k^2)).  The ratio only depends on
+   the geometry of coplanar structures and is requested over and over
+   again for the same arguments during frequency sweeps, thus the
+   recent results are kept in a small per-thread cache. */
+nr_double_t fspecial::KoverKp (nr_double_t k) {
+  static thread_local struct {
+    nr_double_t k, r;
+    bool valid;
+  } cache[KKP_CACHE];
+
+  if ((k < 0.0) || (k >= 1.0))
+    return std::numeric_limits<nr_double_t>::quiet_NaN();
+
+  uint64_t bits;
+  memcpy (&bits, &k, sizeof (bits));
+  bits ^= bits >> 29;
+  bits *= UINT64_C (0x9e3779b97f4a7c15);
+  int slot = (int) (bits >> 58) & (KKP_CACHE - 1);
+  if (cache[slot].valid && cache[slot].k == k)
+    return cache[slot].r;
+
+  nr_double_t r = ellipk (k) / ellipk (sqrt (1 - k * k));
+  cache[slot].k = k;
+  cache[slot].r = r;
+  cache[slot].valid = true;
+  return r;
+}
+
 const nr_double_t SN_ACC = 1e-5;	// Accuracy of sn(x) is SN_ACC^2
 const nr_double_t K_ERR  = 1e-8;	// Accuracy of K(k)
 
@@ -43,6 +43,10 @@ namespace fspecial {
   nr_double_t ellip_sncndn (nr_double_t, nr_double_t,
 			    nr_double_t&, nr_double_t&, nr_double_t&);
 
+  // complete elliptic integral of first kind by modulus and K(k)/K'(k)
+  nr_double_t ellipk (nr_double_t);
+  nr_double_t KoverKp (nr_double_t);
+
 } // namespace
 
 #endif /* __FSPECIAL_H__ */
@@ -90,6 +90,7 @@
 #include <cstdlib>
 #include <string.h>
 #include <cmath>
+#include <algorithm>
 
 #include "logging.h"
 #include "object.h"
@@ -154,6 +155,19 @@ matrix::matrix (const matrix & m) {
   }
 }
 
+/*!\brief move constructor
+
+   The move constructor takes over the elements of the given matrix
+   object which is left empty.
+*/
+matrix::matrix (matrix && m) {
+  rows = m.rows;
+  cols = m.cols;
+  data = m.data;
+  m.rows = m.cols = 0;
+  m.data = NULL;
+}
+
 /*!\brief Assignment operator
 
   The assignment copy constructor creates a new instance based on the
@@ -179,6 +193,23 @@ const matrix& matrix::operator=(const matrix & m) {
   return *this;
 }
 
+/*!\brief Move assignment operator
+
+  Exchanges the elements of both matrices, the old elements get
+  deleted along with the moved-from object.
+
+  \param[in] m object to move from
+  \return assigned object
+*/
+const matrix& matrix::operator=(matrix && m) {
+  if (&m != this) {
+    std::swap (rows, m.rows);
+    std::swap (cols, m.cols);
+    std::swap (data, m.data);
+  }
+  return *this;
+}
+
 /*!\brief Destructor
 
    Destructor deletes a matrix object.
@@ -739,8 +770,9 @@ nr_complex_t detGauss (matrix a) {
 	pivot = r;
       }
     }
+    // a singular matrix has got a zero determinant
+    if (MaxPivot == 0) return 0;
     // exchange rows if necessary
-    assert (MaxPivot != 0);
     if (i != pivot) { b.exchangeRows (i, pivot); res = -res; }
     // compute new rows and columns
     for (r = i + 1; r < n; r++) {
@@ -100,7 +100,9 @@ class matrix
   matrix (int);
   matrix (int, int);
   matrix (const matrix &);
+  matrix (matrix &&);
   const matrix& operator = (const matrix &);
+  const matrix& operator = (matrix &&);
   ~matrix ();
   nr_complex_t get (int, int);
   void set (int, int, nr_complex_t);
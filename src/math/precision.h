@@ -45,6 +45,8 @@
 #define NR_TINY 1e-15
 #endif
 
+/* largest representable value, e.g. for "no such point in time" */
+#define NR_MAX std::numeric_limits<nr_double_t>::max ()
 
 
 #endif /* __PRECISION_H__ */
@@ -36,6 +36,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <cmath>
+#include <algorithm>
 
 #include "logging.h"
 #include "object.h"
@@ -102,6 +103,22 @@ matvec::matvec (const matvec & m) {
   }
 }
 
+/*!\brief move constructor
+
+   The move constructor takes over the matrices of the given matvec
+   object which is left empty.
+*/
+matvec::matvec (matvec && m) {
+  size = m.size;
+  rows = m.rows;
+  cols = m.cols;
+  name = m.name;
+  data = m.data;
+  m.size = m.rows = m.cols = 0;
+  m.name = NULL;
+  m.data = NULL;
+}
+
 /*!\brief Destructor
 
    Destructor deletes a matvec object.
@@ -615,12 +632,152 @@ matvec stos (matvec s, nr_complex_t zref, qucs::vector z0) {
   return stos (s, qucs::vector (z0.getSize (), zref), z0);
 }
 
+/* The following kernels implement the batched network parameter
+   conversions of matrix vectors.  Each of them computes
+
+     D^-1 * A^-1 * B * D  or  D * B * A^-1 * D^-1
+
+   for every frequency slice, where D = diag (sqrt (real (1 / z0)))
+   and A, B are built directly from the slice.  The slices are
+   processed in place using a single scratch area for the whole sweep
+   instead of creating temporary matrices per frequency. */
+enum matvec_conversion_t {
+  CONV_STOY = 0,
+  CONV_STOZ,
+  CONV_ZTOS,
+  CONV_YTOS,
+  CONV_ZTOY,
+  CONV_YTOZ
+};
+
+/* Solves the n x n system a * x = b in place, i.e. the matrix b gets
+   replaced by a^-1 * b and a is destroyed.  Both are stored row by
+   row.  The 2x2 case is handled in closed form. */
+static void matvec_solve (int n, nr_complex_t * a, nr_complex_t * b) {
+  if (n == 1) {
+    b[0] /= a[0];
+    return;
+  }
+  if (n == 2) {
+    nr_complex_t d = a[0] * a[3] - a[1] * a[2];
+    nr_complex_t b0 = b[0], b1 = b[1];
+    b[0] = (a[3] * b0 - a[1] * b[2]) / d;
+    b[1] = (a[3] * b1 - a[1] * b[3]) / d;
+    b[2] = (a[0] * b[2] - a[2] * b0) / d;
+    b[3] = (a[0] * b[3] - a[2] * b1) / d;
+    return;
+  }
+
+  // Gauss-Jordan elimination with partial pivoting
+  for (int i = 0; i < n; i++) {
+    int pivot = i;
+    nr_double_t MaxPivot = 0;
+    for (int r = i; r < n; r++) {
+      nr_double_t v = norm (a[r * n + i]);
+      if (v > MaxPivot) { MaxPivot = v; pivot = r; }
+    }
+    // singular matrix
+    assert (MaxPivot != 0);
+    if (pivot != i) {
+      for (int c = 0; c < n; c++) {
+	std::swap (a[i * n + c], a[pivot * n + c]);
+	std::swap (b[i * n + c], b[pivot * n + c]);
+      }
+    }
+    nr_complex_t f = 1.0 / a[i * n + i];
+    for (int c = i; c < n; c++) a[i * n + c] *= f;
+    for (int c = 0; c < n; c++) b[i * n + c] *= f;
+    for (int r = 0; r < n; r++) {
+      if (r == i) continue;
+      nr_complex_t e = a[r * n + i];
+      if (e == 0.0) continue;
+      for (int c = i; c < n; c++) a[r * n + c] -= e * a[i * n + c];
+      for (int c = 0; c < n; c++) b[r * n + c] -= e * b[i * n + c];
+    }
+  }
+}
+
+/* Runs the given conversion on each matrix of the matrix vector.  The
+   reference impedances are not used for the Y <-> Z conversions. */
+static void matvec_convert (matrix * data, int size, int n,
+			    qucs::vector * z0, int type) {
+  nr_complex_t * a = new nr_complex_t[2 * n * n];
+  nr_complex_t * b = a + n * n;
+  nr_complex_t * z = new nr_complex_t[2 * n];
+  nr_complex_t * g = z + n;
+
+  for (int i = 0; i < n; i++) {
+    z[i] = z0 ? z0->get (i) : 1.0;
+    g[i] = z0 ? sqrt (nr_complex_t (real (1.0 / z[i]))) : 1.0;
+  }
+
+  for (int f = 0; f < size; f++) {
+    nr_complex_t * m = data[f].getData ();
+    int r, c, k;
+
+    // setup A and B (transposed for the right-hand side divisions)
+    for (k = r = 0; r < n; r++) {
+      for (c = 0; c < n; c++, k++) {
+	nr_complex_t v = m[k], e = (r == c) ? 1.0 : 0.0;
+	int t = c * n + r;
+	switch (type) {
+	case CONV_STOY: // (S * Zref + Zref)^-1 * (E - S)
+	  a[k] = (v + e) * z[c];
+	  b[k] = e - v;
+	  break;
+	case CONV_STOZ: // (E - S)^-1 * (S * Zref + Zref)
+	  a[k] = e - v;
+	  b[k] = (v + e) * z[c];
+	  break;
+	case CONV_ZTOS: // (Z - Zref) * (Z + Zref)^-1
+	  a[t] = v + e * z[r];
+	  b[t] = v - e * z[r];
+	  break;
+	case CONV_YTOS: // (E - Zref * Y) * (E + Zref * Y)^-1
+	  a[t] = e + z[r] * v;
+	  b[t] = e - z[r] * v;
+	  break;
+	case CONV_ZTOY: case CONV_YTOZ:
+	  a[k] = v;
+	  b[k] = e;
+	  break;
+	}
+      }
+    }
+
+    matvec_solve (n, a, b);
+
+    // apply reference impedance normalisation and store the result
+    for (k = r = 0; r < n; r++) {
+      for (c = 0; c < n; c++, k++) {
+	switch (type) {
+	case CONV_STOY: case CONV_STOZ:
+	  m[k] = b[k] * g[c] / g[r];
+	  break;
+	case CONV_ZTOS: case CONV_YTOS:
+	  m[k] = b[c * n + r] * g[r] / g[c];
+	  break;
+	default:
+	  m[k] = b[k];
+	  break;
+	}
+      }
+    }
+  }
+
+  delete[] z;
+  delete[] a;
+}
+
+/* The batched conversions work on the matrix vector passed by value
+   and return it without its name, as if it was a new object. */
+
 // Convert scattering parameters to admittance matrix vector.
 matvec stoy (matvec s, qucs::vector z0) {
   assert (s.getCols () == s.getRows () && s.getCols () == z0.getSize ());
-  matvec res (s.getSize (), s.getCols (), s.getRows ());
-  for (int i = 0; i < s.getSize (); i++) res.set (stoy (s.get (i), z0), i);
-  return res;
+  matvec_convert (s.data, s.getSize (), s.getCols (), &z0, CONV_STOY);
+  s.setName (NULL);
+  return s;
 }
 
 matvec stoy (matvec s, nr_complex_t z0) {
@@ -630,9 +787,9 @@ matvec stoy (matvec s, nr_complex_t z0) {
 // Convert admittance matrix to scattering parameter matrix vector.
 matvec ytos (matvec y, qucs::vector z0) {
   assert (y.getCols () == y.getRows () && y.getCols () == z0.getSize ());
-  matvec res (y.getSize (), y.getCols (), y.getRows ());
-  for (int i = 0; i < y.getSize (); i++) res.set (ytos (y.get (i), z0), i);
-  return res;
+  matvec_convert (y.data, y.getSize (), y.getCols (), &z0, CONV_YTOS);
+  y.setName (NULL);
+  return y;
 }
 
 matvec ytos (matvec y, nr_complex_t z0) {
@@ -642,9 +799,9 @@ matvec ytos (matvec y, nr_complex_t z0) {
 // Convert scattering parameters to impedance matrix vector.
 matvec stoz (matvec s, qucs::vector z0) {
   assert (s.getCols () == s.getRows () && s.getCols () == z0.getSize ());
-  matvec res (s.getSize (), s.getCols (), s.getRows ());
-  for (int i = 0; i < s.getSize (); i++) res.set (stoz (s.get (i), z0), i);
-  return res;
+  matvec_convert (s.data, s.getSize (), s.getCols (), &z0, CONV_STOZ);
+  s.setName (NULL);
+  return s;
 }
 
 matvec stoz (matvec s, nr_complex_t z0) {
@@ -654,9 +811,9 @@ matvec stoz (matvec s, nr_complex_t z0) {
 // Convert impedance matrix vector scattering parameter matrix vector.
 matvec ztos (matvec z, qucs::vector z0) {
   assert (z.getCols () == z.getRows () && z.getCols () == z0.getSize ());
-  matvec res (z.getSize (), z.getCols (), z.getRows ());
-  for (int i = 0; i < z.getSize (); i++) res.set (ztos (z.get (i), z0), i);
-  return res;
+  matvec_convert (z.data, z.getSize (), z.getCols (), &z0, CONV_ZTOS);
+  z.setName (NULL);
+  return z;
 }
 
 matvec ztos (matvec z, nr_complex_t z0) {
@@ -666,17 +823,17 @@ matvec ztos (matvec z, nr_complex_t z0) {
 // Convert impedance matrix vector to admittance matrix vector.
 matvec ztoy (matvec z) {
   assert (z.getCols () == z.getRows ());
-  matvec res (z.getSize (), z.getCols (), z.getRows ());
-  for (int i = 0; i < z.getSize (); i++) res.set (ztoy (z.get (i)), i);
-  return res;
+  matvec_convert (z.data, z.getSize (), z.getCols (), NULL, CONV_ZTOY);
+  z.setName (NULL);
+  return z;
 }
 
 // Convert admittance matrix vector to impedance matrix vector.
 matvec ytoz (matvec y) {
   assert (y.getCols () == y.getRows ());
-  matvec res (y.getSize (), y.getCols (), y.getRows ());
-  for (int i = 0; i < y.getSize (); i++) res.set (ytoz (y.get (i)), i);
-  return res;
+  matvec_convert (y.data, y.getSize (), y.getCols (), NULL, CONV_YTOZ);
+  y.setName (NULL);
+  return y;
 }
 
 /* This function converts 2x2 matrix vectors from any of the matrix
@@ -686,7 +843,7 @@ matvec twoport (matvec m, char in, char out) {
   assert (m.getCols () >= 2 && m.getRows () >= 2);
   matvec res (m.getSize (), 2, 2);
   for (int i = 0; i < m.getSize (); i++)
-    res.set (twoport (m.get (i), in, out), i);
+    res.data[i] = twoport (m.data[i], in, out);
   return res;
 }
 
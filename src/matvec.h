@@ -76,6 +76,7 @@ class matvec
   matvec ();
   matvec (int, int, int);
   matvec (const matvec &);
+  matvec (matvec &&);
   ~matvec ();
   int getSize (void) { return size; }
   int getCols (void) { return cols; }
@@ -311,7 +311,9 @@ void module::registerModules (void) {
   REGISTER_ANALYSIS (spsolver);
   REGISTER_ANALYSIS (trsolver);
   REGISTER_ANALYSIS (hbsolver);
+  REGISTER_ANALYSIS (psssolver);
   REGISTER_ANALYSIS (parasweep);
+  REGISTER_ANALYSIS (montecarlo);
   REGISTER_ANALYSIS (e_trsolver);
 }
 
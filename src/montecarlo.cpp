@@ -0,0 +1,423 @@
+/*
+ * montecarlo.cpp - Monte-Carlo and corner analysis class implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#ifndef __MINGW32__
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "logging.h"
+#include "complex.h"
+#include "object.h"
+#include "vector.h"
+#include "dataset.h"
+#include "net.h"
+#include "netdefs.h"
+#include "ptrlist.h"
+#include "strlist.h"
+#include "analysis.h"
+#include "environment.h"
+#include "sampler.h"
+#include "montecarlo.h"
+#include "profile.h"
+
+// Name of the sample dependency.
+#define SAMPLE "sample"
+
+namespace qucs {
+
+// Constructor creates an unnamed instance of the montecarlo class.
+montecarlo::montecarlo () : analysis () {
+  samples = corners = 0;
+  seed = 0;
+  type = ANALYSIS_SWEEP;
+}
+
+// Constructor creates a named instance of the montecarlo class.
+montecarlo::montecarlo (char * n) : analysis (n) {
+  samples = corners = 0;
+  seed = 0;
+  type = ANALYSIS_SWEEP;
+}
+
+// Destructor deletes the montecarlo class object.
+montecarlo::~montecarlo () {
+}
+
+/* The copy constructor creates a new instance of the montecarlo class
+   based on the given montecarlo object. */
+montecarlo::montecarlo (montecarlo & m) : analysis (m) {
+  samples = m.samples;
+  corners = m.corners;
+  seed = m.seed;
+}
+
+/* Initializes the Monte-Carlo analysis.  For a corner run the number
+   of statistical parameters is obtained by a nominal equation solver
+   run. */
+int montecarlo::initialize (void) {
+  samples = getPropertyInteger ("Samples");
+  seed = (unsigned long) getPropertyInteger ("Seed");
+  corners = !strcmp (getPropertyString ("Type"), "corner");
+
+  if (corners) {
+    sampler::nominal ();
+    env->runSolver ();
+    int k = sampler::getDraws ();
+    if (k > 16) {
+      logprint (LOG_ERROR, "ERROR: %s: %d statistical parameters give too "
+		"many corners\n", getName (), k);
+      return -1;
+    }
+    samples = 1 << k;
+  }
+
+  // also run initialize functionality for all children
+  if (actions != nullptr) {
+    for (auto *a : *actions) {
+      a->initialize ();
+      a->setProgress (false);
+    }
+  }
+  return 0;
+}
+
+/* Cleans the Monte-Carlo analysis up. */
+int montecarlo::cleanup (void) {
+  sampler::nominal ();
+  if (actions != nullptr)
+    for (auto *a : *actions)
+      a->cleanup ();
+  return 0;
+}
+
+/* The function runs the child analyses for the given range of
+   samples. */
+int montecarlo::runSamples (int from, int to, bool bar) {
+  int err = 0;
+  for (int s = from; s < to; s++) {
+    // display progress bar if requested
+    if (bar) logprogressbar (s - from, to - from, 40);
+    // draw the parameters of this sample, then run solver
+    if (corners)
+      sampler::corner (s);
+    else
+      sampler::random (seed, s);
+    {
+      profile_timer t (PROFILE_EQUATIONS);
+      env->runSolver ();
+    }
+#if DEBUG
+    logprint (LOG_STATUS, "NOTIFY: %s: running netlist for sample %d\n",
+	      getName (), s);
+#endif
+    for (auto *a : *actions) {
+      profile_scope scope (a->getName ());
+      err |= a->solve ();
+      // assign sample dependency to last order analyses
+      ptrlist<analysis> * lastorder = subnet->findLastOrderChildren (this);
+      for (auto *dep : *lastorder)
+	data->assignDependency (dep->getName (), SAMPLE);
+    }
+  }
+  // clear progress bar
+  if (bar) logprogressclear (40);
+  return err;
+}
+
+#ifndef __MINGW32__
+// Writes the given number of bytes into the pipe.
+static int writePipe (int fd, const void * buf, size_t n) {
+  const char * p = (const char *) buf;
+  while (n > 0) {
+    ssize_t w = write (fd, p, n);
+    if (w < 0 && errno == EINTR) continue;
+    if (w <= 0) return -1;
+    p += w;
+    n -= w;
+  }
+  return 0;
+}
+
+// Reads the given number of bytes from the pipe.
+static int readPipe (int fd, void * buf, size_t n) {
+  char * p = (char *) buf;
+  while (n > 0) {
+    ssize_t r = read (fd, p, n);
+    if (r < 0 && errno == EINTR) continue;
+    if (r <= 0) return -1;
+    p += r;
+    n -= r;
+  }
+  return 0;
+}
+#endif
+
+/* A worker process sends its error code and the values each sample
+   dependent result gained since the start of the run through the
+   given pipe. */
+int montecarlo::sendResults (int fd, int err,
+			     std::map<std::string, int> & start) {
+#ifndef __MINGW32__
+  if (writePipe (fd, &err, sizeof (int))) return -1;
+  for (vector * v = data->getVariables (); v; v = (vector *) v->getNext ()) {
+    strlist * deps = v->getDependencies ();
+    if (deps == NULL || !deps->contains (SAMPLE)) continue;
+    std::map<std::string, int>::iterator it = start.find (v->getName ());
+    int first = it != start.end () ? it->second : 0;
+    int len = strlen (v->getName ()), n = v->getSize () - first;
+    std::vector<nr_double_t> values (2 * n);
+    for (int i = 0; i < n; i++) {
+      nr_complex_t c = v->get (first + i);
+      values[2 * i + 0] = real (c);
+      values[2 * i + 1] = imag (c);
+    }
+    if (writePipe (fd, &len, sizeof (int)) ||
+	writePipe (fd, v->getName (), len) ||
+	writePipe (fd, &n, sizeof (int)) ||
+	writePipe (fd, values.data (), values.size () * sizeof (nr_double_t)))
+      return -1;
+  }
+  int end = 0;
+  return writePipe (fd, &end, sizeof (int));
+#else
+  return -1;
+#endif
+}
+
+/* The function appends the results of a worker process read from the
+   given pipe to the results in the dataset. */
+int montecarlo::receiveResults (int fd) {
+#ifndef __MINGW32__
+  int err, len, n;
+  if (readPipe (fd, &err, sizeof (int))) return -1;
+  while (!readPipe (fd, &len, sizeof (int))) {
+    if (len == 0) return err;
+    std::string name (len, ' ');
+    if (readPipe (fd, &name[0], len) || readPipe (fd, &n, sizeof (int)))
+      break;
+    std::vector<nr_double_t> values (2 * n);
+    if (readPipe (fd, values.data (), values.size () * sizeof (nr_double_t)))
+      break;
+    vector * v = data->findVariable (name);
+    if (v == NULL) {
+      logprint (LOG_ERROR, "WARNING: %s: dropping results of `%s' from "
+		"worker process\n", getName (), name.c_str ());
+      continue;
+    }
+    for (int i = 0; i < n; i++)
+      v->add (nr_complex_t (values[2 * i], values[2 * i + 1]));
+  }
+#endif
+  return -1;
+}
+
+/* This is the Monte-Carlo solver.  The samples are split into as many
+   blocks as worker processes.  The first block is run by the calling
+   process, the others by forked processes which send back their
+   results.  These are appended in block order, thus the results are
+   independent of the number of processes. */
+int montecarlo::solve (void) {
+  int err = 0;
+  runs++;
+
+  // number of worker processes including the calling one
+  int procs = getPropertyInteger ("Threads");
+  if (procs <= 0) procs = (int) std::thread::hardware_concurrency ();
+  if (procs <= 0) procs = 1;
+  if (procs > samples) procs = samples;
+#ifdef __MINGW32__
+  procs = 1;
+#endif
+
+  // sizes of the result vectors before this run
+  std::map<std::string, int> start;
+  for (vector * v = data->getVariables (); v; v = (vector *) v->getNext ())
+    start[v->getName ()] = v->getSize ();
+
+  // fork the worker processes for the blocks but the first
+  std::vector<int> pids (procs, -1), pipes (procs, -1);
+#ifndef __MINGW32__
+  fflush (NULL);
+  for (int p = 1; p < procs; p++) {
+    int fd[2];
+    if (pipe (fd) != 0) break;
+    pid_t pid = fork ();
+    if (pid == 0) {
+      close (fd[0]);
+      for (int q = 1; q < p; q++) close (pipes[q]);
+      int e = runSamples (samples * p / procs, samples * (p + 1) / procs,
+			  false);
+      fflush (NULL);
+      _exit (sendResults (fd[1], e != 0, start) ? 1 : 0);
+    }
+    close (fd[1]);
+    if (pid < 0) {
+      close (fd[0]);
+      break;
+    }
+    pids[p] = pid;
+    pipes[p] = fd[0];
+  }
+#endif
+
+  // run the own block, then collect the others in order
+  err |= runSamples (0, samples / procs, progress);
+  for (int p = 1; p < procs; p++) {
+    int from = samples * p / procs, to = samples * (p + 1) / procs;
+    if (pids[p] < 0) {
+      // no worker process, run the block here
+      err |= runSamples (from, to, false);
+      continue;
+    }
+#ifndef __MINGW32__
+    int e = receiveResults (pipes[p]);
+    close (pipes[p]);
+    int status;
+    waitpid (pids[p], &status, 0);
+    if (e < 0) {
+      logprint (LOG_ERROR, "ERROR: %s: worker process for samples %d to %d "
+		"failed\n", getName (), from, to - 1);
+      err++;
+    }
+    else err |= e;
+#endif
+  }
+  sampler::nominal ();
+
+#if DEBUG
+  logprint (LOG_STATUS, "NOTIFY: %s: %d samples run by %d process%s\n",
+	    getName (), samples, procs, procs > 1 ? "es" : "");
+#endif
+
+  // save results (sample numbers) and the statistics
+  if (runs == 1) saveResults ();
+  saveStatistics ();
+  return err;
+}
+
+/* This function saves the sample numbers into the output dataset. */
+void montecarlo::saveResults (void) {
+  vector * v;
+  if ((v = data->findDependency (SAMPLE)) == NULL) {
+    v = new vector (SAMPLE);
+    v->setOrigin (getName ());
+    data->addDependency (v);
+  }
+  for (int s = 0; s < samples; s++) v->add (s);
+}
+
+/* The function saves the mean value and standard deviation over the
+   samples of each sample dependent result of the current run. */
+void montecarlo::saveStatistics (void) {
+  std::vector<vector *> results;
+  for (vector * v = data->getVariables (); v; v = (vector *) v->getNext ()) {
+    strlist * deps = v->getDependencies ();
+    if (deps != NULL && deps->contains (SAMPLE)) results.push_back (v);
+  }
+
+  for (vector * v : results) {
+    // number of points per sample, the dependencies varying faster
+    strlist * deps = v->getDependencies ();
+    strlist * rest = new strlist ();
+    int points = 1, inner = 1;
+    for (int i = 0; i < deps->length (); i++) {
+      char * d = deps->get (i);
+      if (!strcmp (d, SAMPLE)) {
+	inner = 0;
+	continue;
+      }
+      rest->append (d);
+      if (inner) {
+	vector * dv = data->findDependency (d);
+	if (dv == NULL) dv = data->findVariable (d);
+	points *= dv ? dv->getSize () : 0;
+      }
+    }
+    int n = points * samples;
+    if (n == 0 || v->getSize () < n) {
+      delete rest;
+      continue;
+    }
+
+    // the statistics have the same dependencies but the samples
+    std::string name = v->getName ();
+    vector * mv = data->findVariable (name + ".mean");
+    vector * sv = data->findVariable (name + ".stddev");
+    if (mv == NULL) {
+      mv = new vector (name + ".mean");
+      mv->setOrigin (getName ());
+      data->addVariable (mv);
+    }
+    if (sv == NULL) {
+      sv = new vector (name + ".stddev");
+      sv->setOrigin (getName ());
+      data->addVariable (sv);
+    }
+    mv->setDependencies (new strlist (*rest));
+    sv->setDependencies (rest);
+
+    // running mean and variance (Welford) over the samples
+    int first = v->getSize () - n;
+    for (int i = 0; i < points; i++) {
+      nr_complex_t mean = 0;
+      nr_double_t m2 = 0;
+      for (int s = 0; s < samples; s++) {
+	nr_complex_t x = v->get (first + s * points + i);
+	nr_complex_t d = x - mean;
+	mean += d / (nr_double_t) (s + 1);
+	m2 += real (d * conj (x - mean));
+      }
+      mv->add (mean);
+      sv->add (samples > 1 ? std::sqrt (m2 / (samples - 1)) : 0.0);
+    }
+  }
+}
+
+// properties
+PROP_REQ [] = {
+  { "Sim", PROP_STR, { PROP_NO_VAL, "DC1" }, PROP_NO_RANGE },
+  PROP_NO_PROP };
+PROP_OPT [] = {
+  { "Type", PROP_STR, { PROP_NO_VAL, "random" },
+    PROP_RNG_STR2 ("random", "corner") },
+  { "Samples", PROP_INT, { 100, PROP_NO_STR }, PROP_MIN_VAL (1) },
+  { "Seed", PROP_INT, { 1, PROP_NO_STR }, PROP_MIN_VAL (0) },
+  { "Threads", PROP_INT, { 0, PROP_NO_STR }, PROP_RNGII (0, 256) },
+  PROP_NO_PROP };
+struct define_t montecarlo::anadef =
+  { "MC", 0, PROP_ACTION, PROP_NO_SUBSTRATE, PROP_LINEAR, PROP_DEF };
+
+} // namespace qucs
@@ -0,0 +1,72 @@
+/*
+ * montecarlo.h - Monte-Carlo and corner analysis class definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __MONTECARLO_H__
+#define __MONTECARLO_H__
+
+#include <map>
+#include <string>
+
+namespace qucs {
+
+class analysis;
+
+/*!\brief Monte-Carlo and corner analysis
+
+   The analysis runs its child analysis for a number of samples of the
+   statistical circuit parameters, i.e. the equations using gauss(),
+   uniform() or lognormal() which in turn may be referred to by any
+   component or model property.  Each sample draws from its own random
+   stream given by the seed and the sample number.  In a corner run the
+   samples are all combinations of the parameter limits.  The samples
+   are split into blocks run by forked worker processes, their results
+   are sent back through pipes and merged in sample order.  The results
+   depend on the 'sample' dependency, additionally the mean and the
+   standard deviation over the samples are saved.
+*/
+class montecarlo : public analysis
+{
+ public:
+  ACREATOR (montecarlo);
+  montecarlo (char *);
+  montecarlo (montecarlo &);
+  ~montecarlo ();
+  int  initialize (void);
+  int  solve (void);
+  int  cleanup (void);
+  void saveResults (void);
+
+ private:
+  int  runSamples (int, int, bool);
+  int  sendResults (int, int, std::map<std::string, int> &);
+  int  receiveResults (int);
+  void saveStatistics (void);
+
+ private:
+  int samples;
+  int corners;
+  unsigned long seed;
+};
+
+} // namespace qucs
+
+#endif /* __MONTECARLO_H__ */
@@ -36,6 +36,7 @@
 #include <float.h>
 #include <assert.h>
 #include <limits>
+#include <algorithm>
 
 #include "logging.h"
 #include "complex.h"
@@ -70,11 +71,18 @@ nasolver<nr_type_t>::nasolver () : analysis ()
     z = x = xprev = zprev = NULL;
     reltol = abstol = vntol = 0;
     calculate_func = NULL;
+    stamp_func = NULL;
     convHelper = fixpoint = 0;
     eqnAlgo = ALGO_LU_DECOMPOSITION;
     updateMatrix = 1;
     gMin = srcFactor = 0;
     eqns = new eqnsys<nr_type_t> ();
+    lowrankUse = lowrankTick = 0;
+    factorized = 0;
+    chord = chordStart = 0;
+    J = NULL;
+    chordStep = chordUpdate = 0;
+    chordIters = 0;
 }
 
 // Constructor creates a named instance of the nasolver class.
@@ -86,11 +94,18 @@ nasolver<nr_type_t>::nasolver (const std::string &n) : analysis (n)
     z = x = xprev = zprev = NULL;
     reltol = abstol = vntol = 0;
     calculate_func = NULL;
+    stamp_func = NULL;
     convHelper = fixpoint = 0;
     eqnAlgo = ALGO_LU_DECOMPOSITION;
     updateMatrix = 1;
     gMin = srcFactor = 0;
     eqns = new eqnsys<nr_type_t> ();
+    lowrankUse = lowrankTick = 0;
+    factorized = 0;
+    chord = chordStart = 0;
+    J = NULL;
+    chordStep = chordUpdate = 0;
+    chordIters = 0;
 }
 
 // Destructor deletes the nasolver class object.
@@ -100,11 +115,13 @@ nasolver<nr_type_t>::~nasolver ()
     delete nlist;
     delete C;
     delete A;
+    delete J;
     delete z;
     delete x;
     delete xprev;
     delete zprev;
     delete eqns;
+    clearLowRank ();
 }
 
 /* The copy constructor creates a new instance of the nasolver class
@@ -123,6 +140,7 @@ nasolver<nr_type_t>::nasolver (nasolver & o) : analysis (o)
     vntol = o.vntol;
     desc = o.desc;
     calculate_func = o.calculate_func;
+    stamp_func = o.stamp_func;
     convHelper = o.convHelper;
     eqnAlgo = o.eqnAlgo;
     updateMatrix = o.updateMatrix;
@@ -130,6 +148,14 @@ nasolver<nr_type_t>::nasolver (nasolver & o) : analysis (o)
     gMin = o.gMin;
     srcFactor = o.srcFactor;
     eqns = new eqnsys<nr_type_t> (*(o.eqns));
+    lowrankUse = o.lowrankUse;
+    lowrankTick = 0;
+    factorized = 0;
+    chord = o.chord;
+    chordStart = o.chordStart;
+    J = NULL;
+    chordStep = chordUpdate = 0;
+    chordIters = 0;
     solution = nasolution<nr_type_t> (o.solution);
 }
 
@@ -219,7 +245,7 @@ void nasolver<nr_type_t>::solve_pre (void)
               getName (), desc.c_str());
 #endif
     nlist = new nodelist (subnet);
-    nlist->assignNodes ();
+    nlist->assignNodes (nodeOrdering ());
     assignVoltageSources ();
 #if DEBUG && 0
     nlist->print ();
@@ -230,16 +256,44 @@ void nasolver<nr_type_t>::solve_pre (void)
     int N = countNodes ();
     delete A;
     A = new tmatrix<nr_type_t> (M + N);
+    factorized = 0;
     delete z;
     z = new tvector<nr_type_t> (N + M);
     delete x;
     x = new tvector<nr_type_t> (N + M);
 
+    /* Switching circuits change a few rows of the matrix only, thus
+       keep factorizations for rank-k updates if there are any. */
+    clearLowRank ();
+    lowrankUse = 0;
+    for (circuit * c = subnet->getRoot (); c != NULL;
+            c = (circuit *) c->getNext ())
+    {
+        if (c->isSwitch ()) lowrankUse = 1;
+    }
+
 #if DEBUG
     logprint (LOG_STATUS, "NOTIFY: %s: solving %s netlist\n", getName (), desc.c_str());
 #endif
 }
 
+/* The function returns the node ordering requested by the 'Ordering'
+   property of the analysis.  Node voltages and branch currents are
+   stored by name, thus the ordering does not affect saved results. */
+template <class nr_type_t>
+int nasolver<nr_type_t>::nodeOrdering (void)
+{
+    const char * const order = getPropertyString ("Ordering");
+    if (order != NULL)
+    {
+        if (!strcmp (order, "RCM"))
+            return NODEORDER_RCM;
+        else if (!strcmp (order, "MinDegree"))
+            return NODEORDER_MINDEGREE;
+    }
+    return NODEORDER_NONE;
+}
+
 /* This function goes through the nodeset list of the current netlist
    and applies the stored values to the current solution vector.  Then
    the function saves the solution vector back into the actual
@@ -460,6 +514,7 @@ int nasolver<nr_type_t>::solve_nonlinear (void)
     abstol = getPropertyDouble ("abstol");
     vntol = getPropertyDouble ("vntol");
     updateMatrix = 1;
+    chordStep = -1;
 
     if (convHelper == CONV_GMinStepping)
     {
@@ -478,6 +533,9 @@ int nasolver<nr_type_t>::solve_nonlinear (void)
         return error;
     }
 
+    // keep the factorization of the previous solution if requested
+    if (chordStart && chordPossible ()) updateMatrix = 0;
+
     // run solving loop until convergence is reached
     do
     {
@@ -486,6 +544,11 @@ int nasolver<nr_type_t>::solve_nonlinear (void)
         {
             // convergence check
             convergence = (run > 0) ? checkConvergence () : 0;
+            // control modified Newton iterations
+            if (chord && !fixpoint)
+            {
+                updateMatrix = !chordControl (run);
+            }
             savePreviousIteration ();
             run++;
             // control fixpoint iterations
@@ -538,6 +601,7 @@ int nasolver<nr_type_t>::solve_linear (void)
 template <class nr_type_t>
 void nasolver<nr_type_t>::createMatrix (void)
 {
+    profile_timer t (PROFILE_ASSEMBLY);
 
     /* Generate the A matrix.  The A matrix consists of four (4) minor
        matrices in the form     +-   -+
@@ -547,11 +611,28 @@ void nasolver<nr_type_t>::createMatrix (void)
        Each of these minor matrices is going to be generated here. */
     if (updateMatrix)
     {
+        factorized = 0;
         createGMatrix ();
         createBMatrix ();
         createCMatrix ();
         createDMatrix ();
     }
+    /* A keeps its factorization during modified Newton iterations,
+       the actual Jacobian is assembled into J instead. */
+    else if (chord)
+    {
+        if (J == NULL || J->getCols () != A->getCols ())
+        {
+            delete J;
+            J = new tmatrix<nr_type_t> (A->getCols ());
+        }
+        std::swap (A, J);
+        createGMatrix ();
+        createBMatrix ();
+        createCMatrix ();
+        createDMatrix ();
+        std::swap (A, J);
+    }
 
     /* Adjust G matrix if requested. */
     if (convHelper == CONV_GMinStepping)
@@ -994,9 +1075,29 @@ void nasolver<nr_type_t>::runMNA (void)
 {
 
     // just solve the equation system here
-    eqns->setAlgo (eqnAlgo);
-    eqns->passEquationSys (updateMatrix ? A : NULL, x, z);
-    eqns->solve ();
+    if (!updateMatrix && chord)
+    {
+        solveChord ();
+    }
+    else if (lowrankUse && (eqnAlgo == ALGO_LU_DECOMPOSITION_CROUT ||
+                            eqnAlgo == ALGO_LU_DECOMPOSITION_DOOLITTLE))
+    {
+        solveLowRank ();
+    }
+    else
+    {
+        eqns->setAlgo (eqnAlgo);
+        eqns->passEquationSys (updateMatrix ? A : NULL, x, z);
+        eqns->solve ();
+        // remember the LU decomposition of A for the adjoint system
+        if (updateMatrix && top_exception () == NULL &&
+                (eqnAlgo == ALGO_LU_DECOMPOSITION_CROUT ||
+                 eqnAlgo == ALGO_LU_DECOMPOSITION_DOOLITTLE))
+        {
+            factorized = eqnAlgo;
+            chordIters = 0;
+        }
+    }
 
     // if damped Newton-Raphson is requested
     if (xprev != NULL && top_exception () == NULL)
@@ -1016,6 +1117,306 @@ void nasolver<nr_type_t>::runMNA (void)
     }
 }
 
+/* The function performs an iteration of the modified Newton method.
+   The matrix A still holds the LU decomposition of an earlier
+   Jacobian and J the Jacobian at the current solution x.  The update
+   is obtained by the substitutions A dx = z - J x only.  Since the
+   residual uses the actual Jacobian the iteration converges towards
+   the solution of J x = z, the old factorization merely affects the
+   rate of convergence. */
+template <class nr_type_t>
+void nasolver<nr_type_t>::solveChord (void)
+{
+    tvector<nr_type_t> r = *z - *J * *x;
+    tvector<nr_type_t> dx (r.size ());
+    eqns->setAlgo (factorized == ALGO_LU_DECOMPOSITION_DOOLITTLE ?
+                   ALGO_LU_SUBSTITUTION_DOOLITTLE :
+                   ALGO_LU_SUBSTITUTION_CROUT);
+    eqns->passEquationSys (NULL, &dx, &r);
+    eqns->solve ();
+    chordUpdate = maxnorm (dx);
+    chordIters++;
+    *x += dx;
+}
+
+/* The function returns non-zero if the factorization held in A may
+   be used for chord iterations at all. */
+template <class nr_type_t>
+int nasolver<nr_type_t>::chordPossible (void)
+{
+    // only the LU decompositions in A can be kept, and the damping
+    // schemes apart from the attenuation rely on the actual Jacobian
+    return chord && factorized && !lowrankUse &&
+           (convHelper == CONV_None || convHelper == CONV_Attenuation);
+}
+
+/* The function decides after the given iteration whether the next
+   one keeps the factorization held in A.  The factorization is kept
+   as long as the updates shrink by at least the factor given below,
+   i.e. Newton iterations switch to chord iterations once they are
+   contracting and chord iterations request a new factorization as
+   soon as the convergence becomes too slow.  A chord iteration
+   without a preceding update to compare with, i.e. the first one of
+   a transient step, is trusted.  It returns non-zero if the
+   factorization can be kept. */
+template <class nr_type_t>
+int nasolver<nr_type_t>::chordControl (int run)
+{
+    nr_double_t step;
+    int keep;
+
+    if (!chordPossible ())
+    {
+        chordStep = -1;
+        return 0;
+    }
+    // norm of the update of this iteration, negative if unknown
+    if (!updateMatrix)
+        step = chordUpdate;
+    else if (run > 0)
+        step = maxnorm (*x - *xprev);
+    else
+        step = -1;
+
+    if (step < 0)
+        keep = 0;
+    else if (chordStep < 0)
+        keep = !updateMatrix;
+    else
+        keep = step <= 0.5 * chordStep;
+    chordStep = step;
+    return keep;
+}
+
+/* The function solves the equation system if the netlist contains
+   switching circuits.  The matrix A is not factorized in place but a
+   few factorizations of previously assembled matrices are cached.  If
+   A differs from one of them in k rows only, i.e. A = A0 + E D with E
+   the k columns of the identity and D the k rows of A - A0, the
+   Sherman-Morrison-Woodbury formula
+
+     x = y - W inverse (I + D W) D y,  y = inverse (A0) z,
+                                       W = inverse (A0) E
+
+   requires two substitutions and a small dense k by k system instead
+   of a new factorization.  The columns of W are kept with the cached
+   factorization, thus toggling a switch back and forth costs
+   substitutions only.  Otherwise the matrix is factorized and replaces
+   the least recently used cache entry. */
+template <class nr_type_t>
+void nasolver<nr_type_t>::solveLowRank (void)
+{
+    int N = A->getCols ();
+    int maxRank = std::min (16, N / 4);
+    std::vector<int> rows, best;
+    int k = -1;
+
+    // find the cached factorization differing in the fewest rows
+    for (int i = 0; i < (int) lowrank.size (); i++)
+    {
+        changedRows (*lowrank[i].A0, rows, k < 0 ? maxRank :
+                     (int) best.size () - 1);
+        if ((int) rows.size () > maxRank) continue;
+        if (k < 0 || rows.size () < best.size ())
+        {
+            k = i;
+            best = rows;
+            if (best.empty ()) break;
+        }
+    }
+
+    // apply rank-k update, if not possible factorize the matrix
+    if (k >= 0)
+    {
+        lowrank[k].used = ++lowrankTick;
+        if (updateLowRank (k, best)) return;
+    }
+    factorizeLowRank ();
+}
+
+/* The function collects the rows of the A matrix differing from the
+   given one.  It stops as soon as more than the given number of rows
+   are found. */
+template <class nr_type_t>
+void nasolver<nr_type_t>::changedRows (tmatrix<nr_type_t> & A0,
+                                       std::vector<int> & rows, int limit)
+{
+    int N = A->getCols ();
+    const nr_type_t * a = A->getData ();
+    const nr_type_t * a0 = A0.getData ();
+    rows.clear ();
+    for (int r = 0; r < N && (int) rows.size () <= limit; r++)
+    {
+        for (int c = r * N; c < (r + 1) * N; c++)
+        {
+            if (a[c] != a0[c])
+            {
+                rows.push_back (r);
+                break;
+            }
+        }
+    }
+}
+
+/* This function solves the equation system using the cached
+   factorization with the given index and the rows in which the A
+   matrix differs from it.  It returns zero if the update is singular
+   or the residual of the solution is too large. */
+template <class nr_type_t>
+int nasolver<nr_type_t>::updateLowRank (int k, std::vector<int> & rows)
+{
+    factorization_t & f = lowrank[k];
+    int N = A->getCols ();
+    int K = rows.size ();
+
+    // solve for the right hand side with the cached factorization
+    tvector<nr_type_t> y (N);
+    f.eqns->passEquationSys (NULL, &y, z);
+    f.eqns->solve ();
+    if (K == 0)
+    {
+        *x = y;
+        return 1;
+    }
+
+    // create missing columns of the inverse
+    std::vector<tvector<nr_type_t> *> W (K);
+    for (int j = 0; j < K; j++)
+    {
+        typename std::map< int, tvector<nr_type_t> >::iterator it =
+            f.W.find (rows[j]);
+        if (it == f.W.end ())
+        {
+            tvector<nr_type_t> e (N), w (N);
+            e (rows[j]) = 1;
+            f.eqns->passEquationSys (NULL, &w, &e);
+            f.eqns->solve ();
+            it = f.W.insert (std::make_pair (rows[j], w)).first;
+        }
+        W[j] = &it->second;
+    }
+
+    // build the small system (I + D W) u = D y
+    tmatrix<nr_type_t> S (K);
+    tvector<nr_type_t> u (K);
+    for (int i = 0; i < K; i++)
+    {
+        int r = rows[i];
+        S (i, i) = 1;
+        for (int c = 0; c < N; c++)
+        {
+            nr_type_t d = (*A) (r, c) - (*f.A0) (r, c);
+            if (d == 0.0) continue;
+            u (i) += d * y (c);
+            for (int j = 0; j < K; j++) S (i, j) += d * (*W[j]) (c);
+        }
+    }
+
+    // solve it by Gaussian elimination with partial pivoting
+    for (int i = 0; i < K; i++)
+    {
+        int p = i;
+        for (int r = i + 1; r < K; r++)
+            if (abs (S (r, i)) > abs (S (p, i))) p = r;
+        if (abs (S (p, i)) < NR_TINY) return 0;
+        if (p != i)
+        {
+            S.exchangeRows (i, p);
+            std::swap (u (i), u (p));
+        }
+        for (int r = i + 1; r < K; r++)
+        {
+            nr_type_t l = S (r, i) / S (i, i);
+            if (l == 0.0) continue;
+            for (int c = i; c < K; c++) S (r, c) -= l * S (i, c);
+            u (r) -= l * u (i);
+        }
+    }
+    for (int i = K - 1; i >= 0; i--)
+    {
+        for (int c = i + 1; c < K; c++) u (i) -= S (i, c) * u (c);
+        u (i) /= S (i, i);
+    }
+
+    // compute the solution
+    for (int j = 0; j < K; j++)
+    {
+        for (int c = 0; c < N; c++) y (c) -= u (j) * (*W[j]) (c);
+    }
+
+    // reject the solution if its residual exceeds some roundoff
+    for (int r = 0; r < N; r++)
+    {
+        nr_type_t res = (*z) (r);
+        nr_double_t scale = abs ((*z) (r));
+        for (int c = 0; c < N; c++)
+        {
+            nr_type_t a = (*A) (r, c) * y (c);
+            res -= a;
+            scale += abs (a);
+        }
+        if (!std::isfinite (abs (res)) || abs (res) > 1e-9 * scale) return 0;
+    }
+    *x = y;
+    return 1;
+}
+
+/* The function factorizes the A matrix and solves the equation system.
+   The factorization is stored in the cache unless the factorization
+   reported a problem. */
+template <class nr_type_t>
+void nasolver<nr_type_t>::factorizeLowRank (void)
+{
+    int k;
+    if (lowrank.size () < 4)
+    {
+        factorization_t f;
+        f.A0 = new tmatrix<nr_type_t> (*A);
+        f.LU = new tmatrix<nr_type_t> (*A);
+        f.eqns = new eqnsys<nr_type_t> ();
+        lowrank.push_back (f);
+        k = lowrank.size () - 1;
+    }
+    else
+    {
+        // replace the least recently used factorization
+        k = 0;
+        for (int i = 1; i < (int) lowrank.size (); i++)
+            if (lowrank[i].used < lowrank[k].used) k = i;
+        *lowrank[k].A0 = *A;
+        *lowrank[k].LU = *A;
+        lowrank[k].W.clear ();
+    }
+    factorization_t & f = lowrank[k];
+    f.used = ++lowrankTick;
+    f.eqns->setAlgo (eqnAlgo);
+    f.eqns->passEquationSys (f.LU, x, z);
+    f.eqns->solve ();
+
+    // do not keep factorizations of singular matrices
+    if (top_exception () != NULL)
+    {
+        delete f.A0;
+        delete f.LU;
+        delete f.eqns;
+        lowrank.erase (lowrank.begin () + k);
+    }
+}
+
+/* The function deletes the cached factorizations. */
+template <class nr_type_t>
+void nasolver<nr_type_t>::clearLowRank (void)
+{
+    for (int i = 0; i < (int) lowrank.size (); i++)
+    {
+        delete lowrank[i].A0;
+        delete lowrank[i].LU;
+        delete lowrank[i].eqns;
+    }
+    lowrank.clear ();
+    lowrankTick = 0;
+}
+
 /* This function applies a damped Newton-Raphson (limiting scheme) to
    the current solution vector in the form x1 = x0 + a * (x1 - x0).  This
    convergence helper is heuristic and does not ensure global convergence. */
@@ -1037,7 +1438,7 @@ void nasolver<nr_type_t>::applyAttenuation (void)
     }
 
     // apply damped solution vector
-    *x = *xprev + alpha * dx;
+    axpy (alpha, dx, *xprev, *x);
 }
 
 /* This is damped Newton-Raphson using nested iterations in order to
@@ -1059,7 +1460,7 @@ void nasolver<nr_type_t>::lineSearch (void)
     do
     {
         // apply current damping factor and see what happens
-        *x = *xprev + alpha * dx;
+        axpy (alpha, dx, *xprev, *x);
 
         // recalculate Jacobian and right hand side
         saveSolution ();
@@ -1092,7 +1493,7 @@ void nasolver<nr_type_t>::lineSearch (void)
 
     // apply final damping factor
     assert (alpha > 0 && alpha <= 1);
-    *x = *xprev + alpha * dx;
+    axpy (alpha, dx, *xprev, *x);
 }
 
 /* The function looks for the optimal gradient for the right hand side
@@ -1112,7 +1513,7 @@ void nasolver<nr_type_t>::steepestDescent (void)
     do
     {
         // apply current damping factor and see what happens
-        *x = *xprev + alpha * dx;
+        axpy (alpha, dx, *xprev, *x);
 
         // recalculate Jacobian and right hand side
         saveSolution ();
@@ -1120,15 +1521,16 @@ void nasolver<nr_type_t>::steepestDescent (void)
         createZVector ();
 
         // check gradient criteria, ThinkME: Is this correct?
-        dz = *z - *zprev;
-        sl = real (sum (dz * -dz));
+        dz = *z;
+        dz -= *zprev;
+        sl = -real (scalar (dz, dz));
         if (norm (*z) < n + alpha * sl) break;
         alpha *= 0.7;
     }
     while (alpha > 0.001);
 
     // apply final damping factor
-    *x = *xprev + alpha * dx;
+    axpy (alpha, dx, *xprev, *x);
 }
 
 /* The function checks whether the iterative algorithm for linearizing
@@ -1320,6 +1722,7 @@ template <class nr_type_t>
 void nasolver<nr_type_t>::saveResults (const std::string &volts, const std::string &amps,
                                        int saveOPs, qucs::vector * f)
 {
+    profile_timer t (PROFILE_SAVE);
     int N = countNodes ();
     int M = countVoltageSources ();
 
@@ -1407,6 +1810,197 @@ void nasolver<nr_type_t>::saveResults (const std::string &volts, const std::stri
     }
 }
 
+/* The function solves the adjoint system A^T lambda = e.  The LU
+   decomposition of A left by the last solution is reused if there is
+   one, only the substitutions with the transposed factors are
+   necessary then.  Otherwise the matrix is assembled and decomposed
+   once again.  It returns non-zero on failure. */
+template <class nr_type_t>
+int nasolver<nr_type_t>::solveAdjoint (tvector<nr_type_t> & lambda,
+                                       tvector<nr_type_t> & e)
+{
+    int error = 0;
+
+    try_running ()
+    {
+        // the factorization of an older Jacobian is not sufficient
+        if (!factorized || chordIters)
+        {
+            updateMatrix = 1;
+            createMatrix ();
+            eqns->setAlgo (ALGO_LU_FACTORIZATION_CROUT);
+            eqns->passEquationSys (A, &lambda, &e);
+            eqns->solve ();
+            if (top_exception () != NULL) break;
+            factorized = ALGO_LU_DECOMPOSITION_CROUT;
+            chordIters = 0;
+        }
+        eqns->setAlgo (factorized == ALGO_LU_DECOMPOSITION_DOOLITTLE ?
+                       ALGO_LU_SUBSTITUTION_DOOLITTLE_T :
+                       ALGO_LU_SUBSTITUTION_CROUT_T);
+        eqns->passEquationSys (NULL, &lambda, &e);
+        eqns->solve ();
+    }
+    // appropriate exception handling
+    catch_exception ()
+    {
+    case EXCEPTION_SINGULAR:
+        while (top_exception () != NULL &&
+                top_exception()->getCode () == EXCEPTION_SINGULAR)
+            pop_exception ();
+        break;
+    default:
+        logprint (LOG_ERROR, "WARNING: %s: unable to solve the adjoint "
+                  "system\n", getName ());
+        pop_exception ();
+        error++;
+        break;
+    }
+    return error;
+}
+
+/* The function returns lambda^T F with F the contributions of the
+   given circuit to the residual A x - z at the current solution.  The
+   vector holds the node numbers of the circuit's ports. */
+template <class nr_type_t>
+nr_type_t nasolver<nr_type_t>::adjointResidual (circuit * c,
+                                                std::vector<int> & nodes,
+                                                tvector<nr_type_t> & lambda)
+{
+    int N = countNodes ();
+    int s = c->getSize ();
+    int v = c->getVoltageSource ();
+    int m = c->getVoltageSources ();
+    nr_type_t f, r = 0.0;
+
+    // node equations
+    for (int i = 0; i < s; i++)
+    {
+        if (nodes[i] < 0) continue;
+        f = 0.0;
+        for (int j = 0; j < s; j++)
+            if (nodes[j] >= 0)
+                f += MatVal (c->getY (i, j)) * x->get (nodes[j]);
+        for (int k = v; k < v + m; k++)
+            f += MatVal (c->getB (i, k)) * x->get (k + N);
+        if (c->isISource () || c->isNonLinear ())
+            f -= MatVal (c->getI (i));
+        r += lambda.get (nodes[i]) * f;
+    }
+
+    // voltage source equations
+    for (int k = v; k < v + m; k++)
+    {
+        f = -MatVal (c->getE (k));
+        for (int j = 0; j < s; j++)
+            if (nodes[j] >= 0)
+                f += MatVal (c->getC (k, j)) * x->get (nodes[j]);
+        for (int l = v; l < v + m; l++)
+            f += MatVal (c->getD (k, l)) * x->get (l + N);
+        r += lambda.get (k + N) * f;
+    }
+    return r;
+}
+
+/* The function computes the sensitivities of the given output, a node
+   voltage or the current through a voltage source, with respect to
+   the numeric properties of the linear circuits using the adjoint
+   method.  With F (x, p) = A x - z the residual at the solution, the
+   derivative of the output e^T x reads -lambda^T dF/dp with lambda
+   the solution of the adjoint system A^T lambda = e.  Thus a single
+   transposed solve serves all properties, each of them merely needs
+   the circuit alone to be stamped at slightly perturbed values (a
+   central difference).  The function must be run right after the
+   solution, the results are named <output>.<circuit>.<property>.
+   Properties referring to variables and those changing the structure
+   of the circuit (e.g. a zero resistance) are skipped. */
+template <class nr_type_t>
+void nasolver<nr_type_t>::solve_sensitivity (const std::string &output,
+                                             const std::string &volts,
+                                             const std::string &amps,
+                                             qucs::vector * f)
+{
+    int N = countNodes ();
+    int M = countVoltageSources ();
+    std::string name;
+    if (stamp_func == NULL) return;
+
+    // find the output, either a node or a voltage source
+    int row = getNodeNr (output) - 1;
+    if (row >= 0 && row < N)
+    {
+        name = output + "." + volts;
+    }
+    else
+    {
+        row = -1;
+        for (int r = 0; r < M && row < 0; r++)
+            if (output == findVoltageSource (r)->getName ()) row = r + N;
+        name = output + "." + amps;
+    }
+    if (row < 0)
+    {
+        logprint (LOG_ERROR, "WARNING: %s: no such node or voltage source "
+                  "`%s' for the sensitivities\n", getName (), output.c_str ());
+        return;
+    }
+
+    // solve the adjoint system
+    tvector<nr_type_t> lambda (N + M);
+    tvector<nr_type_t> e (N + M);
+    e.set (row, 1.0);
+    if (solveAdjoint (lambda, e)) return;
+
+    // the node numbers of the circuits' ports
+    std::map< circuit *, std::vector<int> > nodes;
+    for (int r = 0; r < N; r++)
+    {
+        for (auto &n : *nlist->getNode (r))
+        {
+            std::vector<int> &v = nodes[n->getCircuit ()];
+            if (v.empty ()) v.assign (n->getCircuit()->getSize (), -1);
+            v[n->getPort ()] = r;
+        }
+    }
+
+    circuit * root = subnet->getRoot ();
+    for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
+    {
+        if (c->isNonLinear () || !c->isOriginal () ||
+                c->hasProperty ("Controlled"))
+            continue;
+        std::vector<std::string> props = c->givenDoubleProperties ();
+        if (props.empty ()) continue;
+        std::vector<int> &ports = nodes[c];
+        if (ports.empty ()) ports.assign (c->getSize (), -1);
+
+        int sources = c->getVoltageSources ();
+        for (auto &p : props)
+        {
+            nr_double_t val = c->getPropertyDouble (p);
+            nr_double_t h = 1e-6 * (val != 0.0 ? std::fabs (val) : 1.0);
+            c->setProperty (p, val + h);
+            (*stamp_func) (this, c);
+            int same = sources == c->getVoltageSources ();
+            nr_type_t fp = same ? adjointResidual (c, ports, lambda) : 0.0;
+            c->setProperty (p, val - h);
+            (*stamp_func) (this, c);
+            same = same && sources == c->getVoltageSources ();
+            nr_type_t fn = same ? adjointResidual (c, ports, lambda) : 0.0;
+            c->setProperty (p, val);
+            (*stamp_func) (this, c);
+            if (same)
+            {
+                saveVariable (name + "." + c->getName () + "." + p,
+                              -(fp - fn) / (2.0 * h), f);
+            }
+        }
+    }
+
+    // restore the node voltages and branch currents of the circuits
+    saveSolution ();
+}
+
 /* Create an appropriate variable name for operating points.  The
    caller is responsible to free() the returned string. */
 template <class nr_type_t>
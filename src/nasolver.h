@@ -31,11 +31,15 @@
 // BUG
 #include "qucs_typedefs.h"
 #endif
+#include <vector>
+#include <map>
+
 #include "tvector.h"
 #include "tmatrix.h"
 #include "eqnsys.h"
 #include "nasolution.h"
 #include "analysis.h"
+#include "profile.h"
 
 // Convergence helper definitions.
 #define CONV_None            0
@@ -72,8 +76,11 @@ public:
     void saveResults (const std::string &, const std::string &, int, qucs::vector * f = NULL);
     typedef void (* calculate_func_t) (nasolver<nr_type_t> *);
     void setCalculation (calculate_func_t f) { calculate_func = f; }
+    typedef void (* stamp_func_t) (nasolver<nr_type_t> *, circuit *);
+    void setStamping (stamp_func_t f) { stamp_func = f; }
     void calculate (void)
     {
+        profile_timer t (PROFILE_DEVICES);
         if (calculate_func) (*calculate_func) (this);
     }
     const char * getHelperDescription (void);
@@ -89,6 +96,7 @@ protected:
     void savePreviousIteration (void);
     void restorePreviousIteration (void);
     int  countNodes (void);
+    int  nodeOrdering (void);
     int  getNodeNr (const std::string &);
     int  findAssignedNode (circuit *, int);
     int  countVoltageSources (void);
@@ -101,6 +109,10 @@ protected:
     void storeSolution (void);
     void recallSolution (void);
     int  checkConvergence (void);
+    std::string createV (int, const std::string&, int);
+    std::string createI (int, const std::string&, int);
+    void solve_sensitivity (const std::string &, const std::string &,
+                            const std::string &, qucs::vector * f = NULL);
 
 private:
     void assignVoltageSources (void);
@@ -111,11 +123,19 @@ private:
     void createIVector (void);
     void createEVector (void);
     void createZVector (void);
+    void solveLowRank (void);
+    void solveChord (void);
+    int  chordPossible (void);
+    int  chordControl (int);
+    int  updateLowRank (int, std::vector<int> &);
+    void factorizeLowRank (void);
+    void changedRows (tmatrix<nr_type_t> &, std::vector<int> &, int);
+    int  solveAdjoint (tvector<nr_type_t> &, tvector<nr_type_t> &);
+    nr_type_t adjointResidual (circuit *, std::vector<int> &,
+                               tvector<nr_type_t> &);
     void applyAttenuation (void);
     void lineSearch (void);
     void steepestDescent (void);
-    std::string createV (int, const std::string&, int);
-    std::string createI (int, const std::string&, int);
     std::string createOP (const std::string&, const std::string &);
     void saveNodeVoltages (void);
     void saveBranchCurrents (void);
@@ -134,12 +154,35 @@ protected:
     int fixpoint;
     int eqnAlgo;
     int updateMatrix;
+    int chord;      // modified Newton reusing factorizations
+    int chordStart; // first iteration may reuse the last factorization
     nr_double_t gMin, srcFactor;
     std::string desc;
     nodelist * nlist;
 
+private:
+    /* A factorization of a previously assembled matrix, kept for
+       matrices differing only in a few rows from it. */
+    struct factorization_t
+    {
+        tmatrix<nr_type_t> * A0;   // matrix as assembled
+        tmatrix<nr_type_t> * LU;   // its factorization
+        eqnsys<nr_type_t> * eqns;
+        std::map< int, tvector<nr_type_t> > W; // columns of inverse(A0)
+        int used;
+    };
+    void clearLowRank (void);
+
 private:
     eqnsys<nr_type_t> * eqns;
+    std::vector<factorization_t> lowrank;
+    int lowrankUse;
+    int lowrankTick;
+    int factorized; // algorithm of the LU decomposition held in A, if any
+    tmatrix<nr_type_t> * J;  // Jacobian of the current chord iteration
+    nr_double_t chordStep;   // norm of the last update, negative if unknown
+    nr_double_t chordUpdate; // norm of the last chord update
+    int chordIters;          // chord iterations since the factorization
     nr_double_t reltol;
     nr_double_t abstol;
     nr_double_t vntol;
@@ -148,6 +191,7 @@ private:
 private:
 
     calculate_func_t calculate_func;
+    stamp_func_t stamp_func;
 };
 
 } // namespace qucs
@@ -50,6 +50,8 @@
 #include "equation.h"
 #include "environment.h"
 #include "component_id.h"
+#include "profile.h"
+#include "prima.h"
 
 namespace qucs {
 
@@ -63,6 +65,7 @@ net::net () : object () {
   env = NULL;
   nset = NULL;
   srcFactor = 1;
+  reducer = NULL;
 }
 
 // Constructor creates a named instance of the net class.
@@ -75,6 +78,7 @@ net::net (const std::string &n) : object (n) {
   env = NULL;
   nset = NULL;
   srcFactor = 1;
+  reducer = NULL;
 }
 
 // Destructor deletes the net class object.
@@ -85,6 +89,8 @@ net::~net () {
     n = (circuit *) c->getNext ();
     delete c;
   }
+  // delete the circuits replaced by reduced order models
+  delete reducer;
   // delete original actions 
   for(auto * element : *orgacts) {
     delete element;
@@ -108,6 +114,7 @@ net::net (net & n) : object (n) {
   env = n.env;
   nset = NULL;
   srcFactor = 1;
+  reducer = NULL;
 }
 
 /* This function prepends the given circuit to the list of registered
@@ -231,9 +238,19 @@ int net::containsAnalysis (analysis * child, int type) {
   return 0;
 }
 
+/* Checks whether the given top level analysis should be run if only
+   the named analysis has been requested.  A DC analysis is always
+   run since the other analyses rely on its operating point. */
+static int selectAnalysis (analysis * a, const char * only) {
+  if (only == NULL || a->getType () == ANALYSIS_DC)
+    return 1;
+  return !strcmp (a->getName (), only);
+}
+
 /* This function runs all registered analyses applied to the current
-   netlist, except for external analysis types. */
-dataset * net::runAnalysis (int &err) {
+   netlist, except for external analysis types.  If a name is given
+   only this analysis (and the DC analysis) is run. */
+dataset * net::runAnalysis (int &err, const char * only) {
   dataset * out = new dataset ();
 
   // apply some data to all analyses
@@ -248,9 +265,12 @@ dataset * net::runAnalysis (int &err) {
   // re-order analyses
   orderAnalysis ();
 
+  // replace large linear subnetworks by reduced order models
+  if (prima::order > 0 && reducer == NULL) reduceNetworks ();
+
   // initialize analyses
   for (auto *a: * actions) {
-    if (!a->isExternal ())
+    if (!a->isExternal () && selectAnalysis (a, only))
     {
       err |= a->initialize ();
     }
@@ -258,16 +278,20 @@ dataset * net::runAnalysis (int &err) {
 
   // solve the analyses
   for (auto *a: * actions) {
-    if (!a->isExternal ())
+    if (!a->isExternal () && selectAnalysis (a, only))
     {
-      a->getEnv()->runSolver ();
+      profile_scope scope (a->getName ());
+      {
+        profile_timer t (PROFILE_EQUATIONS);
+        a->getEnv()->runSolver ();
+      }
       err |= a->solve ();
     }
   }
 
   // cleanup analyses
   for (auto *a: *actions) {
-    if (!a->isExternal ())
+    if (!a->isExternal () && selectAnalysis (a, only))
     {
         err |= a->cleanup ();
     }
@@ -276,6 +300,29 @@ dataset * net::runAnalysis (int &err) {
   return out;
 }
 
+/* The function replaces the large linear subnetworks by reduced
+   order models.  This is skipped if a noise analysis or a port
+   reducing S-parameter analysis is requested, neither can handle the
+   noiseless models with internal state nodes. */
+void net::reduceNetworks (void) {
+  for (auto *a : *actions) {
+    const char * noise = a->getPropertyString ("Noise");
+    const char * method = a->getPropertyString ("Method");
+    if ((a->getType () == ANALYSIS_SPARAMETER &&
+	 (method == NULL || strcmp (method, "nodal"))) ||
+	(noise != NULL && !strcmp (noise, "yes"))) {
+      logprint (LOG_ERROR, "WARNING: %s: linear network reduction is not "
+		"available with noise or port reducing S-parameter analysis\n",
+		a->getName ());
+      return;
+    }
+  }
+  reducer = new prima (this);
+  int n = reducer->reduce (prima::order);
+  logprint (LOG_STATUS, "NOTIFY: reduced %d linear network%s\n",
+	    n, n == 1 ? "" : "s");
+}
+
 /* The function returns the analysis with the second lowest order.  If
    there is no recursive sweep it returns NULL. */
 analysis * net::findSecondOrder (void) {
@@ -37,6 +37,7 @@ class nodeset;
 class analysis;
 class dataset;
 class environment;
+class prima;
 
 
 class net : public object
@@ -60,7 +61,7 @@ class net : public object
   void insertedNode (node *);
   void insertAnalysis (analysis *);
   void removeAnalysis (analysis *);
-  dataset * runAnalysis (int &);
+  dataset * runAnalysis (int &, const char * only = NULL);
   void getDroppedCircuits (nodelist * nodes = NULL);
   void deleteUnusedCircuits (nodelist * nodes = NULL);
   int  getPorts (void) { return nPorts; }
@@ -89,6 +90,7 @@ class net : public object
   void setSrcFactor (nr_double_t f) { srcFactor = f; }
   nr_double_t getSrcFactor (void) { return srcFactor; }
   void setActionNetAll(net *);
+  void reduceNetworks (void);
 
  private:
   nodeset * nset;
@@ -104,6 +106,7 @@ class net : public object
   int inserted;
   int insertedNodes;
   nr_double_t srcFactor;
+  prima * reducer;
 };
 
 } // namespace qucs
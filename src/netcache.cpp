@@ -0,0 +1,476 @@
+/*
+ * netcache.cpp - binary netlist cache implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifndef __MINGW32__
+#include <unistd.h>
+#endif
+
+#include "logging.h"
+#include "complex.h"
+#include "netdefs.h"
+#include "equation.h"
+#include "check_netlist.h"
+#include "netcache.h"
+
+// Magic bytes and format revision of a cache file.
+#define CACHE_MAGIC "QNC\x01"
+
+namespace qucs {
+
+using namespace eqn;
+
+// Directory of the cache files, caching is disabled if NULL.
+char * netcache::directory = NULL;
+
+/* The constructor reads the netlist text from the given file in order
+   to compute its hash and rewinds the file for the scanner.  The
+   cache remains disabled if there is no cache directory or the file
+   is not seekable. */
+netcache::netcache (FILE * fd) {
+  pos = 0;
+  corrupt = 0;
+  if (directory == NULL || fd == NULL)
+    return;
+  if (fseek (fd, 0, SEEK_SET) != 0)
+    return;
+
+  // 64-bit FNV-1a hash of the netlist and the simulator version
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  char buf[4096];
+  size_t n;
+  while ((n = fread (buf, 1, sizeof (buf), fd)) > 0) {
+    for (size_t i = 0; i < n; i++) {
+      hash ^= (unsigned char) buf[i];
+      hash *= 0x100000001b3ULL;
+    }
+  }
+  for (const char * v = PACKAGE_VERSION; *v; v++) {
+    hash ^= (unsigned char) *v;
+    hash *= 0x100000001b3ULL;
+  }
+  if (ferror (fd) || fseek (fd, 0, SEEK_SET) != 0)
+    return;
+
+  char name[32];
+  snprintf (name, sizeof (name), "%016llx.qnc", (unsigned long long) hash);
+  file = std::string (directory) + "/" + name;
+}
+
+// Destructor deletes a netlist cache object.
+netcache::~netcache () {
+}
+
+/* Reads the cache file of the netlist and installs its definition
+   tree as the one delivered by the parser.  Returns zero on success
+   and non-zero if there is no valid cache file. */
+int netcache::load (void) {
+  if (file.empty ())
+    return -1;
+  FILE * fd = fopen (file.c_str (), "rb");
+  if (fd == NULL)
+    return -1;
+  data.clear ();
+  char buf[4096];
+  size_t n;
+  while ((n = fread (buf, 1, sizeof (buf), fd)) > 0)
+    data.append (buf, n);
+  fclose (fd);
+
+  // check the header
+  pos = strlen (CACHE_MAGIC);
+  corrupt = data.compare (0, pos, CACHE_MAGIC) != 0;
+  char * version = getString ();
+  if (corrupt || version == NULL || strcmp (version, PACKAGE_VERSION)) {
+    free (version);
+    data.clear ();
+    return -1;
+  }
+  free (version);
+
+  struct definition_t * root = getDefinitions ();
+  if (corrupt || pos != data.size ()) {
+    logprint (LOG_STATUS, "netlist cache file `%s' is corrupt, ignored\n",
+	      file.c_str ());
+    // move the subcircuit bodies into the top-level list and delete
+    // the equations, then release everything at once
+    for (struct definition_t * def = root; def != NULL; def = def->next) {
+      node * eqn, * next;
+      for (eqn = (node *) def->eqns; eqn != NULL; eqn = next) {
+	next = eqn->getNext ();
+	delete eqn;
+      }
+      def->eqns = NULL;
+      if (def->sub != NULL) {
+	struct definition_t * last = def->sub;
+	while (last->next != NULL) last = last->next;
+	last->next = def->next;
+	def->next = def->sub;
+	def->sub = NULL;
+      }
+    }
+    definition_root = root;
+    netlist_destroy ();
+    data.clear ();
+    return -1;
+  }
+  definition_root = root;
+  data.clear ();
+  file.clear ();
+  return 0;
+}
+
+/* Serializes the definition tree delivered by the parser.  This must
+   be done before the checker runs since the checker modifies and
+   expands the tree. */
+void netcache::record (void) {
+  if (file.empty ())
+    return;
+  data.assign (CACHE_MAGIC);
+  putString (PACKAGE_VERSION);
+  putDefinitions (definition_root);
+}
+
+/* Writes the recorded definition tree into the cache file.  The file
+   is written under a temporary name and renamed, thus concurrent runs
+   never see a partial file. */
+void netcache::store (void) {
+  if (file.empty () || data.empty ())
+    return;
+  char suffix[32];
+#ifndef __MINGW32__
+  snprintf (suffix, sizeof (suffix), ".%ld", (long) getpid ());
+#else
+  snprintf (suffix, sizeof (suffix), ".tmp");
+#endif
+  std::string temp = file + suffix;
+  FILE * fd = fopen (temp.c_str (), "wb");
+  if (fd == NULL) {
+    logprint (LOG_ERROR, "cannot create netlist cache file `%s': %s\n",
+	      temp.c_str (), strerror (errno));
+    return;
+  }
+  size_t n = fwrite (data.data (), 1, data.size (), fd);
+  if (fclose (fd) != 0 || n != data.size () ||
+      rename (temp.c_str (), file.c_str ()) != 0) {
+    logprint (LOG_ERROR, "cannot write netlist cache file `%s'\n",
+	      file.c_str ());
+    remove (temp.c_str ());
+  }
+  data.clear ();
+}
+
+void netcache::putInt (int i) {
+  data.append ((const char *) &i, sizeof (i));
+}
+
+void netcache::putDouble (double d) {
+  data.append ((const char *) &d, sizeof (d));
+}
+
+// Strings are stored with their length, NULL pointers with -1.
+void netcache::putString (const char * s) {
+  if (s == NULL) {
+    putInt (-1);
+    return;
+  }
+  int len = strlen (s);
+  putInt (len);
+  data.append (s, len);
+}
+
+void netcache::putNodes (struct node_t * nodes) {
+  int n = 0;
+  for (struct node_t * node = nodes; node != NULL; node = node->next) n++;
+  putInt (n);
+  for (struct node_t * node = nodes; node != NULL; node = node->next)
+    putString (node->node);
+}
+
+void netcache::putValues (struct value_t * values) {
+  int n = 0;
+  for (struct value_t * val = values; val != NULL; val = val->next) n++;
+  putInt (n);
+  for (struct value_t * val = values; val != NULL; val = val->next) {
+    putString (val->ident);
+    putString (val->unit);
+    putString (val->scale);
+    putDouble (val->value);
+  }
+}
+
+void netcache::putPairs (struct pair_t * pairs) {
+  int n = 0;
+  for (struct pair_t * pair = pairs; pair != NULL; pair = pair->next) n++;
+  putInt (n);
+  for (struct pair_t * pair = pairs; pair != NULL; pair = pair->next) {
+    putString (pair->key);
+    putValues (pair->value);
+  }
+}
+
+/* Stores a list of equation nodes as produced by the parser, i.e.
+   assignments, references, applications and constants. */
+void netcache::putEquations (node * eqns) {
+  int n = eqns ? eqns->count () : 0;
+  putInt (n);
+  for (node * eqn = eqns; eqn != NULL; eqn = eqn->getNext ()) {
+    putInt (eqn->getType ());
+    putString (eqn->getInstance ());
+    switch (eqn->getType ()) {
+    case CONSTANT: {
+      constant * c = (constant *) eqn;
+      putInt (c->type);
+      switch (c->type) {
+      case TAG_DOUBLE:
+	putDouble (c->d);
+	break;
+      case TAG_COMPLEX:
+	putDouble (real (*c->c));
+	putDouble (imag (*c->c));
+	break;
+      case TAG_CHAR:
+	putInt (c->chr);
+	break;
+      case TAG_STRING:
+	putString (c->s);
+	break;
+      default:
+	break;
+      }
+      break;
+    }
+    case REFERENCE:
+      putString (((reference *) eqn)->n);
+      break;
+    case APPLICATION: {
+      application * a = (application *) eqn;
+      putString (a->n);
+      putInt (a->nargs);
+      putEquations (a->args);
+      break;
+    }
+    case ASSIGNMENT: {
+      assignment * a = (assignment *) eqn;
+      putString (a->result);
+      putEquations (a->body);
+      break;
+    }
+    }
+  }
+}
+
+void netcache::putDefinitions (struct definition_t * root) {
+  int n = 0;
+  for (struct definition_t * def = root; def != NULL; def = def->next) n++;
+  putInt (n);
+  for (struct definition_t * def = root; def != NULL; def = def->next) {
+    putString (def->type);
+    putString (def->instance);
+    putInt (def->action);
+    putInt (def->line);
+    putNodes (def->nodes);
+    putPairs (def->pairs);
+    putEquations ((node *) def->eqns);
+    putDefinitions (def->sub);
+  }
+}
+
+int netcache::getInt (void) {
+  int i = 0;
+  if (corrupt || pos + sizeof (i) > data.size ()) {
+    corrupt = 1;
+    return 0;
+  }
+  memcpy (&i, data.data () + pos, sizeof (i));
+  pos += sizeof (i);
+  return i;
+}
+
+double netcache::getDouble (void) {
+  double d = 0;
+  if (corrupt || pos + sizeof (d) > data.size ()) {
+    corrupt = 1;
+    return 0;
+  }
+  memcpy (&d, data.data () + pos, sizeof (d));
+  pos += sizeof (d);
+  return d;
+}
+
+char * netcache::getString (void) {
+  int len = getInt ();
+  if (len < 0 || corrupt)
+    return NULL;
+  if (pos + len > data.size ()) {
+    corrupt = 1;
+    return NULL;
+  }
+  char * s = (char *) malloc (len + 1);
+  memcpy (s, data.data () + pos, len);
+  s[len] = '\0';
+  pos += len;
+  return s;
+}
+
+/* The list readers below stop at the first error and always return
+   consistently linked lists, thus a corrupt file can be released by
+   the usual netlist functions. */
+struct node_t * netcache::getNodes (void) {
+  struct node_t * root = NULL, * last = NULL;
+  for (int i = getInt (); i > 0 && !corrupt; i--) {
+    struct node_t * node = create_node ();
+    node->node = getString ();
+    if (node->node == NULL) {
+      corrupt = 1;
+      free (node);
+      break;
+    }
+    if (last) last->next = node; else root = node;
+    last = node;
+  }
+  return root;
+}
+
+struct value_t * netcache::getValues (void) {
+  struct value_t * root = NULL, * last = NULL;
+  for (int i = getInt (); i > 0 && !corrupt; i--) {
+    struct value_t * val = create_value ();
+    val->ident = getString ();
+    val->unit = getString ();
+    val->scale = getString ();
+    val->value = getDouble ();
+    if (last) last->next = val; else root = val;
+    last = val;
+  }
+  return root;
+}
+
+struct pair_t * netcache::getPairs (void) {
+  struct pair_t * root = NULL, * last = NULL;
+  for (int i = getInt (); i > 0 && !corrupt; i--) {
+    struct pair_t * pair = create_pair ();
+    pair->key = getString ();
+    pair->value = getValues ();
+    if (last) last->next = pair; else root = pair;
+    last = pair;
+    if (pair->key == NULL) corrupt = 1;
+  }
+  return root;
+}
+
+node * netcache::getEquations (void) {
+  node * root = NULL, * last = NULL;
+  for (int i = getInt (); i > 0 && !corrupt; i--) {
+    node * eqn = NULL;
+    int type = getInt ();
+    char * instance = getString ();
+    switch (type) {
+    case CONSTANT: {
+      constant * c = new constant (getInt ());
+      switch (c->type) {
+      case TAG_DOUBLE:
+	c->d = getDouble ();
+	break;
+      case TAG_COMPLEX: {
+	nr_double_t re = getDouble ();
+	c->c = new nr_complex_t (re, getDouble ());
+	break;
+      }
+      case TAG_CHAR:
+	c->chr = getInt ();
+	break;
+      case TAG_STRING:
+	c->s = getString ();
+	if (c->s == NULL) c->type = TAG_UNKNOWN;
+	break;
+      default:
+	break;
+      }
+      eqn = c;
+      break;
+    }
+    case REFERENCE: {
+      reference * r = new reference ();
+      r->n = getString ();
+      eqn = r;
+      break;
+    }
+    case APPLICATION: {
+      application * a = new application ();
+      a->n = getString ();
+      a->nargs = getInt ();
+      a->args = getEquations ();
+      eqn = a;
+      break;
+    }
+    case ASSIGNMENT: {
+      assignment * a = new assignment ();
+      a->result = getString ();
+      a->body = getEquations ();
+      eqn = a;
+      break;
+    }
+    default:
+      corrupt = 1;
+      break;
+    }
+    if (eqn == NULL) {
+      free (instance);
+      break;
+    }
+    eqn->setInstance (instance);
+    free (instance);
+    if (last) last->setNext (eqn); else root = eqn;
+    last = eqn;
+  }
+  return root;
+}
+
+struct definition_t * netcache::getDefinitions (void) {
+  struct definition_t * root = NULL, * last = NULL;
+  for (int i = getInt (); i > 0 && !corrupt; i--) {
+    struct definition_t * def = create_definition ();
+    def->type = getString ();
+    def->instance = getString ();
+    def->action = getInt ();
+    def->line = getInt ();
+    def->nodes = getNodes ();
+    def->pairs = getPairs ();
+    def->eqns = getEquations ();
+    def->sub = getDefinitions ();
+    if (last) last->next = def; else root = def;
+    last = def;
+    if (def->type == NULL || def->instance == NULL) corrupt = 1;
+  }
+  return root;
+}
+
+} // namespace qucs
@@ -0,0 +1,95 @@
+/*
+ * netcache.h - binary netlist cache definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __NETCACHE_H__
+#define __NETCACHE_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string>
+
+struct definition_t;
+struct node_t;
+struct pair_t;
+struct value_t;
+
+namespace qucs {
+
+namespace eqn {
+  class node;
+}
+
+/*!\brief Binary cache of parsed netlists
+
+   The class keeps the definition tree delivered by the parser,
+   including the equation sets, in a compact binary file.  The file is
+   named after a 64-bit FNV-1a hash of the netlist text and the
+   simulator version, thus any edit of the netlist yields a new
+   file.  A netlist is only cached after it passed the checker
+   completely, so a later run finding the file skips the scanner and
+   parser and can run the checker in its trusted mode, which omits
+   the pure validations and only performs the steps building up the
+   definitions, environments and subcircuit expansions.
+
+   Caching requires a seekable input, i.e. it is not used for netlists
+   read from a pipe.
+*/
+class netcache
+{
+ public:
+  netcache (FILE *);
+  ~netcache ();
+  int  load (void);
+  void record (void);
+  void store (void);
+
+  static char * directory;
+
+ private:
+  void putInt (int);
+  void putDouble (double);
+  void putString (const char *);
+  void putNodes (struct node_t *);
+  void putValues (struct value_t *);
+  void putPairs (struct pair_t *);
+  void putEquations (eqn::node *);
+  void putDefinitions (struct definition_t *);
+
+  int    getInt (void);
+  double getDouble (void);
+  char * getString (void);
+  struct node_t * getNodes (void);
+  struct value_t * getValues (void);
+  struct pair_t * getPairs (void);
+  eqn::node * getEquations (void);
+  struct definition_t * getDefinitions (void);
+
+ private:
+  std::string file;
+  std::string data;
+  size_t pos;
+  int corrupt;
+};
+
+} // namespace qucs
+
+#endif /* __NETCACHE_H__ */
@@ -163,6 +163,8 @@ struct define_t {
 #define PROP_RNG_SOL \
   PROP_RNG_STR5 ("CroutLU", "DoolittleLU", "HouseholderQR", \
 		 "HouseholderLQ", "GolubSVD")
+#define PROP_RNG_ORD \
+  PROP_RNG_STR3 ("none", "RCM", "MinDegree")
 #define PROP_RNG_DIS \
   PROP_RNG_STR7 ("Kirschning", "Kobayashi", "Yamashita", "Getsinger", \
 		 "Schneider", "Pramanick", "Hammerstad")
@@ -28,6 +28,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdlib>
+#include <map>
+#include <set>
 
 #include "logging.h"
 #include "object.h"
@@ -146,26 +149,219 @@ std::string nodelist::getNodeString (int nr) const {
 }
 
 
-// This function enumerates the nodes in the node name list.
-void nodelist::assignNodes (void) {
-  int i = 1;
+/* This function enumerates the nodes in the node name list.  The
+   ground node always gets the zero counter.  The other nodes are
+   numbered in list order or according to the requested ordering
+   which reduces the bandwidth (reverse Cuthill-McKee) or the fill-in
+   (minimum degree) of the MNA matrix during its factorization. */
+void nodelist::assignNodes (int order) {
+  std::vector<nodelist_t *> nodes;
+  nodelist_t * gnd = nullptr;
+
+  // collect the nodes, separate the reference node
+  for (auto n: root) {
+    if (n->name=="gnd")
+      gnd = n;
+    else
+      nodes.push_back (n);
+  }
+
+  // apply the requested ordering
+  if (order == NODEORDER_RCM)
+    orderRCM (nodes);
+  else if (order == NODEORDER_MINDEGREE)
+    orderMinDegree (nodes);
 
   // create fast array access possibility
-  narray.clear();
-  narray.reserve(this->length());
+  narray.assign (nodes.size () + 1, nullptr);
 
-  for (auto n: root) {
-    // ground node gets a zero counter
-    if (n->name=="gnd") {
-      n->n = 0;
-      narray[0] = n;
+  // ground node gets a zero counter
+  if (gnd != nullptr) {
+    gnd->n = 0;
+    narray[0] = gnd;
+  }
+  // others get a unique number greater than zero
+  for (std::size_t i = 0; i < nodes.size (); i++) {
+    narray[i + 1] = nodes[i];
+    nodes[i]->n = i + 1;
+  }
+}
+
+/* The function creates the adjacency structure of the given nodes.
+   Two nodes are adjacent if they are connected to the same circuit,
+   i.e. the MNA matrix has got a structural non-zero entry at their
+   crossing.  The indices refer to positions in the given vector. */
+static void createAdjacency (const std::vector<nodelist_t *> &nodes,
+			     std::vector< std::vector<int> > &adj) {
+  std::map<circuit *, std::vector<int> > circuits;
+  for (std::size_t i = 0; i < nodes.size (); i++)
+    for (auto &n : *nodes[i])
+      circuits[n->getCircuit ()].push_back (i);
+
+  adj.assign (nodes.size (), std::vector<int> ());
+  for (auto &c : circuits) {
+    for (auto a : c.second)
+      for (auto b : c.second)
+	if (a != b) adj[a].push_back (b);
+  }
+  for (auto &a : adj) {
+    std::sort (a.begin (), a.end ());
+    a.erase (std::unique (a.begin (), a.end ()), a.end ());
+  }
+}
+
+/* Breadth first search through the unvisited part of the node graph
+   starting at the given node.  The visited nodes are appended to
+   'order' and 'level' is set to the position of the last level; the
+   function returns the number of levels found. */
+static int rcmSearch (std::vector< std::vector<int> > &adj,
+		      std::vector<bool> &visited, int start,
+		      std::vector<int> &order, std::size_t &level) {
+  std::vector<bool> seen (visited);
+  std::size_t first = order.size (), last;
+  int levels = 0;
+  order.push_back (start);
+  seen[start] = true;
+  while (first < order.size ()) {
+    level = first;
+    last = order.size ();
+    for (std::size_t i = first; i < last; i++) {
+      for (auto n : adj[order[i]]) {
+	if (!seen[n]) {
+	  seen[n] = true;
+	  order.push_back (n);
+	}
+      }
     }
-    // others get a unique number greater than zero
-    else {
-      narray[i] = n;
-      n->n = i++;
+    first = last;
+    levels++;
+  }
+  return levels;
+}
+
+/* This function computes the reverse Cuthill-McKee order of the
+   given (symmetric) adjacency graph.  Each connected part of the
+   graph is traversed breadth first starting at a pseudo-peripheral
+   node, visiting neighbours in order of increasing degree.  The
+   result lists the vertices in their new order. */
+void nodelist::permuteRCM (std::vector< std::vector<int> > &adj,
+			   std::vector<int> &result) {
+  int N = adj.size ();
+  std::vector<bool> visited (N, false);
+  std::vector<int> perm;
+
+  // visit neighbours with lower degree first
+  for (auto &a : adj) {
+    std::stable_sort (a.begin (), a.end (), [&adj] (int i, int j) {
+	return adj[i].size () < adj[j].size (); });
+  }
+
+  perm.reserve (N);
+  while ((int) perm.size () < N) {
+    // start with an unvisited node of minimum degree
+    int start = -1;
+    for (int i = 0; i < N; i++) {
+      if (!visited[i] && (start < 0 || adj[i].size () < adj[start].size ()))
+	start = i;
+    }
+
+    // find a pseudo-peripheral node in this part of the graph
+    std::vector<int> order;
+    std::size_t level;
+    int levels = rcmSearch (adj, visited, start, order, level);
+    for (int tries = 0; tries < 8; tries++) {
+      // use minimum degree node of the last level
+      int cand = order[level];
+      for (std::size_t i = level; i < order.size (); i++)
+	if (adj[order[i]].size () < adj[cand].size ()) cand = order[i];
+      std::vector<int> corder;
+      std::size_t clevel;
+      int clevels = rcmSearch (adj, visited, cand, corder, clevel);
+      if (clevels <= levels) break;
+      levels = clevels;
+      level = clevel;
+      order = corder;
+    }
+
+    // take the Cuthill-McKee order of this part
+    for (auto n : order) {
+      visited[n] = true;
+      perm.push_back (n);
+    }
+  }
+
+  // reverse the order
+  result.assign (perm.rbegin (), perm.rend ());
+}
+
+/* This function reorders the given nodes using the reverse
+   Cuthill-McKee algorithm. */
+void nodelist::orderRCM (std::vector<nodelist_t *> &nodes) {
+  std::vector< std::vector<int> > adj;
+  std::vector<int> perm;
+  createAdjacency (nodes, adj);
+  permuteRCM (adj, perm);
+
+  // apply the order
+  std::vector<nodelist_t *> sorted;
+  sorted.reserve (nodes.size ());
+  for (auto n : perm)
+    sorted.push_back (nodes[n]);
+  nodes = sorted;
+}
+
+/* This function reorders the given nodes using the minimum degree
+   algorithm.  The elimination of the nodes is simulated on the node
+   graph, each time choosing the node with the fewest neighbours and
+   connecting its neighbours with each other (the fill-in). */
+void nodelist::orderMinDegree (std::vector<nodelist_t *> &nodes) {
+  int N = nodes.size ();
+  std::vector< std::vector<int> > adj;
+  std::vector< std::set<int> > graph (N);
+  std::set< std::pair<std::size_t, int> > queue;
+  std::vector<nodelist_t *> sorted;
+  createAdjacency (nodes, adj);
+
+  for (int i = 0; i < N; i++) {
+    graph[i].insert (adj[i].begin (), adj[i].end ());
+    queue.insert ({ graph[i].size (), i });
+  }
+
+  sorted.reserve (N);
+  while (!queue.empty ()) {
+    // eliminate node with minimum degree
+    int p = queue.begin()->second;
+    queue.erase (queue.begin ());
+    sorted.push_back (nodes[p]);
+
+    // its neighbours form a clique afterwards
+    std::vector<int> clique (graph[p].begin (), graph[p].end ());
+    for (auto a : clique) {
+      queue.erase ({ graph[a].size (), a });
+      graph[a].erase (p);
     }
+    for (auto a : clique)
+      for (auto b : clique)
+	if (a != b) graph[a].insert (b);
+    for (auto a : clique)
+      queue.insert ({ graph[a].size (), a });
+    graph[p].clear ();
   }
+  nodes = sorted;
+}
+
+/* The function returns the bandwidth of the MNA matrix node part
+   according to the current node enumeration, i.e. the maximum
+   distance of a non-zero entry from the diagonal. */
+int nodelist::bandwidth (void) const {
+  std::vector<nodelist_t *> nodes (narray.begin () + 1, narray.end ());
+  std::vector< std::vector<int> > adj;
+  createAdjacency (nodes, adj);
+  int bw = 0;
+  for (std::size_t i = 0; i < adj.size (); i++)
+    for (auto n : adj[i])
+      bw = std::max (bw, std::abs (n - (int) i));
+  return bw;
 }
 
 /* The function appends a node pointer to the given nodelist
@@ -35,6 +35,14 @@ namespace qucs {
 class node;
 class net;
 
+/* Enumerates the node orderings applicable when numbering the nodes
+   of the MNA matrix. */
+enum nodeorder_type {
+  NODEORDER_NONE      = 0, // netlist order
+  NODEORDER_RCM       = 1, // reverse Cuthill-McKee (bandwidth reducing)
+  NODEORDER_MINDEGREE = 2  // minimum degree (fill-in reducing)
+};
+
 namespace detail {
   typedef std::vector<node *> nodevector;
 }
@@ -115,7 +123,8 @@ class nodelist
   int getNodeNr (const std::string &) const ;
   std::string get (int) const ;
   bool isInternal (int) const ;
-  void assignNodes (void);
+  void assignNodes (int order = NODEORDER_NONE);
+  int  bandwidth (void) const;
   void print (void) const;
   std::string getNodeString (int) const;
   void sort (void);
@@ -123,6 +132,8 @@ class nodelist
   void insert (circuit *);
   void sortedNodes (node **, node **);
   struct nodelist_t * getNode (const std::string &) const;
+  static void permuteRCM (std::vector< std::vector<int> > &,
+			  std::vector<int> &);
   struct nodelist_t * getNode (int nr) const {
     return narray[nr + 1];
   }
@@ -137,6 +148,8 @@ class nodelist
   bool contains (const std::string &) const;
   void insert (struct nodelist_t *);
   void addCircuitNode (struct nodelist_t *, node *);
+  void orderRCM (std::vector<nodelist_t *> &);
+  void orderMinDegree (std::vector<nodelist_t *> &);
 };
 
 } // namespace qucs
@@ -31,6 +31,7 @@
 #include <string.h>
 #include <assert.h>
 #include <utility>
+#include <algorithm>
 
 #include "logging.h"
 #include "complex.h"
@@ -182,6 +183,19 @@ int object::countProperties (void) const {
   return props.size();
 }
 
+/* The function returns the sorted names of the given properties
+   holding a plain number, i.e. neither a default value nor a
+   reference to a variable. */
+std::vector<std::string> object::givenDoubleProperties (void) const {
+  std::vector<std::string> names;
+  for (auto it = props.cbegin(); it != props.cend(); ++it) {
+    if (it->second.isDouble () && !it->second.isDefault ())
+      names.push_back (it->first);
+  }
+  std::sort (names.begin (), names.end ());
+  return names;
+}
+
 // This function returns a text representation of the objects properties.
 const char * object::propertyList (void) const {
   std::string ptxt;
@@ -32,6 +32,7 @@
 #define __OBJECT_H__
 
 #include <string>
+#include <vector>
 #include "property.h"
 
 #define MCREATOR(val) \
@@ -79,6 +80,7 @@ class object
   bool hasProperty (const std::string &n) const ;
   bool isPropertyGiven (const std::string &n) const;
   int  countProperties (void) const;
+  std::vector<std::string> givenDoubleProperties (void) const;
   const char *
     propertyList (void) const;
 
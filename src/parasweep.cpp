@@ -43,6 +43,7 @@
 #include "environment.h"
 #include "sweep.h"
 #include "parasweep.h"
+#include "profile.h"
 
 using namespace qucs::eqn;
 
@@ -159,7 +160,10 @@ int parasweep::solve (void) {
     // update environment and equation checker, then run solver
     env->setDoubleConstant (n, v);
     env->setDouble (n, v);
-    env->runSolver ();
+    {
+      profile_timer t (PROFILE_EQUATIONS);
+      env->runSolver ();
+    }
     // save results (swept parameter values)
     if (runs == 1) saveResults ();
 #if DEBUG
@@ -167,6 +171,7 @@ int parasweep::solve (void) {
 	      getName (), n, v);
 #endif
     for (auto *a : *actions) {
+      profile_scope scope (a->getName ());
       err |= a->solve ();
       // assign variable dataset dependencies to last order analyses
       ptrlist<analysis> * lastorder = subnet->findLastOrderChildren (this);
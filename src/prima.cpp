@@ -0,0 +1,504 @@
+/*
+ * prima.cpp - model order reduction of linear subnetworks implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
+#include <map>
+
+#include "compat.h"
+#include "object.h"
+#include "logging.h"
+#include "complex.h"
+#include "node.h"
+#include "circuit.h"
+#include "net.h"
+#include "nodelist.h"
+#include "nodeset.h"
+#include "component_id.h"
+#include "constants.h"
+#include "rom.h"
+#include "prima.h"
+
+namespace qucs {
+
+// Number of block moments, zero disables the reduction.
+int prima::order = 0;
+
+// Expansion frequency if the networks cannot be expanded at DC.
+nr_double_t prima::frequency = 1e9;
+
+// Constructor creates an instance of the prima class.
+prima::prima (net * n) {
+  subnet = n;
+  models = 0;
+}
+
+// Destructor deletes the prima class object and the removed circuits.
+prima::~prima () {
+  for (auto c : removed) delete c;
+}
+
+/* Returns non-zero if the given property of the circuit refers to a
+   variable, thus may change during a parameter sweep. */
+static int variableProperty (circuit * c, const char * prop) {
+  const char * ref = c->getPropertyReference (prop);
+  return ref != NULL && *ref != '\0';
+}
+
+/* The function returns non-zero if the given circuit can be part of
+   a reduced network and passes its resistance, capacitance or
+   inductance. */
+int prima::reducible (circuit * c, nr_double_t & value) {
+  if (!c->isOriginal () || c->getSize () != 2) return 0;
+  if (c->hasProperty ("Controlled")) return 0;
+  switch (c->getType ()) {
+  case CIR_RESISTOR: {
+    const char * props[] = { "R", "Temp", "Tnom", "Tc1", "Tc2", NULL };
+    for (int i = 0; props[i]; i++)
+      if (variableProperty (c, props[i])) return 0;
+    nr_double_t T  = c->getPropertyDouble ("Temp");
+    nr_double_t DT = T - c->getPropertyDouble ("Tnom");
+    nr_double_t Tc1 = c->getPropertyDouble ("Tc1");
+    nr_double_t Tc2 = c->getPropertyDouble ("Tc2");
+    value = c->getPropertyDouble ("R") * (1 + DT * (Tc1 + Tc2 * DT));
+    return value != 0;
+  }
+  case CIR_CAPACITOR:
+    if (variableProperty (c, "C") || c->isPropertyGiven ("V")) return 0;
+    value = c->getPropertyDouble ("C");
+    return 1;
+  case CIR_INDUCTOR:
+    if (variableProperty (c, "L") || c->isPropertyGiven ("I")) return 0;
+    value = c->getPropertyDouble ("L");
+    return value != 0;
+  }
+  return 0;
+}
+
+/* This function replaces each connected network of resistors,
+   capacitors and inductors in the netlist by a reduced order model
+   with the given number of block moments.  It returns the number of
+   reduced networks. */
+int prima::reduce (int moments) {
+  std::unordered_map<std::string, int> nodes;
+  std::vector<std::string> names;
+  std::vector<element_t> elements;
+  std::vector<circuit *> others;
+
+  auto lookup = [&] (const char * n) -> int {
+    if (!strcmp (n, "gnd")) return -1;
+    auto it = nodes.find (n);
+    if (it != nodes.end ()) return it->second;
+    nodes[n] = names.size ();
+    names.push_back (n);
+    return names.size () - 1;
+  };
+
+  // collect the reducible elements and the remaining circuits
+  for (circuit * c = subnet->getRoot (); c != NULL;
+       c = (circuit *) c->getNext ()) {
+    element_t e;
+    if (reducible (c, e.value)) {
+      e.c = c;
+      e.type = c->getType ();
+      e.node[0] = lookup (c->getNode(0)->getName ());
+      e.node[1] = lookup (c->getNode(1)->getName ());
+      if (e.node[0] >= 0 || e.node[1] >= 0) elements.push_back (e);
+    }
+    else others.push_back (c);
+  }
+  if (elements.empty ()) return 0;
+
+  // nodes connected to other circuits or with nodesets are ports
+  int N = names.size ();
+  std::vector<bool> port (N, false);
+  for (auto c : others) {
+    for (int i = 0; i < c->getSize (); i++) {
+      auto it = nodes.find (c->getNode(i)->getName ());
+      if (it != nodes.end ()) port[it->second] = true;
+    }
+  }
+  for (nodeset * n = subnet->getNodeset (); n; n = n->getNext ()) {
+    auto it = nodes.find (n->getName ());
+    if (it != nodes.end ()) port[it->second] = true;
+  }
+
+  // find the connected networks
+  std::vector<int> parent (N);
+  for (int i = 0; i < N; i++) parent[i] = i;
+  auto find = [&parent] (int i) {
+    while (parent[i] != i) i = parent[i] = parent[parent[i]];
+    return i;
+  };
+  for (auto &e : elements) {
+    if (e.node[0] >= 0 && e.node[1] >= 0)
+      parent[find (e.node[0])] = find (e.node[1]);
+  }
+  std::map<int, std::vector<int> > networks;
+  for (int i = 0; i < (int) elements.size (); i++) {
+    element_t &e = elements[i];
+    networks[find (e.node[0] >= 0 ? e.node[0] : e.node[1])].push_back (i);
+  }
+
+  int reduced = 0;
+  for (auto &nw : networks) {
+    // number the ports first, then the internal nodes
+    std::vector<int> pnodes, inodes;
+    int inductors = 0;
+    for (auto i : nw.second) {
+      element_t &e = elements[i];
+      for (int k = 0; k < 2; k++) {
+	int n = e.node[k];
+	if (n < 0) continue;
+	if (port[n]) pnodes.push_back (n); else inodes.push_back (n);
+      }
+      if (e.type == CIR_INDUCTOR) inductors++;
+    }
+    std::sort (pnodes.begin (), pnodes.end ());
+    pnodes.erase (std::unique (pnodes.begin (), pnodes.end ()), pnodes.end ());
+    std::sort (inodes.begin (), inodes.end ());
+    inodes.erase (std::unique (inodes.begin (), inodes.end ()), inodes.end ());
+    int P = pnodes.size (), I = inodes.size ();
+
+    // skip networks which would not get smaller
+    if (P == 0 || I + inductors <= moments * P) continue;
+
+    std::unordered_map<int, int> index;
+    std::vector<std::string> pnames;
+    for (int k = 0; k < P; k++) {
+      index[pnodes[k]] = k;
+      pnames.push_back (names[pnodes[k]]);
+    }
+    for (int k = 0; k < I; k++) index[inodes[k]] = P + k;
+    std::vector<element_t> network;
+    for (auto i : nw.second) {
+      element_t e = elements[i];
+      for (int k = 0; k < 2; k++)
+	if (e.node[k] >= 0) e.node[k] = index[e.node[k]];
+      network.push_back (e);
+    }
+
+    if (reduceNetwork (network, pnames, I, moments)) {
+      for (auto &e : network) {
+	subnet->removeCircuit (e.c, 0);
+	removed.push_back (e.c);
+      }
+      reduced++;
+    }
+  }
+  return reduced;
+}
+
+/* Sparse matrix entry. */
+struct primaentry_t {
+  int r, c;
+  nr_double_t v;
+};
+
+/* Symmetric positive definite matrix in envelope (profile) storage
+   and its Cholesky factorization.  Each row is stored from its first
+   non-zero up to the diagonal, which is where the fill-in happens. */
+struct primaenvelope_t {
+  std::vector<int> first;
+  std::vector<std::size_t> start;
+  std::vector<nr_double_t> a;
+  nr_double_t & at (int r, int c) { return a[start[r] + c - first[r]]; }
+
+  int factorize (void) {
+    int n = first.size ();
+    for (int i = 0; i < n; i++) {
+      for (int j = first[i]; j <= i; j++) {
+	nr_double_t s = at (i, j);
+	for (int k = std::max (first[i], first[j]); k < j; k++)
+	  s -= at (i, k) * at (j, k);
+	if (j < i) {
+	  at (i, j) = s / at (j, j);
+	}
+	else {
+	  if (s <= 1e-12 * at (i, i)) return 0;
+	  at (i, i) = std::sqrt (s);
+	}
+      }
+    }
+    return 1;
+  }
+
+  void solve (std::vector<nr_double_t> & x) {
+    int n = first.size ();
+    for (int i = 0; i < n; i++) {
+      nr_double_t s = x[i];
+      for (int k = first[i]; k < i; k++) s -= at (i, k) * x[k];
+      x[i] = s / at (i, i);
+    }
+    for (int i = n - 1; i >= 0; i--) {
+      x[i] /= at (i, i);
+      for (int k = first[i]; k < i; k++) x[k] -= at (i, k) * x[i];
+    }
+  }
+};
+
+/* The function reduces a single network.  Its nodes are numbered
+   with the P ports first followed by the I internal nodes, the
+   inductor currents come last.  The internal unknowns x solve
+
+     (G_ii + s C_ii) x = -(G_ip + s C_ip) v
+
+   for the port voltages v.  The block Krylov subspace of
+   A = M^-1 C_ii and the start block M^-1 [G_ip + s0 C_ip, C_ip] with
+   M = G_ii + s0 C_ii spans the first moments of x at s0.  The
+   subspaces of the expansion points are merged into one basis.  The
+   inductor currents are eliminated when solving with M, so that the
+   remaining node matrix is symmetric positive definite and is solved
+   by an envelope Cholesky factorization in reverse Cuthill-McKee
+   order.  The function returns zero if nothing was reduced. */
+int prima::reduceNetwork (std::vector<element_t> & network,
+			  std::vector<std::string> & pnames, int I,
+			  int moments) {
+  int P = pnames.size ();
+  std::vector<element_t *> inductors;
+  for (auto &e : network)
+    if (e.type == CIR_INDUCTOR) inductors.push_back (&e);
+  int L = inductors.size ();
+  int U = I + L, N = P + U;
+
+  // stamp G and C of the whole network
+  std::vector<primaentry_t> G, C;
+  auto stamp = [] (std::vector<primaentry_t> & m, int a, int b,
+		   nr_double_t v) {
+    if (a >= 0) m.push_back ({ a, a, +v });
+    if (b >= 0) m.push_back ({ b, b, +v });
+    if (a >= 0 && b >= 0) {
+      m.push_back ({ a, b, -v });
+      m.push_back ({ b, a, -v });
+    }
+  };
+  for (auto &e : network) {
+    if (e.type == CIR_RESISTOR) stamp (G, e.node[0], e.node[1], 1 / e.value);
+    if (e.type == CIR_CAPACITOR) stamp (C, e.node[0], e.node[1], e.value);
+  }
+  for (int k = 0; k < L; k++) {
+    int u = P + I + k, a = inductors[k]->node[0], b = inductors[k]->node[1];
+    if (a >= 0) { G.push_back ({ a, u, +1 }); G.push_back ({ u, a, -1 }); }
+    if (b >= 0) { G.push_back ({ b, u, -1 }); G.push_back ({ u, b, +1 }); }
+    C.push_back ({ u, u, inductors[k]->value });
+  }
+
+  // bandwidth reducing order of the internal nodes
+  std::vector< std::vector<int> > adj (I);
+  for (auto &e : network) {
+    int a = e.node[0] - P, b = e.node[1] - P;
+    if (a >= 0 && b >= 0 && a != b) {
+      adj[a].push_back (b);
+      adj[b].push_back (a);
+    }
+  }
+  for (auto &a : adj) {
+    std::sort (a.begin (), a.end ());
+    a.erase (std::unique (a.begin (), a.end ()), a.end ());
+  }
+  std::vector<int> perm, inv (I);
+  nodelist::permuteRCM (adj, perm);
+  for (int i = 0; i < I; i++) inv[perm[i]] = i;
+
+  // setup the envelope of the node matrix
+  primaenvelope_t K;
+  K.first.resize (I);
+  K.start.resize (I + 1);
+  for (int i = 0; i < I; i++) {
+    int f = i;
+    for (auto n : adj[perm[i]]) f = std::min (f, inv[n]);
+    K.first[i] = f;
+    K.start[i + 1] = K.start[i] + i - f + 1;
+  }
+
+  // factorizes the node matrix at the expansion point s0
+  nr_double_t s0 = 0;
+  auto factorize = [&] (void) {
+    K.a.assign (K.start[I], 0);
+    auto add = [&] (int a, int b, nr_double_t v) {
+      a = a >= P ? inv[a - P] : -1;
+      b = b >= P ? inv[b - P] : -1;
+      if (a >= 0) K.at (a, a) += v;
+      if (b >= 0) K.at (b, b) += v;
+      if (a >= 0 && b >= 0) K.at (std::max (a, b), std::min (a, b)) -= v;
+    };
+    for (auto &e : network) {
+      int a = e.node[0], b = e.node[1];
+      if (e.type == CIR_RESISTOR) add (a, b, 1 / e.value);
+      if (e.type == CIR_CAPACITOR) add (a, b, s0 * e.value);
+      if (e.type == CIR_INDUCTOR) add (a, b, 1 / (s0 * e.value));
+    }
+    return K.factorize ();
+  };
+
+  // solves M x = r for the internal unknowns
+  auto solve = [&] (std::vector<nr_double_t> & x) {
+    std::vector<nr_double_t> v (I);
+    for (int k = 0; k < L; k++) {
+      nr_double_t f = x[I + k] / (s0 * inductors[k]->value);
+      int a = inductors[k]->node[0] - P, b = inductors[k]->node[1] - P;
+      if (a >= 0) x[a] -= f;
+      if (b >= 0) x[b] += f;
+    }
+    for (int i = 0; i < I; i++) v[inv[i]] = x[i];
+    K.solve (v);
+    for (int i = 0; i < I; i++) x[i] = v[inv[i]];
+    for (int k = 0; k < L; k++) {
+      int a = inductors[k]->node[0] - P, b = inductors[k]->node[1] - P;
+      nr_double_t u = x[I + k];
+      if (a >= 0) u += x[a];
+      if (b >= 0) u -= x[b];
+      x[I + k] = u / (s0 * inductors[k]->value);
+    }
+  };
+
+  // port columns of G and C
+  std::vector< std::vector<nr_double_t> > g (P), c (P);
+  std::vector<int> dynamic (P, 0);
+  for (int k = 0; k < P; k++) {
+    g[k].assign (U, 0);
+    c[k].assign (U, 0);
+  }
+  for (auto &t : G)
+    if (t.c < P && t.r >= P) g[t.c][t.r - P] += t.v;
+  for (auto &t : C)
+    if (t.c < P && t.r >= P) { c[t.c][t.r - P] += t.v; dynamic[t.c] = 1; }
+
+  /* The subspace is expanded at DC and at the given frequency.  If
+     the node matrix is singular at DC (capacitive nodes) or has got
+     inductors, a point far below the frequency is used instead. */
+  std::vector<nr_double_t> points;
+  points.push_back (L > 0 ? 2 * pi * frequency * 1e-3 : 0);
+  if (frequency > 0) points.push_back (2 * pi * frequency);
+
+  // block Arnoldi process with deflation at each point
+  std::vector< std::vector<nr_double_t> > V;
+  for (std::size_t n = 0; n < points.size (); n++) {
+    s0 = points[n];
+    int ok = factorize ();
+    if (!ok && s0 == 0 && frequency > 0) {
+      s0 = 2 * pi * frequency * 1e-3;
+      ok = factorize ();
+    }
+    if (!ok) {
+      logprint (LOG_ERROR, "WARNING: cannot expand the linear network at "
+		"`%s' for s = %g, singular matrix\n", pnames[0].c_str (), s0);
+      continue;
+    }
+
+    // start block
+    std::vector< std::vector<nr_double_t> > block;
+    for (int k = 0; k < P; k++) {
+      std::vector<nr_double_t> w (g[k]);
+      for (int i = 0; i < U; i++) w[i] += s0 * c[k][i];
+      block.push_back (w);
+      if (dynamic[k]) block.push_back (c[k]);
+    }
+    for (auto &b : block) solve (b);
+
+    for (int m = 0; m < moments && !block.empty (); m++) {
+      std::vector< std::vector<nr_double_t> > next;
+      for (auto &w : block) {
+	nr_double_t n0 = 0, n1 = 0;
+	for (auto x : w) n0 += x * x;
+	for (int pass = 0; pass < 2; pass++) {
+	  for (auto &v : V) {
+	    nr_double_t h = 0;
+	    for (int i = 0; i < U; i++) h += v[i] * w[i];
+	    for (int i = 0; i < U; i++) w[i] -= h * v[i];
+	  }
+	}
+	for (auto x : w) n1 += x * x;
+	if (n1 <= 1e-20 * n0 || n1 == 0) continue;
+	n1 = 1 / std::sqrt (n1);
+	for (auto &x : w) x *= n1;
+	V.push_back (w);
+	next.push_back (w);
+      }
+      if ((int) V.size () >= U) break;
+      // next block A * V = M^-1 C_ii V
+      block.clear ();
+      if (m + 1 < moments) {
+	for (auto &v : next) {
+	  std::vector<nr_double_t> w (U, 0);
+	  for (auto &t : C)
+	    if (t.r >= P && t.c >= P) w[t.r - P] += t.v * v[t.c - P];
+	  solve (w);
+	  block.push_back (w);
+	}
+      }
+    }
+  }
+  int Q = V.size ();
+  if (Q == 0 || Q >= U) return 0;
+
+  /* congruence transform Gr = W^T G W and Cr = W^T C W with
+     W = diag (I, V) */
+  int M = P + Q;
+  auto project = [&] (std::vector<primaentry_t> & trip,
+		      std::vector<nr_double_t> & out) {
+    std::vector<nr_double_t> T ((std::size_t) N * M, 0);
+    for (auto &t : trip) {
+      nr_double_t * row = &T[(std::size_t) t.r * M];
+      if (t.c < P) row[t.c] += t.v;
+      else for (int j = 0; j < Q; j++) row[P + j] += t.v * V[j][t.c - P];
+    }
+    out.assign ((std::size_t) M * M, 0);
+    for (int a = 0; a < P; a++)
+      for (int b = 0; b < M; b++) out[a * M + b] = T[(std::size_t) a * M + b];
+    for (int r = P; r < N; r++) {
+      nr_double_t * row = &T[(std::size_t) r * M];
+      for (int j = 0; j < Q; j++) {
+	nr_double_t w = V[j][r - P];
+	if (w == 0) continue;
+	for (int b = 0; b < M; b++) out[(P + j) * M + b] += w * row[b];
+      }
+    }
+  };
+  std::vector<nr_double_t> Gr, Cr;
+  project (G, Gr);
+  project (C, Cr);
+
+  // put the reduced order model into the netlist
+  rom * r = new rom (M);
+  r->setName (circuit::createInternal ("ROM", network[0].c->getName ()));
+  for (int k = 0; k < P; k++) r->setNode (k, pnames[k]);
+  for (int j = 0; j < Q; j++)
+    r->setInternalNode (P + j, "z" + std::to_string (j));
+  r->setModel (Gr, Cr);
+  subnet->insertCircuit (r);
+  models++;
+
+  logprint (LOG_STATUS, "NOTIFY: %s: reduced %d elements with %d unknowns "
+	    "to %d ports and %d states\n", r->getName (), (int) network.size (),
+	    U, P, Q);
+  return 1;
+}
+
+} // namespace qucs
@@ -0,0 +1,87 @@
+/*
+ * prima.h - model order reduction of linear subnetworks definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __PRIMA_H__
+#define __PRIMA_H__
+
+#include <vector>
+#include <string>
+
+namespace qucs {
+
+class net;
+class circuit;
+
+/*!\brief Model order reduction of linear subnetworks
+
+   The class finds the maximal connected networks of resistors,
+   capacitors and inductors in a netlist, much like the harmonic
+   balance separates its linear and non-linear circuits.  The nodes of
+   such a network connected to any other circuit are its ports, all
+   remaining nodes and the inductor currents are internal.  Each
+   network with enough internal unknowns is replaced by a reduced
+   order model (a rom circuit) obtained by the PRIMA algorithm: an
+   orthonormal basis V of the block Krylov subspaces of the internal
+   equations expanded at DC and at the given frequency is computed
+   and the ports are kept, i.e. the system G + sC is projected by the
+   congruence W = diag (I, V).  The model matches the first moments
+   of the port admittance at both points and stays passive.  The
+   order gives the number of block moments per point.  The inductor
+   currents are eliminated when solving the internal equations, thus
+   networks with inductors (or without a DC path) are expanded at a
+   thousandth of the given frequency instead of DC.
+
+   Elements whose values depend on variables (which may be swept) or
+   which have initial conditions are not reduced.  The removed
+   elements are kept by the class and deleted with it.
+*/
+class prima
+{
+ public:
+  prima (net *);
+  ~prima ();
+  int reduce (int);
+
+  static int order;
+  static nr_double_t frequency;
+
+ private:
+  struct element_t {
+    circuit * c;
+    int type;
+    nr_double_t value;
+    int node[2];
+  };
+
+  int  reducible (circuit *, nr_double_t &);
+  int  reduceNetwork (std::vector<element_t> &,
+		      std::vector<std::string> &, int, int);
+
+ private:
+  net * subnet;
+  std::vector<circuit *> removed;
+  int models;
+};
+
+} // namespace qucs
+
+#endif /* __PRIMA_H__ */
@@ -0,0 +1,189 @@
+/*
+ * profile.cpp - performance counters class implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "object.h"
+#include "complex.h"
+#include "circuit.h"
+#include "profile.h"
+
+namespace qucs {
+
+// A single counter.
+struct profile_counter_t {
+  nr_double_t time;
+  unsigned long calls;
+};
+
+// The counters of an analysis.
+struct profile_record_t {
+  std::string name;
+  profile_counter_t sections[PROFILE_SECTIONS];
+  std::map<int, profile_counter_t> devices;
+};
+
+static const char * profile_names[PROFILE_SECTIONS] = {
+  "analysis", "assembly", "factorization", "substitution",
+  "devices", "save", "equations"
+};
+
+/* Analyses in the order of their first appearance.  The deque keeps
+   the records in place while growing, profile::current points into
+   it. */
+static std::deque<profile_record_t> profile_records;
+
+// Names of the device types.
+static std::map<int, std::string> profile_devices;
+
+int profile::enabled = 0;
+profile_record_t * profile::current = NULL;
+
+// Serializes the counter updates of parallel sections.
+static std::mutex profile_lock;
+
+// Returns a monotonic time stamp in seconds.
+nr_double_t profile::now (void) {
+  using namespace std::chrono;
+  return duration<nr_double_t> (steady_clock::now ().time_since_epoch ())
+    .count ();
+}
+
+// Looks up the counters of the named analysis, creates them if necessary.
+static profile_record_t * profile_find (const char * name) {
+  for (auto & r : profile_records)
+    if (r.name == name) return &r;
+  profile_records.emplace_back ();
+  profile_records.back ().name = name;
+  return &profile_records.back ();
+}
+
+// Adds the given time to a section of the current analysis.
+void profile::add (int section, nr_double_t t) {
+  std::lock_guard<std::mutex> l (profile_lock);
+  if (current == NULL) current = profile_find ("(none)");
+  current->sections[section].time += t;
+  current->sections[section].calls++;
+}
+
+// Adds the given time to the device type of the given circuit.
+void profile::addDevice (circuit * c, nr_double_t t) {
+  std::lock_guard<std::mutex> l (profile_lock);
+  if (current == NULL) current = profile_find ("(none)");
+  profile_counter_t & d = current->devices[c->getType ()];
+  d.time += t;
+  d.calls++;
+}
+
+// Assigns a name to the given device type.
+void profile::nameDevice (int type, const char * name) {
+  if (profile_devices.find (type) == profile_devices.end ())
+    profile_devices[type] = name;
+}
+
+// Returns the name of the given device type.
+static std::string profile_device (int type) {
+  auto it = profile_devices.find (type);
+  if (it != profile_devices.end ()) return it->second;
+  return "type " + std::to_string (type);
+}
+
+// Prints the counters as a table.
+void profile::print (FILE * f) {
+  fprintf (f, "%-16s %-24s %10s %12s %12s\n",
+	   "analysis", "section", "calls", "time [s]", "average [us]");
+  for (auto & r : profile_records) {
+    const char * name = r.name.c_str ();
+    for (int i = 0; i < PROFILE_SECTIONS; i++) {
+      profile_counter_t & c = r.sections[i];
+      if (c.calls == 0) continue;
+      fprintf (f, "%-16s %-24s %10lu %12.6f %12.3f\n", name,
+	       profile_names[i], c.calls, (double) c.time,
+	       (double) (c.time / c.calls * 1e6));
+      name = "";
+    }
+    for (auto & d : r.devices) {
+      std::string dev = "device " + profile_device (d.first);
+      fprintf (f, "%-16s %-24s %10lu %12.6f %12.3f\n", name,
+	       dev.c_str (), d.second.calls, (double) d.second.time,
+	       (double) (d.second.time / d.second.calls * 1e6));
+      name = "";
+    }
+  }
+}
+
+// Prints the counters as JSON object.
+void profile::printJSON (FILE * f) {
+  fprintf (f, "{\n  \"analyses\": [");
+  for (size_t n = 0; n < profile_records.size (); n++) {
+    profile_record_t & r = profile_records[n];
+    fprintf (f, "%s\n    {\n      \"name\": \"%s\",\n      \"sections\": {",
+	     n ? "," : "", r.name.c_str ());
+    int first = 1;
+    for (int i = 0; i < PROFILE_SECTIONS; i++) {
+      profile_counter_t & c = r.sections[i];
+      if (c.calls == 0) continue;
+      fprintf (f, "%s\n        \"%s\": { \"calls\": %lu, \"time\": %.9g }",
+	       first ? "" : ",", profile_names[i], c.calls, (double) c.time);
+      first = 0;
+    }
+    fprintf (f, "\n      },\n      \"devices\": {");
+    first = 1;
+    for (auto & d : r.devices) {
+      fprintf (f, "%s\n        \"%s\": { \"calls\": %lu, \"time\": %.9g }",
+	       first ? "" : ",", profile_device (d.first).c_str (),
+	       d.second.calls, (double) d.second.time);
+      first = 0;
+    }
+    fprintf (f, "\n      }\n    }");
+  }
+  fprintf (f, "\n  ]\n}\n");
+}
+
+// Makes the named analysis the current one.
+profile_scope::profile_scope (const char * name) {
+  previous = profile::current;
+  start = 0;
+  if (profile::enabled) {
+    profile::current = profile_find (name);
+    start = profile::now ();
+  }
+}
+
+// Accounts the analysis run time and restores the previous analysis.
+profile_scope::~profile_scope () {
+  if (profile::enabled) {
+    profile::add (PROFILE_ANALYSIS, profile::now () - start);
+    profile::current = previous;
+  }
+}
+
+} // namespace qucs
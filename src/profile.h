@@ -0,0 +1,119 @@
+/*
+ * profile.h - performance counters class definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include <stdio.h>
+
+namespace qucs {
+
+class circuit;
+struct profile_record_t;
+
+// Sections of an analysis being timed.
+enum profile_section_t {
+  PROFILE_ANALYSIS = 0,   // the analysis as a whole
+  PROFILE_ASSEMBLY,       // MNA matrix assembly
+  PROFILE_FACTORIZATION,  // matrix factorization (or complete solution)
+  PROFILE_SUBSTITUTION,   // forward/backward substitution
+  PROFILE_DEVICES,        // device evaluation
+  PROFILE_SAVE,           // saving results
+  PROFILE_EQUATIONS,      // equation evaluation
+  PROFILE_SECTIONS
+};
+
+/*!\brief Per-analysis performance counters
+
+   Records the time and the number of calls of the sections above and
+   of the device evaluation per device type, separately for each
+   analysis.  Counting is disabled by default and every timer reduces
+   to a single test then.
+*/
+class profile
+{
+ public:
+  static int enabled;
+  static nr_double_t now (void);
+  static void add (int, nr_double_t);
+  static void addDevice (circuit *, nr_double_t);
+  static void nameDevice (int, const char *);
+  static void print (FILE *);
+  static void printJSON (FILE *);
+
+ private:
+  friend class profile_scope;
+  static profile_record_t * current;
+};
+
+/* Scoped timer adding its lifetime to the given section of the
+   current analysis. */
+class profile_timer
+{
+ public:
+  profile_timer (int s) {
+    section = s;
+    start = profile::enabled ? profile::now () : 0;
+  }
+  ~profile_timer () {
+    if (profile::enabled) profile::add (section, profile::now () - start);
+  }
+
+ private:
+  int section;
+  nr_double_t start;
+};
+
+/* Scoped timer adding its lifetime to the device type of the given
+   circuit. */
+class profile_device
+{
+ public:
+  profile_device (circuit * c) {
+    cir = c;
+    start = profile::enabled ? profile::now () : 0;
+  }
+  ~profile_device () {
+    if (profile::enabled) profile::addDevice (cir, profile::now () - start);
+  }
+
+ private:
+  circuit * cir;
+  nr_double_t start;
+};
+
+/* Makes the named analysis the current one for its lifetime and
+   accounts its overall run time. */
+class profile_scope
+{
+ public:
+  profile_scope (const char *);
+  ~profile_scope ();
+
+ private:
+  profile_record_t * previous;
+  nr_double_t start;
+};
+
+} // namespace qucs
+
+#endif /* __PROFILE_H__ */
@@ -59,6 +59,7 @@ class property
   void set (variable *);
   std::string toString (void) const;
   bool isDefault (void) const { return def; }
+  bool isDouble (void) const { return type == PROPERTY_DOUBLE && !var; }
   void setDefault (bool d) { def = d; }
 
  private:
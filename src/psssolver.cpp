@@ -0,0 +1,534 @@
+/*
+ * psssolver.cpp - periodic steady-state solver class implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+
+#include "compat.h"
+#include "object.h"
+#include "logging.h"
+#include "complex.h"
+#include "circuit.h"
+#include "net.h"
+#include "netdefs.h"
+#include "analysis.h"
+#include "nasolver.h"
+#include "integrator.h"
+#include "transient.h"
+#include "exception.h"
+#include "exceptionstack.h"
+#include "psssolver.h"
+
+#define dState 0 // delta T state
+#define sState 1 // solution state
+
+// Macro for the n-th state of the solution vector history.
+#define SOL(state) (solution[(int) getState (sState, (state))])
+
+namespace qucs {
+
+using namespace transient;
+
+// Constructor creates an unnamed instance of the psssolver class.
+psssolver::psssolver ()
+    : trsolver ()
+{
+    type = ANALYSIS_PSS;
+    setDescription ("periodic steady-state");
+    period = 0;
+    points = 0;
+    periods = 0;
+}
+
+// Constructor creates a named instance of the psssolver class.
+psssolver::psssolver (const std::string &n)
+    : trsolver (n)
+{
+    type = ANALYSIS_PSS;
+    setDescription ("periodic steady-state");
+    period = 0;
+    points = 0;
+    periods = 0;
+}
+
+// Destructor deletes the psssolver class object.
+psssolver::~psssolver ()
+{
+}
+
+/* The copy constructor creates a new instance of the psssolver class
+   based on the given psssolver object. */
+psssolver::psssolver (psssolver & o)
+    : trsolver (o)
+{
+    period = o.period;
+    points = o.points;
+    periods = 0;
+}
+
+/* This is the periodic steady-state solver.  It runs a few periods
+   of a transient analysis starting at the DC solution and then the
+   shooting Newton iteration. */
+int psssolver::solve (void)
+{
+    int error = 0;
+    int ShootIter = getPropertyInteger ("ShootIter");
+    int warmup = getPropertyInteger ("Periods");
+    initialDC = !strcmp (getPropertyString ("initialDC"), "yes") ? true : false;
+
+    runs++;
+    periods = 0;
+    statRejected = statSteps = statIterations = statConvergence = 0;
+    period = 1 / getPropertyDouble ("f");
+    points = getPropertyInteger ("Points");
+    selectSolver ();
+
+    // Perform initial DC analysis.
+    if (initialDC)
+    {
+        error = dcAnalysis ();
+        if (error)
+            return -1;
+    }
+
+    // Initialize the period integration.
+    setDescription ("periodic steady-state");
+    initPSS ();
+
+    // circuits with a history (e.g. transmission lines) or convolution
+    // states cannot be restarted at a given solution, the flags are set
+    // by their initTR()
+    circuit * root = subnet->getRoot ();
+    for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
+    {
+        if (c->hasHistory () || c->isConvolved ())
+        {
+            logprint (LOG_ERROR, "ERROR: %s: `%s' not supported in %s "
+                      "analysis\n", getName (), c->getName (),
+                      getDescription ().c_str ());
+            releaseCircuits ();
+            deinitTR ();
+            return -1;
+        }
+    }
+
+    setCalculation ((calculate_func_t) &calcTR);
+    solve_pre ();
+
+    // Recall the DC solution and apply the nodesets.
+    recallSolution ();
+    applyNodeset (false);
+
+    int n = x->size ();
+    tvector<nr_double_t> x0 = *x, xT (n), x1 (n), xT1 (n), r (n), dx (n);
+
+    // Let the start-up transients decay for some periods, the first one
+    // starts at the DC solution and the initial conditions.
+    for (int i = 0; !error && i < warmup; i++)
+    {
+        error = integratePeriod (x0, xT, i ? MODE_INIT | MODE_RESTART
+                                 : MODE_INIT);
+        x0 = xT;
+    }
+    if (!error)
+        error = integratePeriod (x0, xT, MODE_INIT | MODE_RESTART);
+
+    // Newton iteration on the periodic boundary condition.
+    int iter = 0;
+    r = xT - x0;
+    nr_double_t rn = norm (r);
+    while (!error && !isPeriodic (x0, xT))
+    {
+        if (++iter > ShootIter)
+        {
+            qucs::exception * e = new qucs::exception (EXCEPTION_NO_CONVERGENCE);
+            e->setText ("no convergence in %s analysis after %d shooting "
+                        "iterations", getName (), ShootIter);
+            throw_exception (e);
+            error++;
+            break;
+        }
+
+        // solve (I - M) dx = x(T) - x(0)
+        int k = gmres (x0, xT, r, dx);
+        if (k < 0)
+        {
+            error++;
+            break;
+        }
+#if DEBUG
+        logprint (LOG_STATUS, "NOTIFY: %s: shooting iteration %d, residual "
+                  "%g, %d GMRES iterations\n", getName (), iter,
+                  (double) std::sqrt (rn), k);
+#endif
+
+        // damp the update if the residual grows
+        nr_double_t lambda = 1;
+        for (;;)
+        {
+            x1 = x0 + lambda * dx;
+            int err = integratePeriod (x1, xT1, MODE_INIT | MODE_RESTART);
+            r = xT1 - x1;
+            if (!err && norm (r) < rn) break;
+            if ((lambda /= 2) < 1.0 / 16)
+            {
+                error += err;
+                break;
+            }
+        }
+        x0 = x1;
+        xT = xT1;
+        rn = norm (r);
+    }
+
+    // Integrate the final period and save it.
+    if (!error)
+    {
+        error = integratePeriod (x0, xT, MODE_INIT | MODE_RESTART, true);
+        if (!error) saveAllResults ();
+    }
+    estack.print ();
+
+    solve_post ();
+    logprint (LOG_STATUS, "NOTIFY: %s: %d shooting iterations, %d periods "
+              "of %d time-steps\n", getName (), iter, periods, points);
+    logprint (LOG_STATUS, "NOTIFY: %s: average NR-iterations %g\n",
+              getName (), (double) statIterations / std::max (statSteps, 1));
+
+    // cleanup
+    releaseCircuits ();
+    deinitTR ();
+    return error ? -1 : 0;
+}
+
+/* The function initializes the transient solver for the integration
+   of periods with fixed time-steps. */
+void psssolver::initPSS (void)
+{
+    const char * const IMethod = getPropertyString ("IntegrationMethod");
+
+    // fetch corrector integration method and determine predicor method
+    corrMaxOrder = getPropertyInteger ("Order");
+    corrType = CMethod = correctorType (IMethod, corrMaxOrder);
+    predType = PMethod = predictorType (CMethod, corrMaxOrder, predMaxOrder);
+    corrOrder = corrMaxOrder;
+    predOrder = predMaxOrder;
+
+    // the time-step is fixed
+    delta = deltaMin = deltaMax = period / points;
+    rejected = 0;
+
+    // initialize step history and coefficients
+    setStates (2);
+    initStates ();
+    fillState (dState, delta);
+    saveState (dState, deltas);
+    setDelta ();
+    calcCorrectorCoeff (corrType, corrOrder, corrCoeff, deltas);
+    calcPredictorCoeff (predType, predOrder, predCoeff, deltas);
+
+    // initialize history of solution vectors
+    for (int i = 0; i < 8; i++)
+    {
+        solution[i] = new tvector<nr_double_t>;
+        setState (sState, (nr_double_t) i, i);
+    }
+
+    // tell circuits about the transient analysis
+    circuit * c, * root = subnet->getRoot ();
+    for (c = root; c != NULL; c = (circuit *) c->getNext ())
+        initCircuitTR (c);
+    for (c = root; c != NULL; c = (circuit *) c->getPrev ())
+        initCircuitTR (c);
+    initStateArena ();
+}
+
+/* The function integrates the circuit over one period starting at the
+   given solution x0 and returns the solution at the end of the period
+   in xT.  The states of the circuits are initialized according to x0
+   using the given integrator mode.  Each period uses the same
+   time-steps and starts with a first order step, thus the result is a
+   smooth function of x0.  If requested the solutions of all
+   time-steps are kept.  Returns non-zero on errors. */
+int psssolver::integratePeriod (tvector<nr_double_t> & x0,
+                                tvector<nr_double_t> & xT, int mode,
+                                bool keep)
+{
+    // restart the circuits at the given solution
+    current = 0;
+    *x = x0;
+    saveSolution ();
+    restartNR ();
+    setMode (mode);
+    calculate ();
+    setMode (MODE_NONE);
+    fillSolution (x);
+    fillState (dState, delta);
+    adjustOrder (1);
+    periods++;
+
+    if (keep)
+    {
+        orbit.clear ();
+        orbit.push_back (*x);
+    }
+
+    for (int n = 1; n <= points; n++)
+    {
+        current = n * delta;
+        updateCoefficients (delta);
+        predictor ();
+
+        // run the corrector, once more using line search on failure
+        int error, tries = 0;
+        do
+        {
+            error = 0;
+            try_running ()
+            {
+                error += corrector ();
+            }
+            catch_exception ()
+            {
+            case EXCEPTION_NO_CONVERGENCE:
+                pop_exception ();
+                convHelper = CONV_LineSearch;
+                statConvergence++;
+                error++;
+                break;
+            default:
+                estack.print ();
+                return -1;
+            }
+            if (error)
+            {
+                *x = *SOL (1);
+                restartNR ();
+            }
+        }
+        while (error && ++tries < 2);
+        convHelper = CONV_None;
+        if (error)
+        {
+            logprint (LOG_ERROR, "ERROR: %s: no convergence at t = %.3e\n",
+                      getName (), (double) current);
+            return -1;
+        }
+
+        statIterations += iterations;
+        nextStates ();
+        adjustOrder ();
+        if (keep) orbit.push_back (*x);
+    }
+    xT = *x;
+    return 0;
+}
+
+/* The function solves (I - M) dx = r by the GMRES method.  M is the
+   monodromy matrix of the period starting at x0 and ending at xT, its
+   products with a vector v are approximated by the difference of the
+   periods starting at x0 + h * v and x0.  The perturbation h must be
+   large compared to the tolerances of the time-steps.  Returns the
+   number of iterations or -1 on errors. */
+int psssolver::gmres (tvector<nr_double_t> & x0, tvector<nr_double_t> & xT,
+                      tvector<nr_double_t> & r, tvector<nr_double_t> & dx)
+{
+    int n = r.size ();
+    int m = std::min (getPropertyInteger ("Krylov"), n);
+    nr_double_t beta = std::sqrt (norm (r));
+    nr_double_t h = 1e-4 * (1 + std::sqrt (maxnorm (x0)));
+
+    dx.set (0.0);
+    if (beta == 0) return 0;
+
+    std::vector< tvector<nr_double_t> > V (m + 1);
+    std::vector< std::vector<nr_double_t> > H (m + 1,
+                                               std::vector<nr_double_t> (m));
+    std::vector<nr_double_t> cs (m), sn (m), g (m + 1, 0.0);
+    tvector<nr_double_t> xp (n), w (n);
+
+    V[0] = r * (1 / beta);
+    g[0] = beta;
+    int i, j, k = 0;
+    for (j = 0; j < m; j++)
+    {
+        // w = (I - M) v
+        xp = x0 + h * V[j];
+        if (integratePeriod (xp, w, MODE_INIT | MODE_RESTART)) return -1;
+        w = V[j] - (w - xT) * (1 / h);
+
+        // modified Gram-Schmidt orthogonalization
+        for (i = 0; i <= j; i++)
+        {
+            H[i][j] = scalar (w, V[i]);
+            w -= H[i][j] * V[i];
+        }
+        H[j + 1][j] = std::sqrt (norm (w));
+        if (H[j + 1][j] != 0) V[j + 1] = w * (1 / H[j + 1][j]);
+
+        // apply the previous Givens rotations and create a new one
+        for (i = 0; i < j; i++)
+        {
+            nr_double_t t = cs[i] * H[i][j] + sn[i] * H[i + 1][j];
+            H[i + 1][j] = -sn[i] * H[i][j] + cs[i] * H[i + 1][j];
+            H[i][j] = t;
+        }
+        nr_double_t d = std::hypot (H[j][j], H[j + 1][j]);
+        cs[j] = H[j][j] / d;
+        sn[j] = H[j + 1][j] / d;
+        H[j][j] = d;
+        H[j + 1][j] = 0;
+        g[j + 1] = -sn[j] * g[j];
+        g[j] = cs[j] * g[j];
+
+        k = j + 1;
+        if (std::fabs (g[k]) <= 1e-3 * beta || H[k][j] == 0) break;
+    }
+
+    // solve the triangular system and form the update
+    std::vector<nr_double_t> y (k);
+    for (i = k - 1; i >= 0; i--)
+    {
+        nr_double_t s = g[i];
+        for (j = i + 1; j < k; j++) s -= H[i][j] * y[j];
+        y[i] = s / H[i][i];
+    }
+    for (i = 0; i < k; i++) dx += y[i] * V[i];
+    return k;
+}
+
+/* Checks whether the given solutions at the beginning and the end of a
+   period are equal within the tolerances. */
+bool psssolver::isPeriodic (tvector<nr_double_t> & x0,
+                            tvector<nr_double_t> & xT)
+{
+    nr_double_t reltol = getPropertyDouble ("reltol");
+    nr_double_t abstol = getPropertyDouble ("abstol");
+    nr_double_t vntol = getPropertyDouble ("vntol");
+    int N = countNodes ();
+    for (int r = 0; r < (int) x0.size (); r++)
+    {
+        nr_double_t a = x0.get (r), b = xT.get (r);
+        nr_double_t tol = reltol * std::max (std::fabs (a), std::fabs (b)) +
+            (r < N ? vntol : abstol);
+        if (std::fabs (a - b) > tol) return false;
+    }
+    return true;
+}
+
+/* This function saves the steady-state period and its harmonics into
+   the output dataset. */
+void psssolver::saveAllResults (void)
+{
+    qucs::vector * t, * f;
+    int harmonics = std::min (getPropertyInteger ("Harmonics"), points / 2);
+
+    // add the time and frequency dependencies
+    if ((t = data->findDependency ("psstime")) == NULL)
+    {
+        t = new qucs::vector ("psstime");
+        data->addDependency (t);
+    }
+    if ((f = data->findDependency ("pssfrequency")) == NULL)
+    {
+        f = new qucs::vector ("pssfrequency");
+        data->addDependency (f);
+    }
+    if (runs == 1)
+    {
+        for (int n = 0; n <= points; n++) t->add (n * delta);
+        for (int k = 0; k <= harmonics; k++) f->add (k / period);
+    }
+
+    // save the solutions of the period
+    for (auto & s : orbit)
+    {
+        *x = s;
+        saveSolution ();
+        saveCursor = 0;
+        saveResults ("Vp", "Ip", 0, t);
+    }
+
+    // save the harmonics of the node voltages and branch currents
+    int N = countNodes ();
+    int M = countVoltageSources ();
+    for (int r = 0; r < N + M; r++)
+    {
+        std::string n = r < N ? createV (r, "Vh", 0) : createI (r - N, "Ih", 0);
+        if (n.empty ()) continue;
+        for (int k = 0; k <= harmonics; k++)
+        {
+            nr_complex_t c = 0.0;
+            for (int s = 0; s < points; s++)
+                c += orbit[s].get (r) * std::polar (1.0, -2 * pi * k * s / points);
+            c *= (k == 0 ? 1.0 : 2.0) / points;
+            saveVariable (n, c, f);
+        }
+    }
+}
+
+/* Saves the given variable into the dataset, there is no output
+   filter as for the transient analysis. */
+void psssolver::saveVariable (const std::string &n, nr_complex_t z,
+                              qucs::vector * f)
+{
+    analysis::saveVariable (n, z, f);
+}
+
+// properties
+PROP_REQ [] =
+{
+    { "f", PROP_REAL, { 1e6, PROP_NO_STR }, PROP_POS_RANGEX },
+    PROP_NO_PROP
+};
+PROP_OPT [] =
+{
+    { "Points", PROP_INT, { 200, PROP_NO_STR }, PROP_MIN_VAL (8) },
+    { "Periods", PROP_INT, { 2, PROP_NO_STR }, PROP_MIN_VAL (0) },
+    { "Harmonics", PROP_INT, { 8, PROP_NO_STR }, PROP_MIN_VAL (0) },
+    { "ShootIter", PROP_INT, { 20, PROP_NO_STR }, PROP_RNGII (1, 1000) },
+    { "Krylov", PROP_INT, { 30, PROP_NO_STR }, PROP_RNGII (1, 1000) },
+    {
+        "IntegrationMethod", PROP_STR, { PROP_NO_VAL, "Gear" },
+        PROP_RNG_STR3 ("Euler", "Trapezoidal", "Gear")
+    },
+    { "Order", PROP_INT, { 2, PROP_NO_STR }, PROP_RNGII (1, 6) },
+    { "MaxIter", PROP_INT, { 150, PROP_NO_STR }, PROP_RNGII (2, 10000) },
+    { "abstol", PROP_REAL, { 1e-12, PROP_NO_STR }, PROP_RNG_X01I },
+    { "vntol", PROP_REAL, { 1e-6, PROP_NO_STR }, PROP_RNG_X01I },
+    { "reltol", PROP_REAL, { 1e-4, PROP_NO_STR }, PROP_RNG_X01I },
+    { "Temp", PROP_REAL, { 26.85, PROP_NO_STR }, PROP_MIN_VAL (K) },
+    { "Solver", PROP_STR, { PROP_NO_VAL, "CroutLU" }, PROP_RNG_SOL },
+    { "Ordering", PROP_STR, { PROP_NO_VAL, "none" }, PROP_RNG_ORD },
+    { "initialDC", PROP_STR, { PROP_NO_VAL, "yes" }, PROP_RNG_YESNO },
+    PROP_NO_PROP
+};
+struct define_t psssolver::anadef =
+    { "PSS", 0, PROP_ACTION, PROP_NO_SUBSTRATE, PROP_LINEAR, PROP_DEF };
+
+} // namespace qucs
@@ -0,0 +1,69 @@
+/*
+ * psssolver.h - periodic steady-state solver class definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __PSSSOLVER_H__
+#define __PSSSOLVER_H__
+
+#include <string>
+#include <vector>
+
+#include "trsolver.h"
+
+namespace qucs {
+
+/*!\brief Periodic steady-state solver
+
+   The solver finds the periodic steady state of a circuit driven with
+   the given fundamental frequency by the shooting method.  A period
+   is integrated by the transient solver with fixed time-steps, the
+   Newton iteration on the periodic boundary condition x(T) = x(0)
+   solves its linear systems (I - M) dx = x(T) - x(0) by GMRES.  The
+   monodromy matrix M = dx(T)/dx(0) is never formed, its products with
+   the Krylov vectors are finite differences of perturbed periods.
+*/
+class psssolver : public trsolver
+{
+public:
+    ACREATOR (psssolver);
+    psssolver (const std::string &name);
+    psssolver (psssolver &);
+    ~psssolver ();
+    int  solve (void);
+    void initPSS (void);
+    int  integratePeriod (tvector<nr_double_t> &, tvector<nr_double_t> &,
+                          int, bool keep = false);
+    int  gmres (tvector<nr_double_t> &, tvector<nr_double_t> &,
+                tvector<nr_double_t> &, tvector<nr_double_t> &);
+    bool isPeriodic (tvector<nr_double_t> &, tvector<nr_double_t> &);
+    void saveAllResults (void);
+    void saveVariable (const std::string &, nr_complex_t, qucs::vector *);
+
+private:
+    nr_double_t period;
+    int points;
+    int periods;      // number of integrated periods
+    std::vector< tvector<nr_double_t> > orbit;
+};
+
+} // namespace qucs
+
+#endif /* __PSSSOLVER_H__ */
@@ -0,0 +1,373 @@
+/*
+ * rconv.cpp - recursive convolution transient models implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <cmath>
+#include <algorithm>
+
+#include "object.h"
+#include "complex.h"
+#include "logging.h"
+#include "circuit.h"
+#include "vectorfit.h"
+#include "rconv.h"
+
+// Fitting of the S-parameters of N-ports.
+#define NPORT_FMIN    1e6
+#define NPORT_FMAX    100e9
+#define NPORT_SAMPLES 200
+
+// Fitting of the transmission line functions.
+#define LINE_FMIN     1
+#define LINE_DECADE   10
+
+#define RCONV_POLES   30
+#define RCONV_TOL     1e-3
+
+namespace qucs {
+
+// Constructor creates an empty recursive convolution.
+rconv::rconv () {
+  outputs = inputs = 0;
+  offset = 0;
+}
+
+// Destructor deletes the recursive convolution.
+rconv::~rconv () {
+}
+
+/* The function takes the poles and residues of the given fit.  The
+   transfer from input i to output o is the response index[o * inputs
+   + i] of the fit, or zero for negative indices. */
+void rconv::setModel (vectorfit & vf, int o, int i, const int * index) {
+  outputs = o;
+  inputs = i;
+  poles = vf.poles;
+  int np = (int) poles.size ();
+  res.assign (np * outputs * inputs, 0.0);
+  d.assign (outputs * inputs, 0.0);
+  for (int k = 0; k < outputs * inputs; k++) {
+    int m = index[k];
+    if (m < 0) continue;
+    d[k] = vf.d[m];
+    for (int p = 0; p < np; p++) res[p * outputs * inputs + k] = vf.res[m][p];
+  }
+}
+
+/* Returns the number of save-states needed, the previous inputs and
+   the real and imaginary parts of the state of each pole and
+   input. */
+int rconv::getStates (void) {
+  return inputs + 2 * (int) poles.size () * inputs;
+}
+
+/* The function initializes the states to the steady state for the
+   constant inputs u, the companion model is the DC transfer then. */
+void rconv::initState (integrator * c, nr_double_t * u, nr_double_t * G,
+		       nr_double_t * y) {
+  for (int k = 0; k < outputs * inputs; k++) G[k] = d[k];
+  for (int o = 0; o < outputs; o++) y[o] = 0;
+  for (int i = 0; i < inputs; i++) c->setState (offset + i, u[i]);
+
+  for (size_t p = 0; p < poles.size (); p++) {
+    nr_complex_t pole = poles[p];
+    nr_double_t w = imag (pole) == 0 ? 1 : 2;
+    for (int i = 0; i < inputs; i++) {
+      nr_complex_t x = -u[i] / pole;
+      int s = offset + inputs + 2 * (p * inputs + i);
+      c->setState (s, real (x));
+      c->setState (s + 1, imag (x));
+      for (int o = 0; o < outputs; o++)
+	G[o * inputs + i] -= w * real (res[(p * outputs + o) * inputs + i] / pole);
+    }
+  }
+}
+
+/* The function advances the states from the previous time-step over
+   the step h to the inputs u and computes the companion model.  With
+   z = p h the state is x1 = exp(z) x0 + (q0 - q1) u0 + q1 u1, where
+   q0 = h (exp(z) - 1) / z and q1 = h (exp(z) - 1 - z) / z^2. */
+void rconv::calcState (integrator * c, nr_double_t h, nr_double_t * u,
+		       nr_double_t * G, nr_double_t * y) {
+  for (int k = 0; k < outputs * inputs; k++) G[k] = d[k];
+  for (int o = 0; o < outputs; o++) y[o] = 0;
+
+  for (size_t p = 0; p < poles.size (); p++) {
+    nr_complex_t pole = poles[p];
+    nr_double_t w = imag (pole) == 0 ? 1 : 2;
+    nr_complex_t z = pole * h, e = std::exp (z), q0, q1;
+    if (std::abs (z) < 1e-3) {
+      q0 = h * (1.0 + z / 2.0 + z * z / 6.0);
+      q1 = h * (0.5 + z / 6.0 + z * z / 24.0);
+    } else {
+      q0 = h * (e - 1.0) / z;
+      q1 = h * (e - 1.0 - z) / (z * z);
+    }
+    for (int i = 0; i < inputs; i++) {
+      int s = offset + inputs + 2 * (p * inputs + i);
+      nr_complex_t x0 (c->getState (s, 1), c->getState (s + 1, 1));
+      nr_double_t u0 = c->getState (offset + i, 1);
+      // the part known from the previous step
+      nr_complex_t xh = e * x0 + (q0 - q1) * u0;
+      nr_complex_t x1 = xh + q1 * u[i];
+      c->setState (s, real (x1));
+      c->setState (s + 1, imag (x1));
+      for (int o = 0; o < outputs; o++) {
+	nr_complex_t r = res[(p * outputs + o) * inputs + i];
+	G[o * inputs + i] += w * real (r * q1);
+	y[o] += w * real (r * xh);
+      }
+    }
+  }
+  for (int i = 0; i < inputs; i++) c->setState (offset + i, u[i]);
+}
+
+// Constructor creates an unused N-port model.
+rconvnport::rconvnport () {
+  ports = 0;
+}
+
+// Destructor deletes the N-port model.
+rconvnport::~rconvnport () {
+}
+
+/* The function samples the S-parameters of the given circuit, fits
+   them and sets up its MNA matrices with a voltage source per port.
+   Returns non-zero if the fit failed, the circuit should use its DC
+   model then. */
+int rconvnport::initTR (circuit * c) {
+  int n = c->getSize ();
+  std::vector<nr_double_t> f;
+  std::vector< std::vector<nr_complex_t> > s (n * n);
+
+  ports = 0;
+  c->setConvolved (false);
+  c->initSP ();
+  for (int k = 0; k < NPORT_SAMPLES; k++) {
+    nr_double_t x = (nr_double_t) k / (NPORT_SAMPLES - 1);
+    f.push_back (NPORT_FMIN * std::pow (NPORT_FMAX / NPORT_FMIN, x));
+    c->calcSP (f.back ());
+    for (int i = 0; i < n * n; i++) s[i].push_back (c->getS (i / n, i % n));
+  }
+
+  vectorfit vf;
+  vf.setData (f, s);
+  if (vf.fitOrder (RCONV_POLES, RCONV_TOL) < 0) {
+    logprint (LOG_ERROR, "WARNING: %s: no transient model, using the DC "
+	      "model\n", c->getName ());
+    return -1;
+  }
+  if (vf.getError () > RCONV_TOL) {
+    logprint (LOG_ERROR, "WARNING: %s: transient model fitted with a "
+	      "relative error of %g\n", c->getName (), (double) vf.getError ());
+  }
+
+  std::vector<int> index (n * n);
+  for (int i = 0; i < n * n; i++) index[i] = i;
+  conv.setModel (vf, n, n, index.data ());
+  conv.setStateOffset (0);
+  ports = n;
+
+  c->setStates (conv.getStates ());
+  c->setConvolved (true);
+  c->setVoltageSources (n);
+  c->allocMatrixMNA ();
+  for (int k = 0; k < n; k++) c->setB (k, k, +1);
+  return 0;
+}
+
+/* The function computes the companion model of the N-port for the
+   current time-step.  The incident waves a = v + z0 i are the inputs,
+   the reflected waves b = v - z0 i = G a + y the outputs. */
+void rconvnport::calcTR (circuit * c) {
+  if (ports == 0) return;
+  nr_double_t z0 = circuit::z0;
+  std::vector<nr_double_t> a (ports), G (ports * ports), y (ports);
+  for (int k = 0; k < ports; k++)
+    a[k] = real (c->getV (k)) + z0 * real (c->getJ (k));
+
+  if (c->getMode () & MODE_INIT)
+    conv.initState (c, a.data (), G.data (), y.data ());
+  else
+    conv.calcState (c, c->getDelta ()[0], a.data (), G.data (), y.data ());
+
+  for (int k = 0; k < ports; k++) {
+    for (int m = 0; m < ports; m++) {
+      nr_double_t g = G[k * ports + m], e = (k == m) ? 1 : 0;
+      c->setC (k, m, e - g);
+      c->setD (k, m, -z0 * (e + g));
+    }
+    c->setE (k, y[k]);
+  }
+}
+
+// Constructor creates an unused transmission line model.
+rconvline::rconvline () {
+  ports = 0;
+  ref[0] = ref[1] = -1;
+  delay = 0;
+}
+
+// Destructor deletes the transmission line model.
+rconvline::~rconvline () {
+}
+
+// Returns the current voltage of the given port.
+nr_double_t rconvline::voltage (circuit * c, int port) {
+  nr_double_t v = real (c->getV (port));
+  if (ref[port] >= 0) v -= real (c->getV (ref[port]));
+  return v;
+}
+
+// Returns the voltage of the given port at the given time.
+nr_double_t rconvline::voltage (circuit * c, int port, nr_double_t t) {
+  nr_double_t v = c->getV (port, t);
+  if (ref[port] >= 0) v -= c->getV (ref[port], t);
+  return v;
+}
+
+/* The function samples the characteristic impedance and propagation
+   constant of the line of the given length, fits Zc, H and H Zc and
+   sets up the MNA matrices and the history of the circuit.  Returns
+   non-zero if a fit failed, the circuit should use its DC model
+   then. */
+int rconvline::initTR (circuit * c, nr_double_t len,
+		       propagation_t propagation, nr_double_t fmax,
+		       int ref1, int ref2) {
+  std::vector<nr_double_t> f;
+  std::vector<nr_complex_t> gamma, zl;
+  ref[0] = ref1;
+  ref[1] = ref2;
+  ports = 0;
+  c->setConvolved (false);
+  c->deleteHistory ();
+
+  // sample the line, the delay is the smallest phase delay
+  int samples = (int) (LINE_DECADE * std::log10 (fmax / LINE_FMIN)) + 1;
+  delay = NR_MAX;
+  for (int k = 0; k < samples; k++) {
+    nr_double_t x = (nr_double_t) k / (samples - 1);
+    nr_complex_t g, z;
+    f.push_back (LINE_FMIN * std::pow (fmax / LINE_FMIN, x));
+    propagation (f.back (), g, z);
+    gamma.push_back (g);
+    zl.push_back (z);
+    delay = std::min (delay, imag (g) * len / (2 * pi * f.back ()));
+  }
+  if (!(delay > 0) || delay == NR_MAX) delay = 0;
+
+  std::vector< std::vector<nr_complex_t> > dz (1), dh (1), dhz (1);
+  for (int k = 0; k < samples; k++) {
+    nr_complex_t e = std::exp (-gamma[k] * len +
+			       nr_complex_t (0, 2 * pi * f[k] * delay));
+    dz[0].push_back (zl[k]);
+    dh[0].push_back (e);
+    dhz[0].push_back (e * zl[k]);
+  }
+
+  vectorfit fz, fh, fhz;
+  fz.setData (f, dz);
+  fh.setData (f, dh);
+  fhz.setData (f, dhz);
+  if (fz.fitOrder (RCONV_POLES, RCONV_TOL) < 0 ||
+      fh.fitOrder (RCONV_POLES, RCONV_TOL) < 0 ||
+      fhz.fitOrder (RCONV_POLES, RCONV_TOL) < 0) {
+    logprint (LOG_ERROR, "WARNING: %s: no transient model, using the DC "
+	      "model\n", c->getName ());
+    return -1;
+  }
+  nr_double_t err = std::max (fz.getError (),
+			      std::max (fh.getError (), fhz.getError ()));
+  if (err > RCONV_TOL) {
+    logprint (LOG_ERROR, "WARNING: %s: transient model fitted with a "
+	      "relative error of %g\n", c->getName (), (double) err);
+  }
+
+  static const int diagonal[] = { 0, -1, -1, 0 };
+  static const int crossed[] = { -1, 0, 0, -1 };
+  zc.setModel (fz, 2, 2, diagonal);
+  hv.setModel (fh, 2, 2, crossed);
+  hz.setModel (fhz, 2, 2, crossed);
+  zc.setStateOffset (0);
+  hv.setStateOffset (zc.getStates ());
+  hz.setStateOffset (zc.getStates () + hv.getStates ());
+  c->setStates (zc.getStates () + hv.getStates () + hz.getStates ());
+  c->setConvolved (true);
+
+  c->setVoltageSources (2);
+  c->allocMatrixMNA ();
+  c->setHistory (true);
+  c->initHistory (delay);
+  for (int k = 0; k < 2; k++) {
+    c->setB (k, k, +1); c->setC (k, k, +1);
+    if (ref[k] >= 0) {
+      c->setB (ref[k], k, -1); c->setC (k, ref[k], -1);
+    }
+  }
+  ports = 2;
+  return 0;
+}
+
+/* The function computes the voltage sources of the ports for the
+   current time-step.  At the initial DC solution the delayed values
+   are the current ones. */
+void rconvline::calcTR (circuit * c, nr_double_t t) {
+  nr_double_t j[2], vd[2], jd[2];
+  nr_double_t Gz[4], yz[2], Gv[4], yv[2], Gj[4], yj[2];
+  if (ports == 0) return;
+  for (int k = 0; k < 2; k++) j[k] = real (c->getJ (k));
+
+  if (c->getMode () & MODE_INIT) {
+    for (int k = 0; k < 2; k++) {
+      vd[k] = voltage (c, k);
+      jd[k] = j[k];
+    }
+    zc.initState (c, j, Gz, yz);
+    hv.initState (c, vd, Gv, yv);
+    hz.initState (c, jd, Gj, yj);
+  } else {
+    nr_double_t T = t - delay, h = c->getDelta ()[0];
+    for (int k = 0; k < 2; k++) {
+      vd[k] = voltage (c, k, T);
+      jd[k] = c->getJ (k, T);
+    }
+    zc.calcState (c, h, j, Gz, yz);
+    hv.calcState (c, h, vd, Gv, yv);
+    hz.calcState (c, h, jd, Gj, yj);
+  }
+
+  // v - Zc i = H (v + Zc i) delayed, with the companion models
+  for (int k = 0; k < 2; k++) {
+    nr_double_t e = yz[k] + yv[k] + yj[k];
+    for (int m = 0; m < 2; m++) {
+      e += Gv[k * 2 + m] * vd[m] + Gj[k * 2 + m] * jd[m];
+      c->setD (k, m, -Gz[k * 2 + m]);
+    }
+    c->setE (k, e);
+  }
+}
+
+} // namespace qucs
@@ -0,0 +1,142 @@
+/*
+ * rconv.h - recursive convolution transient models definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __RCONV_H__
+#define __RCONV_H__
+
+#include <vector>
+#include <functional>
+
+namespace qucs {
+
+class circuit;
+class integrator;
+class vectorfit;
+
+/*!\brief Recursive convolution of a rational transfer function
+
+   The class applies a transfer matrix in pole-residue form
+
+     H(s) = D + sum_i R_i / (s - p_i)
+
+   to the input signals u of a circuit during a transient analysis.
+   For each pole and input there is a state x' = p x + u, which is
+   advanced over a time-step h exactly assuming the input varies
+   linearly within the step.  This costs O(1) per step and pole
+   instead of a convolution over the whole history.  The states live
+   in the save-states of the circuit, thus rejected steps are simply
+   recomputed.  The output is returned as companion model y = G u + y0,
+   with u the input at the end of the step.
+*/
+class rconv
+{
+ public:
+  rconv ();
+  ~rconv ();
+
+  void setModel (vectorfit &, int, int, const int *);
+  int  getStates (void);
+  void setStateOffset (int o) { offset = o; }
+  int  getInputs (void) { return inputs; }
+  int  getOutputs (void) { return outputs; }
+  int  getPoles (void) { return (int) poles.size (); }
+  void initState (integrator *, nr_double_t *, nr_double_t *, nr_double_t *);
+  void calcState (integrator *, nr_double_t, nr_double_t *, nr_double_t *,
+		  nr_double_t *);
+
+ private:
+  int outputs;
+  int inputs;
+  int offset;
+  std::vector<nr_complex_t> poles;   // real poles and upper ones of pairs
+  std::vector<nr_complex_t> res;     // residues [pole][output][input]
+  std::vector<nr_double_t> d;        // constant terms [output][input]
+};
+
+/*!\brief Transient model of a linear N-port from its S-parameters
+
+   The S-parameters of a circuit are sampled at initTR(), fitted with
+   common poles and applied by recursive convolution to the incident
+   waves a = v + z0 i of the ports.  Each port is a voltage source with
+   v - z0 i = b, the reflected wave.  The model suits the microstrip
+   discontinuities and other components which only provide calcSP().
+*/
+class rconvnport
+{
+ public:
+  rconvnport ();
+  ~rconvnport ();
+
+  int  initTR (circuit *);
+  void calcTR (circuit *);
+  int  getPoles (void) { return conv.getPoles (); }
+
+ private:
+  rconv conv;
+  int ports;
+};
+
+/*!\brief Transient model of a lossy, dispersive transmission line
+
+   The model uses the method of characteristics.  The characteristic
+   impedance Zc(s) and the propagation function H(s) = exp (-gamma l)
+   with its delay tau removed are fitted at initTR(), then each port
+   becomes a voltage source
+
+     v1 - Zc * i1 = H * (v2 + Zc * i2) (t - tau)
+
+   where the convolutions are recursive and the delayed values are
+   taken from the circuit history.  The line is described by a
+   function returning gamma and Zc for a given frequency, which is
+   sampled up to the given maximum frequency.  The ports are between
+   the first two nodes and ground or the given reference nodes.
+*/
+class rconvline
+{
+ public:
+  typedef std::function<void (nr_double_t, nr_complex_t &,
+			      nr_complex_t &)> propagation_t;
+
+  rconvline ();
+  ~rconvline ();
+
+  int  initTR (circuit *, nr_double_t, propagation_t,
+	       nr_double_t fmax = 100e9, int ref1 = -1, int ref2 = -1);
+  void calcTR (circuit *, nr_double_t);
+  nr_double_t getDelay (void) { return delay; }
+
+ private:
+  nr_double_t voltage (circuit *, int);
+  nr_double_t voltage (circuit *, int, nr_double_t);
+
+ private:
+  int ports;  // zero if unused
+  int ref[2]; // reference nodes of the ports, or -1 for ground
+  rconv zc;   // characteristic impedance on the port currents
+  rconv hv;   // propagation on the delayed voltages of the far port
+  rconv hz;   // propagation times impedance on the delayed currents
+  nr_double_t delay;
+};
+
+} // namespace qucs
+
+#endif /* __RCONV_H__ */
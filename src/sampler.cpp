@@ -0,0 +1,116 @@
+/*
+ * sampler.cpp - random circuit parameters implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <cmath>
+
+#include "constants.h"
+#include "sampler.h"
+
+namespace qucs {
+
+enum { SAMPLE_NOMINAL, SAMPLE_RANDOM, SAMPLE_CORNER };
+
+int sampler::mode = SAMPLE_NOMINAL;
+unsigned long sampler::seed = 0;
+unsigned long sampler::index = 0;
+int sampler::draws = 0;
+std::mt19937_64 sampler::rng;
+
+// Returns the nominal values from now on.
+void sampler::nominal (void) {
+  mode = SAMPLE_NOMINAL;
+  restart ();
+}
+
+// Draws random values for the given seed and sample number.
+void sampler::random (unsigned long s, unsigned long sample) {
+  mode = SAMPLE_RANDOM;
+  seed = s;
+  index = sample;
+  restart ();
+}
+
+// Returns the limits of the parameters selected by the corner number.
+void sampler::corner (unsigned long c) {
+  mode = SAMPLE_CORNER;
+  index = c;
+  restart ();
+}
+
+/* The function rewinds the parameter stream of the current sample.
+   The draws are counted in any mode, thus the number of random
+   parameters is known after a nominal run of the equation solver. */
+void sampler::restart (void) {
+  draws = 0;
+  if (mode == SAMPLE_RANDOM) {
+    std::seed_seq s { (unsigned) seed, (unsigned) (seed >> 16 >> 16),
+		      (unsigned) index, (unsigned) (index >> 16 >> 16) };
+    rng.seed (s);
+  }
+}
+
+// Returns a uniformly distributed number in [0,1) with 53 random bits.
+nr_double_t sampler::uniform (void) {
+  return (rng () >> 11) / 9007199254740992.0;
+}
+
+/* Returns a standard normal distributed number by the Box-Muller
+   transform.  Unlike std::normal_distribution it gives the same
+   numbers on any platform. */
+nr_double_t sampler::normal (void) {
+  nr_double_t u1 = 1.0 - uniform ();
+  nr_double_t u2 = uniform ();
+  return std::sqrt (-2.0 * std::log (u1)) * std::cos (2.0 * pi * u2);
+}
+
+/* The function returns a value of the given distribution with the
+   given nominal value and spread.  Corners are at plus or minus three
+   deviations for the normal distributions and at the interval limits
+   for the uniform one. */
+nr_double_t sampler::draw (int type, nr_double_t nom, nr_double_t spread) {
+  int k = draws++;
+  nr_double_t x;
+  switch (mode) {
+  case SAMPLE_RANDOM:
+    if (type == UNIFORM)
+      x = 2.0 * uniform () - 1.0;
+    else
+      x = normal ();
+    break;
+  case SAMPLE_CORNER:
+    if (k >= 64) return nom;
+    x = ((index >> k) & 1) ? 1.0 : -1.0;
+    if (type != UNIFORM) x *= 3.0;
+    break;
+  default:
+    return nom;
+  }
+  if (type == LOGNORMAL)
+    return nom * std::exp (spread * x);
+  return nom + spread * x;
+}
+
+} // namespace qucs
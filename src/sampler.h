@@ -0,0 +1,73 @@
+/*
+ * sampler.h - random circuit parameters definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __SAMPLER_H__
+#define __SAMPLER_H__
+
+#include <random>
+
+namespace qucs {
+
+/*!\brief Source of random circuit parameters
+
+   The equation functions gauss(), uniform() and lognormal() draw
+   their values from here.  Outside of a Monte-Carlo analysis they
+   return the nominal value.  In a Monte-Carlo sample the values come
+   from a stream seeded by the seed and the sample number only, thus
+   each sample is reproducible regardless of how the samples are
+   distributed over worker processes.  The stream is restarted at
+   each run of the equation solver, so all runs within a sample (e.g.
+   the points of a nested parameter sweep) see the same values.  In a
+   corner run the k-th drawn parameter is at its lower or upper limit
+   depending on bit k of the corner number.
+*/
+class sampler
+{
+ public:
+  enum distribution {
+    GAUSS,      // normal distribution with the given deviation
+    UNIFORM,    // uniform distribution with the given half width
+    LOGNORMAL   // nominal times exp() of a normal one
+  };
+
+  static void nominal (void);
+  static void random (unsigned long, unsigned long);
+  static void corner (unsigned long);
+  static void restart (void);
+  static int  getDraws (void) { return draws; }
+  static nr_double_t draw (int, nr_double_t, nr_double_t);
+
+ private:
+  static nr_double_t uniform (void);
+  static nr_double_t normal (void);
+
+ private:
+  static int mode;
+  static unsigned long seed;
+  static unsigned long index;
+  static int draws;
+  static std::mt19937_64 rng;
+};
+
+} // namespace qucs
+
+#endif /* __SAMPLER_H__ */
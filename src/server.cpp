@@ -0,0 +1,281 @@
+/*
+ * server.cpp - persistent simulation server class implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#ifndef __MINGW32__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <signal.h>
+#endif
+
+#include "logging.h"
+#include "component.h"
+#include "components.h"
+#include "net.h"
+#include "input.h"
+#include "dataset.h"
+#include "variable.h"
+#include "environment.h"
+#include "exceptionstack.h"
+#include "check_netlist.h"
+#include "server.h"
+
+namespace qucs {
+
+// Constructor creates a server without a netlist.
+server::server () {
+  subnet = NULL;
+  in = NULL;
+  root = NULL;
+  shutdown = 0;
+}
+
+// Destructor deletes the server and its cached netlist.
+server::~server () {
+  unload ();
+}
+
+/* Deletes the currently cached netlist along with its environments,
+   the same way the main program does after a single run. */
+void server::unload (void) {
+  delete subnet;
+  delete in;
+  delete root;
+  subnet = NULL;
+  in = NULL;
+  root = NULL;
+  netlist_destroy_env ();
+}
+
+/* This function parses, checks and builds the given netlist and keeps
+   it for the following jobs.  A previously loaded netlist gets
+   replaced. */
+int server::load (const char * file, FILE * out) {
+  FILE * f;
+
+  unload ();
+
+  // the input object falls back to stdin, so check the file here
+  if ((f = fopen (file, "r")) == NULL) {
+    fprintf (out, "error cannot open file `%s': %s\n", file, strerror (errno));
+    return -1;
+  }
+  fclose (f);
+
+  // create root environment, netlist object and input
+  root = new environment (std::string ("root"));
+  subnet = new net ("subnet");
+  in = new input ((char *) file);
+  subnet->setEnv (root);
+  in->setEnv (root);
+
+  // get input netlist
+  if (in->netlist (subnet) != 0) {
+    netlist_destroy ();
+    unload ();
+    fprintf (out, "error netlist check failed\n");
+    return -1;
+  }
+
+  // attach a ground to the netlist
+  circuit * gnd = new ground ();
+  gnd->setNode (0, "gnd");
+  gnd->setName ("GND");
+  subnet->insertCircuit (gnd);
+
+  fprintf (out, "ok\n");
+  return 0;
+}
+
+/* Changes the value of the given netlist variable in the root
+   environment.  This works like a parameter sweep, i.e. the new
+   value is seen by the equation solver before the next run. */
+int server::set (const char * name, const char * value, FILE * out) {
+  char * end;
+
+  if (root == NULL) {
+    fprintf (out, "error no netlist loaded\n");
+    return -1;
+  }
+  if (root->getVariable (name) == NULL) {
+    fprintf (out, "error no such variable `%s'\n", name);
+    return -1;
+  }
+  nr_double_t v = strtod (value, &end);
+  if (end == value || *end != '\0') {
+    fprintf (out, "error invalid value `%s'\n", value);
+    return -1;
+  }
+
+  root->setDoubleConstant (name, v);
+  root->setDouble (name, v);
+  fprintf (out, "ok\n");
+  return 0;
+}
+
+/* Runs the analyses of the cached netlist, either all or only the
+   named one, and sends back the resulting dataset. */
+int server::run (const char * name, FILE * out) {
+  FILE * tmp;
+  int err = 0;
+
+  if (subnet == NULL) {
+    fprintf (out, "error no netlist loaded\n");
+    return -1;
+  }
+  if (name != NULL && subnet->findAnalysis (name) == NULL) {
+    fprintf (out, "error no such analysis `%s'\n", name);
+    return -1;
+  }
+  if ((tmp = tmpfile ()) == NULL) {
+    fprintf (out, "error cannot create temporary file: %s\n",
+	     strerror (errno));
+    return -1;
+  }
+
+  // analyse the netlist and evaluate the output dataset
+  dataset * data = subnet->runAnalysis (err, name);
+  err |= root->equationSolver (data);
+  data->print (tmp);
+  delete data;
+  estack.print ("uncaught");
+
+  // pass the dataset back
+  long bytes = ftell (tmp);
+  rewind (tmp);
+  fprintf (out, "dataset %ld %d\n", bytes, err);
+  char buf[4096];
+  size_t n;
+  while ((n = fread (buf, 1, sizeof (buf), tmp)) > 0)
+    if (fwrite (buf, 1, n, out) != n) break;
+  fclose (tmp);
+  return err;
+}
+
+/* Executes a single job line. */
+int server::job (char * line, FILE * out) {
+  const char * sep = " \t\r\n";
+  char * cmd = strtok (line, sep);
+  char * arg1 = strtok (NULL, sep);
+  char * arg2 = strtok (NULL, sep);
+
+  if (cmd == NULL || *cmd == '#')
+    return 0;
+  else if (!strcmp (cmd, "load") && arg1 != NULL)
+    return load (arg1, out);
+  else if (!strcmp (cmd, "set") && arg1 != NULL && arg2 != NULL)
+    return set (arg1, arg2, out);
+  else if (!strcmp (cmd, "run"))
+    return run (arg1, out);
+  fprintf (out, "error invalid job `%s'\n", cmd);
+  return -1;
+}
+
+/* Reads jobs from the given input stream until "quit", "shutdown" or
+   the end of the stream.  The connection is dropped if the replies
+   cannot be written.  The function returns non-zero if the server
+   should stop. */
+int server::serve (FILE * jobs, FILE * out) {
+  char line[4096];
+  while (fgets (line, sizeof (line), jobs) != NULL) {
+    if (!strncmp (line, "quit", 4))
+      break;
+    if (!strncmp (line, "shutdown", 8)) {
+      shutdown = 1;
+      break;
+    }
+    job (line, out);
+    if (fflush (out) != 0 || ferror (out)) {
+      logprint (LOG_ERROR, "cannot send reply, dropping connection: %s\n",
+		strerror (errno));
+      break;
+    }
+  }
+  return shutdown;
+}
+
+/* Listens on the given local socket and serves one client connection
+   at a time until a client requests the shutdown. */
+int server::listen (const char * path) {
+#ifdef __MINGW32__
+  logprint (LOG_ERROR, "local sockets are not supported, cannot listen "
+	    "on `%s'\n", path);
+  return -1;
+#else
+  struct sockaddr_un addr;
+  int fd;
+
+  if (strlen (path) >= sizeof (addr.sun_path)) {
+    logprint (LOG_ERROR, "socket path `%s' too long\n", path);
+    return -1;
+  }
+  if ((fd = socket (AF_UNIX, SOCK_STREAM, 0)) < 0) {
+    logprint (LOG_ERROR, "cannot create socket: %s\n", strerror (errno));
+    return -1;
+  }
+  memset (&addr, 0, sizeof (addr));
+  addr.sun_family = AF_UNIX;
+  strcpy (addr.sun_path, path);
+  unlink (path);
+  if (bind (fd, (struct sockaddr *) &addr, sizeof (addr)) < 0 ||
+      ::listen (fd, 1) < 0) {
+    logprint (LOG_ERROR, "cannot listen on `%s': %s\n", path,
+	      strerror (errno));
+    close (fd);
+    return -1;
+  }
+  logprint (LOG_STATUS, "listening on `%s'...\n", path);
+
+  // a client closing its connection early must not kill the server
+  signal (SIGPIPE, SIG_IGN);
+
+  while (!shutdown) {
+    int c = accept (fd, NULL, NULL);
+    if (c < 0) {
+      if (errno == EINTR) continue;
+      logprint (LOG_ERROR, "cannot accept connection: %s\n",
+		strerror (errno));
+      break;
+    }
+    FILE * jobs = fdopen (c, "r");
+    FILE * out = fdopen (dup (c), "w");
+    serve (jobs, out);
+    fclose (out);
+    fclose (jobs);
+  }
+
+  close (fd);
+  unlink (path);
+  return shutdown ? 0 : -1;
+#endif /* __MINGW32__ */
+}
+
+} // namespace qucs
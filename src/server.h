@@ -0,0 +1,74 @@
+/*
+ * server.h - persistent simulation server class definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __SERVER_H__
+#define __SERVER_H__
+
+#include <stdio.h>
+
+namespace qucs {
+
+class net;
+class input;
+class environment;
+
+/*!\brief Persistent simulation server
+
+   The server keeps a parsed and checked netlist in memory and runs
+   its analyses repeatedly.  Jobs are read line by line from a stream
+   or a local socket:
+
+     load <netlist>       parse, check and build the given netlist
+     set <name> <value>   change the value of a netlist variable
+     run [<analysis>]     run all analyses (or the named one)
+     quit                 close the current session
+     shutdown             stop the server
+
+   Each job is answered by a single line, either "ok" or "error
+   <text>".  A "run" job is answered by "dataset <bytes> <status>"
+   followed by the resulting dataset of the given size.
+*/
+class server
+{
+ public:
+  server ();
+  ~server ();
+  int serve (FILE *, FILE *);
+  int listen (const char *);
+
+ private:
+  int job (char *, FILE *);
+  int load (const char *, FILE *);
+  int set (const char *, const char *, FILE *);
+  int run (const char *, FILE *);
+  void unload (void);
+
+ private:
+  net * subnet;
+  input * in;
+  environment * root;
+  int shutdown;
+};
+
+} // namespace qucs
+
+#endif /* __SERVER_H__ */
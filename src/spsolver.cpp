@@ -37,6 +37,7 @@
 #include "circuit.h"
 #include "strlist.h"
 #include "vector.h"
+#include "matrix.h"
 #include "matvec.h"
 #include "dataset.h"
 #include "net.h"
@@ -44,8 +45,14 @@
 #include "sweep.h"
 #include "nodelist.h"
 #include "netdefs.h"
+#include "tvector.h"
+#include "tmatrix.h"
+#include "eqnsys.h"
+#include "exception.h"
+#include "exceptionstack.h"
 #include "characteristic.h"
 #include "spsolver.h"
+#include "profile.h"
 #include "constants.h"
 #include "components/component_id.h"
 #include "components/tee.h"
@@ -72,6 +79,11 @@ spsolver::spsolver () : analysis () {
   nlist = NULL;
   tees = crosses = opens = grounds = 0;
   gnd = NULL;
+  nodal = 0;
+  nnodes = nbranches = 0;
+  nA = NULL;
+  nx = nz = NULL;
+  neqns = NULL;
 }
 
 // Constructor creates a named instance of the spsolver class.
@@ -83,12 +95,21 @@ spsolver::spsolver (char * n) : analysis (n) {
   nlist = NULL;
   tees = crosses = opens = grounds = 0;
   gnd = NULL;
+  nodal = 0;
+  nnodes = nbranches = 0;
+  nA = NULL;
+  nx = nz = NULL;
+  neqns = NULL;
 }
 
 // Destructor deletes the spsolver class object.
 spsolver::~spsolver () {
   delete swp;
   delete nlist;
+  delete nA;
+  delete nx;
+  delete nz;
+  delete neqns;
 }
 
 /* The copy constructor creates a new instance of the spsolver class
@@ -103,6 +124,11 @@ spsolver::spsolver (spsolver & n) : analysis (n) {
   swp = n.swp ? new sweep (*n.swp) : NULL;
   nlist = n.nlist ? new nodelist (*n.nlist) : NULL;
   gnd = n.gnd;
+  nodal = n.nodal;
+  nnodes = nbranches = 0;
+  nA = NULL;
+  nx = nz = NULL;
+  neqns = NULL;
 }
 
 /* This function joins two nodes of a single circuit (interconnected
@@ -449,6 +475,7 @@ void spsolver::noiseConnect (circuit * result, node * n1, node * n2) {
 void spsolver::calc (nr_double_t freq) {
   circuit * root = subnet->getRoot ();
   for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ()) {
+    profile_device pd (c);
     c->calcSP (freq);
     if (noise) c->calcNoiseSP (freq);
   }
@@ -581,6 +608,15 @@ int spsolver::solve (void) {
     swp = createSweep ("frequency");
   }
 
+  // solve the nodal equation system instead of reducing the netlist ?
+  nodal = !strcmp (getPropertyString ("Method"), "nodal") ? 1 : 0;
+  if (nodal && noise) {
+    logprint (LOG_ERROR, "WARNING: %s: noise analysis is not available "
+	      "with the nodal method, using port reduction\n", getName ());
+    nodal = 0;
+  }
+  if (nodal) return solveNodal ();
+
   init ();
   insertConnections ();
 
@@ -969,6 +1005,7 @@ void spsolver::dropDifferentialPort (circuit * c) {
    (for the given frequency) into the output dataset. */
 void spsolver::saveResults (nr_double_t freq) {
 
+  profile_timer t (PROFILE_SAVE);
   vector * f;
   node * sig_i, * sig_j;
   char * n;
@@ -1101,6 +1138,240 @@ void spsolver::saveCharacteristics (nr_double_t freq) {
   }
 }
 
+/* The function computes the admittance matrix of the given circuit
+   from its S-parameters, i.e. Y = (E + S)^-1 * (E - S) / z0.  It
+   returns zero if the circuit has got no admittance representation
+   (e.g. an ideal short) since E + S is singular, the matrix is left
+   undefined then. */
+static int nodalAdmittance (circuit * c, matrix & y) {
+  matrix s = c->getMatrixS ();
+  if (abs (det (eye (s.getRows ()) + s)) < NR_TINY) return 0;
+  y = stoy (s, nr_complex_t (circuit::z0));
+  return 1;
+}
+
+/* The function prepares the nodal S-parameter analysis.  It numbers
+   the nodes of the netlist (bandwidth reducing) and collects the
+   circuits and signal ports to be stamped into the equation system. */
+void spsolver::initNodal (void) {
+  nlist = new nodelist (subnet);
+  nlist->assignNodes (NODEORDER_RCM);
+  nnodes = nlist->length () - 1;
+  nbranches = 0;
+  ncircuits.clear ();
+  nports.clear ();
+
+  for (circuit * c = subnet->getRoot (); c != NULL;
+       c = (circuit *) c->getNext ()) {
+    // signal ports are handled as terminations and excitations
+    if (c->getPort ()) {
+      nodalport_t p;
+      p.c = c;
+      p.num = c->getPropertyInteger ("Num");
+      p.pos = nlist->getNodeNr (c->getNode(0)->getName ()) - 1;
+      p.neg = nlist->getNodeNr (c->getNode(1)->getName ()) - 1;
+      p.z = c->getPropertyDouble ("Z");
+      nports.push_back (p);
+      continue;
+    }
+    nodalcircuit_t n;
+    int grounded = 1;
+    n.c = c;
+    n.branch = -1;
+    for (int i = 0; i < c->getSize (); i++) {
+      int r = nlist->getNodeNr (c->getNode(i)->getName ()) - 1;
+      if (r >= 0) grounded = 0;
+      n.nodes.push_back (r);
+    }
+    // circuits connected to ground only do not contribute
+    if (!grounded) ncircuits.push_back (n);
+  }
+
+  delete neqns;
+  neqns = new eqnsys<nr_complex_t> ();
+
+#if DEBUG
+  logprint (LOG_STATUS, "NOTIFY: %s: nodal SP netlist with %d nodes, "
+	    "%d ports and bandwidth %d\n", getName (), nnodes,
+	    (int) nports.size (), nlist->bandwidth ());
+#endif
+}
+
+/* This function stamps the admittance matrices of all circuits (their
+   S-parameters must be computed already) and the port terminations
+   into the nodal equation system.  Circuits without admittance
+   representation get a branch current for each of their nodes and
+   are stamped by (E - S) * V - z0 * (E + S) * I = 0.  The system is
+   factorized once and solved for each port excitation, the resulting
+   S-parameters are stored in the given matrix. */
+void spsolver::calcNodal (matrix & s) {
+  int i, j, r, k, N, grown;
+  int P = nports.size ();
+  nr_double_t z0 = circuit::z0;
+  matrix y;
+
+  do {
+    // (re)create the equation system
+    N = nnodes + nbranches;
+    if (nA == NULL || nA->getCols () != N) {
+      delete nA; nA = new tmatrix<nr_complex_t> (N);
+      delete nx; nx = new tvector<nr_complex_t> (N);
+      delete nz; nz = new tvector<nr_complex_t> (N);
+    }
+    nA->set (0.0);
+    grown = 0;
+
+    for (auto & nc : ncircuits) {
+      circuit * c = nc.c;
+      int size = c->getSize ();
+      // stamp admittance matrix if possible
+      if (nc.branch < 0) {
+	if (nodalAdmittance (c, y)) {
+	  for (i = 0; i < size; i++) {
+	    if ((r = nc.nodes[i]) < 0) continue;
+	    for (j = 0; j < size; j++) {
+	      if ((k = nc.nodes[j]) < 0) continue;
+	      (*nA) (r, k) += y (i, j);
+	    }
+	  }
+	  continue;
+	}
+	// otherwise restart with additional branch currents
+	nc.branch = nbranches;
+	nbranches += size;
+	grown = 1;
+	break;
+      }
+      // stamp branch currents and S-parameters
+      int b = nnodes + nc.branch;
+      for (i = 0; i < size; i++) {
+	if ((r = nc.nodes[i]) >= 0) (*nA) (r, b + i) += 1.0;
+	for (j = 0; j < size; j++) {
+	  nr_complex_t sij = c->getS (i, j);
+	  nr_double_t e = (i == j) ? 1.0 : 0.0;
+	  if ((k = nc.nodes[j]) >= 0) (*nA) (b + i, k) += e - sij;
+	  (*nA) (b + i, b + j) -= z0 * (e + sij);
+	}
+      }
+    }
+  } while (grown);
+
+  // terminate the ports with their reference impedances
+  for (auto & p : nports) {
+    nr_double_t g = 1.0 / p.z;
+    if (p.pos >= 0) (*nA) (p.pos, p.pos) += g;
+    if (p.neg >= 0) (*nA) (p.neg, p.neg) += g;
+    if (p.pos >= 0 && p.neg >= 0) {
+      (*nA) (p.pos, p.neg) -= g;
+      (*nA) (p.neg, p.pos) -= g;
+    }
+  }
+
+  // factorize the equation system once
+  nz->set (0.0);
+  neqns->setAlgo (ALGO_LU_FACTORIZATION_CROUT);
+  neqns->passEquationSys (nA, nx, nz);
+  try_running () {
+    neqns->solve ();
+  }
+  catch_exception () {
+  case EXCEPTION_SINGULAR:
+    do {
+      int d = top_exception()->getData ();
+      pop_exception ();
+      if (d < nnodes) {
+	logprint (LOG_ERROR, "WARNING: %s: inserted virtual resistance at "
+		  "node `%s' connected to [%s]\n", getName (),
+		  nlist->get (d).c_str (), nlist->getNodeString (d).c_str ());
+      }
+    }
+    while (top_exception () != NULL &&
+	   top_exception()->getCode () == EXCEPTION_SINGULAR);
+    break;
+  default:
+    estack.print ();
+    break;
+  }
+
+  /* Excite each port by an incident wave of unity, i.e. a current of
+     2 / sqrt (Z) in parallel to its termination, then the reflected
+     waves are b = V / sqrt (Z) at all other ports and b = V / sqrt (Z)
+     - 1 at the excited port. */
+  neqns->setAlgo (ALGO_LU_SUBSTITUTION_CROUT);
+  for (k = 0; k < P; k++) {
+    nodalport_t & p = nports[k];
+    nr_double_t i0 = 2.0 / std::sqrt (p.z);
+    nz->set (0.0);
+    if (p.pos >= 0) nz->set (p.pos, +i0);
+    if (p.neg >= 0) nz->set (p.neg, -i0);
+    neqns->passEquationSys (NULL, nx, nz);
+    neqns->solve ();
+    for (j = 0; j < P; j++) {
+      nodalport_t & q = nports[j];
+      nr_complex_t v = 0.0;
+      if (q.pos >= 0) v += nx->get (q.pos);
+      if (q.neg >= 0) v -= nx->get (q.neg);
+      s (j, k) = v / std::sqrt (q.z) - (j == k ? 1.0 : 0.0);
+    }
+  }
+}
+
+/* This function saves the S-parameters computed by the nodal analysis
+   for the given frequency into the output dataset. */
+void spsolver::saveNodalResults (nr_double_t freq, matrix & s) {
+  profile_timer t (PROFILE_SAVE);
+  vector * f;
+  char * n;
+
+  // add current frequency to the dependency of the output dataset
+  if ((f = data->findDependency ("frequency")) == NULL) {
+    f = new vector ("frequency");
+    data->addDependency (f);
+  }
+  if (runs == 1) f->add (freq);
+
+  for (unsigned int i = 0; i < nports.size (); i++) {
+    for (unsigned int j = 0; j < nports.size (); j++) {
+      n = createSP (nports[i].num, nports[j].num);
+      saveVariable (n, s (i, j), f);
+    }
+  }
+}
+
+/* This is the nodal netlist solver.  Unlike solve() the netlist is
+   not modified, the equation system is setup and factorized once for
+   each requested frequency. */
+int spsolver::solveNodal (void) {
+  nr_double_t freq;
+
+  init ();
+  initNodal ();
+  matrix s (nports.size ());
+
+#if DEBUG
+  logprint (LOG_STATUS, "NOTIFY: %s: solving SP netlist\n", getName ());
+#endif
+
+  swp->reset ();
+  for (int i = 0; i < swp->getSize (); i++) {
+    freq = swp->next ();
+    if (progress) logprogressbar (i, swp->getSize (), 40);
+    calc (freq);
+    calcNodal (s);
+    saveNodalResults (freq, s);
+    if (saveCVs & SAVE_CVS) saveCharacteristics (freq);
+  }
+  if (progress) logprogressclear (40);
+
+  delete nlist; nlist = NULL;
+  delete nA; nA = NULL;
+  delete nx; nx = NULL;
+  delete nz; nz = NULL;
+  ncircuits.clear ();
+  nports.clear ();
+  return 0;
+}
+
 // properties
 PROP_REQ [] = {
   { "Type", PROP_STR, { PROP_NO_VAL, "lin" }, PROP_RNG_TYP },
@@ -1115,6 +1386,8 @@ PROP_OPT [] = {
   { "Values", PROP_LIST, { 10, PROP_NO_STR }, PROP_POS_RANGE },
   { "saveCVs", PROP_STR, { PROP_NO_VAL, "no" }, PROP_RNG_YESNO },
   { "saveAll", PROP_STR, { PROP_NO_VAL, "no" }, PROP_RNG_YESNO },
+  { "Method", PROP_STR, { PROP_NO_VAL, "reduction" },
+    PROP_RNG_STR2 ("reduction", "nodal") },
   PROP_NO_PROP };
 struct define_t spsolver::anadef =
   { "SP", 0, PROP_ACTION, PROP_NO_SUBSTRATE, PROP_LINEAR, PROP_DEF };
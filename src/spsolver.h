@@ -26,6 +26,7 @@
 #define __SPSOLVER_H__
 
 #include <string>
+#include <vector>
 
 namespace qucs {
 
@@ -35,6 +36,10 @@ class node;
 class vector;
 class sweep;
 class nodelist;
+class matrix;
+template <class nr_type_t> class tvector;
+template <class nr_type_t> class tmatrix;
+template <class nr_type_t> class eqnsys;
 
 class spsolver : public analysis
 {
@@ -70,6 +75,25 @@ class spsolver : public analysis
   void dropGround (circuit *);
   void dropDifferentialPort (circuit *);
   void dropConnections (void);
+  int  solveNodal (void);
+  void initNodal (void);
+  void calcNodal (matrix &);
+  void saveNodalResults (nr_double_t, matrix &);
+
+ private:
+  // circuit stamped into the nodal equation system
+  struct nodalcircuit_t {
+    circuit * c;
+    std::vector<int> nodes; // row of each circuit node, -1 for ground
+    int branch;             // first branch current, -1 if stamped by Y
+  };
+  // S-parameter port of the nodal equation system
+  struct nodalport_t {
+    circuit * c;
+    int num;
+    int pos, neg;
+    nr_double_t z;
+  };
 
  private:
   int tees, crosses, grounds, opens;
@@ -78,6 +102,14 @@ class spsolver : public analysis
   sweep * swp;
   nodelist * nlist;
   circuit * gnd;
+  int nodal;
+  int nnodes, nbranches;
+  std::vector<nodalcircuit_t> ncircuits;
+  std::vector<nodalport_t> nports;
+  tmatrix<nr_complex_t> * nA;
+  tvector<nr_complex_t> * nx;
+  tvector<nr_complex_t> * nz;
+  eqnsys<nr_complex_t> * neqns;
 };
 
 } // namespace qucs
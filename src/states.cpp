@@ -41,7 +41,9 @@ states<state_type_t>::states ()
 {
     nstates = 0;
     currentstate = 0;
+    current = &currentstate;
     stateval = NULL;
+    owner = true;
 }
 
 /* The copy constructor creates a new instance based on the given
@@ -50,7 +52,9 @@ template <class state_type_t>
 states<state_type_t>::states (const states & c)
 {
     nstates = c.nstates;
-    currentstate = c.currentstate;
+    currentstate = *c.current;
+    current = &currentstate;
+    owner = true;
 
     // copy state variables if necessary
     if (nstates && c.stateval)
@@ -66,15 +70,18 @@ states<state_type_t>::states (const states & c)
 template <class state_type_t>
 states<state_type_t>::~states ()
 {
-    free (stateval);
+    if (owner) free (stateval);
 }
 
 /* The function allocates and initializes memory for the save-state
-   variables. */
+   variables.  States attached to an arena get their own memory
+   again. */
 template <class state_type_t>
 void states<state_type_t>::initStates (void)
 {
+    detachStates ();
     free (stateval);
+    stateval = NULL;
     if (nstates)
     {
         stateval = (state_type_t *)
@@ -83,13 +90,53 @@ void states<state_type_t>::initStates (void)
     currentstate = 0;
 }
 
+/* This function places the save-state variables into the given
+   memory, which must hold nstates * STATE_NUM values and is owned by
+   the caller, e.g. a transient solver keeping the states of all
+   circuits in one contiguous arena.  The current state values are
+   copied over.  All states attached to the same arena share the given
+   state index, so that the owner of the arena can shift the states of
+   all circuits at once. */
+template <class state_type_t>
+void states<state_type_t>::attachStates (state_type_t * base, int * cur)
+{
+    if (nstates && stateval)
+    {
+        for (int s = 0; s < nstates; s++)
+            for (int i = 0; i < STATE_NUM; i++)
+                base[(s << STATE_SHIFT) + ((i + *cur) & STATE_MASK)] =
+                    stateval[(s << STATE_SHIFT) + ((i + *current) & STATE_MASK)];
+    }
+    else if (nstates)
+    {
+        memset (base, 0, nstates * sizeof (state_type_t) * STATE_NUM);
+    }
+    if (owner) free (stateval);
+    stateval = base;
+    current = cur;
+    owner = false;
+}
+
+/* The function detaches the save-state variables from an external
+   arena.  The states are lost, initStates() must be called before
+   using them again. */
+template <class state_type_t>
+void states<state_type_t>::detachStates (void)
+{
+    if (owner) return;
+    currentstate = 0;
+    current = &currentstate;
+    stateval = NULL;
+    owner = true;
+}
+
 // Clears the save-state variables.
 template <class state_type_t>
 void states<state_type_t>::clearStates (void)
 {
     if (nstates && stateval)
         memset (stateval, 0, nstates * sizeof (state_type_t) * STATE_NUM);
-    currentstate = 0;
+    *current = 0;
 }
 
 /* The function returns a save-state variable at the given position.
@@ -98,7 +145,7 @@ void states<state_type_t>::clearStates (void)
 template <class state_type_t>
 state_type_t states<state_type_t>::getState (int state, int n)
 {
-    int i = (n + currentstate) & STATE_MASK;
+    int i = (n + *current) & STATE_MASK;
     return stateval[(state << STATE_SHIFT) + i];
 }
 
@@ -108,22 +155,23 @@ state_type_t states<state_type_t>::getState (int state, int n)
 template <class state_type_t>
 void states<state_type_t>::setState (int state, state_type_t val, int n)
 {
-    int i = (n + currentstate) & STATE_MASK;
+    int i = (n + *current) & STATE_MASK;
     stateval[(state << STATE_SHIFT) + i] = val;
 }
 
-// Shifts one state forward.
+/* Shifts one state forward.  For states attached to an arena this
+   shifts the states of all circuits sharing it. */
 template <class state_type_t>
 void states<state_type_t>::nextState (void)
 {
-    if (--currentstate < 0) currentstate = STATE_NUM - 1;
+    if (--(*current) < 0) *current = STATE_NUM - 1;
 }
 
 // Shifts one state backward.
 template <class state_type_t>
 void states<state_type_t>::prevState (void)
 {
-    currentstate = (currentstate + 1) & STATE_MASK;
+    *current = (*current + 1) & STATE_MASK;
 }
 
 /* This function applies the given value to a save-state variable through
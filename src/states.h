@@ -56,6 +56,11 @@ class states
   void saveState (int, state_type_t *);
   void inputState (int, state_type_t *);
 
+  // placement of the save-state variables in an external arena
+  void attachStates (state_type_t *, int *);
+  void detachStates (void);
+  bool hasOwnStates (void) { return owner; }
+
  private:
   // stateval: array for holding all the sets of states. Multiple sets of
   // states are stored in one large array which is indexed appropriately
@@ -63,6 +68,10 @@ class states
   state_type_t * stateval;
   int nstates; // the number of sets of states stored
   int currentstate;
+  // current: the state index in use, either currentstate or the shared
+  // index of the arena the states are attached to
+  int * current;
+  bool owner; // stateval has been allocated by this object
 };
 
 } // namespace qucs
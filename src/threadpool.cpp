@@ -0,0 +1,114 @@
+/*
+ * threadpool.cpp - simple pool of worker threads implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#ifndef __MINGW32__
+#include <unistd.h>
+#endif
+
+#include "threadpool.h"
+
+namespace qucs {
+
+/* Constructor creates a pool with the given number of threads
+   including the calling one.  Zero means one thread per core. */
+threadpool::threadpool (int threads) {
+  if (threads <= 0) threads = (int) std::thread::hardware_concurrency ();
+  if (threads <= 0) threads = 1;
+  nthreads = threads;
+  job = NULL;
+  next = 0;
+  count = 0;
+  busy = 0;
+  generation = 0;
+  quit = false;
+#ifndef __MINGW32__
+  owner = (long) getpid ();
+#else
+  owner = 0;
+#endif
+  for (int i = 1; i < nthreads; i++)
+    workers.push_back (std::thread (&threadpool::work, this));
+}
+
+// Destructor stops and joins the worker threads.
+threadpool::~threadpool () {
+  {
+    std::unique_lock<std::mutex> l (lock);
+    quit = true;
+  }
+  wake.notify_all ();
+  for (auto & t : workers) t.join ();
+}
+
+// The main loop of a worker thread.
+void threadpool::work (void) {
+  unsigned long seen = 0;
+  for (;;) {
+    int n;
+    const std::function<void (int)> * fn;
+    {
+      std::unique_lock<std::mutex> l (lock);
+      wake.wait (l, [&] { return quit || generation != seen; });
+      if (quit) return;
+      seen = generation;
+      n = count;
+      fn = job;
+    }
+    for (int i; (i = next++) < n; ) (*fn) (i);
+    {
+      std::unique_lock<std::mutex> l (lock);
+      if (--busy == 0) done.notify_one ();
+    }
+  }
+}
+
+/* Runs the given function for the numbers 0 to n-1 and returns when
+   all of them are done. */
+void threadpool::run (int n, const std::function<void (int)> & fn) {
+  bool forked = false;
+#ifndef __MINGW32__
+  forked = owner != (long) getpid ();
+#endif
+  if (nthreads <= 1 || n <= 1 || forked) {
+    for (int i = 0; i < n; i++) fn (i);
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> l (lock);
+    job = &fn;
+    count = n;
+    next = 0;
+    busy = (int) workers.size ();
+    generation++;
+  }
+  wake.notify_all ();
+  for (int i; (i = next++) < n; ) fn (i);
+  std::unique_lock<std::mutex> l (lock);
+  done.wait (l, [&] { return busy == 0; });
+  job = NULL;
+}
+
+} // namespace qucs
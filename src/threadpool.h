@@ -0,0 +1,72 @@
+/*
+ * threadpool.h - simple pool of worker threads definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __THREADPOOL_H__
+#define __THREADPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace qucs {
+
+/*!\brief Pool of worker threads
+
+   The pool runs independent jobs numbered 0 to n-1 on its worker
+   threads and the calling thread, and returns when all of them are
+   done.  Each thread has its own exception stack, jobs must handle
+   their exceptions themselves.  A pool with a single thread runs the
+   jobs in order in the calling thread, as does a pool used in a
+   forked process where the worker threads do not exist.
+*/
+class threadpool
+{
+ public:
+  threadpool (int threads = 0);
+  ~threadpool ();
+  int getThreads (void) { return nthreads; }
+  void run (int, const std::function<void (int)> &);
+
+ private:
+  void work (void);
+
+ private:
+  int nthreads;
+  std::vector<std::thread> workers;
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable done;
+  const std::function<void (int)> * job;
+  std::atomic<int> next;
+  int count;
+  int busy;
+  unsigned long generation;
+  bool quit;
+  long owner;
+};
+
+} // namespace qucs
+
+#endif /* __THREADPOOL_H__ */
@@ -34,6 +34,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <cmath>
+#include <algorithm>
 
 #include "compat.h"
 #include "logging.h"
@@ -90,6 +91,17 @@ tmatrix<nr_type_t>::tmatrix (const tmatrix & m) {
   }
 }
 
+/* The move constructor takes over the elements of the given tmatrix
+   object which is left empty. */
+template <class nr_type_t>
+tmatrix<nr_type_t>::tmatrix (tmatrix && m) {
+  rows = m.rows;
+  cols = m.cols;
+  data = m.data;
+  m.rows = m.cols = 0;
+  m.data = NULL;
+}
+
 /* The assignment copy constructor creates a new instance based on the
    given tmatrix object. */
 template <class nr_type_t>
@@ -107,6 +119,19 @@ tmatrix<nr_type_t>::operator=(const tmatrix<nr_type_t> & m) {
   return *this;
 }
 
+/* The move assignment exchanges the elements of both tmatrix objects,
+   the old elements get deleted along with the moved-from object. */
+template <class nr_type_t>
+const tmatrix<nr_type_t>&
+tmatrix<nr_type_t>::operator=(tmatrix<nr_type_t> && m) {
+  if (&m != this) {
+    std::swap (rows, m.rows);
+    std::swap (cols, m.cols);
+    std::swap (data, m.data);
+  }
+  return *this;
+}
+
 // Destructor deletes a tmatrix object.
 template <class nr_type_t>
 tmatrix<nr_type_t>::~tmatrix () {
@@ -177,12 +202,8 @@ void tmatrix<nr_type_t>::setCol (int c, tvector<nr_type_t> v) {
 template <class nr_type_t>
 void tmatrix<nr_type_t>::exchangeRows (int r1, int r2) {
   assert (r1 >= 0 && r2 >= 0 && r1 < rows && r2 < rows);
-  nr_type_t * s = new nr_type_t[cols];
-  int len = sizeof (nr_type_t) * cols;
-  memcpy (s, &data[r1 * cols], len);
-  memcpy (&data[r1 * cols], &data[r2 * cols], len);
-  memcpy (&data[r2 * cols], s, len);
-  delete[] s;
+  std::swap_ranges (&data[r1 * cols], &data[r1 * cols + cols],
+		    &data[r2 * cols]);
 }
 
 // The function swaps the given columns with each other.
@@ -197,25 +218,26 @@ void tmatrix<nr_type_t>::exchangeCols (int c1, int c2) {
   }
 }
 
-// Compute inverse matrix of the given matrix by Gauss-Jordan elimination.
+/* Computes the inverse of the given matrix into the preallocated
+   matrix 'e' by Gauss-Jordan elimination.  The given matrix is
+   destroyed, it ends up as identity matrix. */
 template <class nr_type_t>
-tmatrix<nr_type_t> inverse (tmatrix<nr_type_t> a) {
+void inverse (tmatrix<nr_type_t> & b, tmatrix<nr_type_t> & e) {
   nr_double_t MaxPivot;
   nr_type_t f;
-  tmatrix<nr_type_t> b;
-  tmatrix<nr_type_t> e;
-  int i, c, r, pivot, n = a.getCols ();
-
-  // create temporary matrix and the result matrix
-  b = tmatrix<nr_type_t> (a);
-  e = teye<nr_type_t> (n);
+  int i, c, r, pivot, n = b.getCols ();
+  assert (b.getRows () == n && e.getRows () == n && e.getCols () == n);
+  nr_type_t * B = b.getData ();
+  nr_type_t * E = e.getData ();
 
   // create the eye matrix in 'b' and the result in 'e'
+  e.set (0);
+  for (i = 0; i < n; i++) E[i * n + i] = 1;
   for (i = 0; i < n; i++) {
     // find maximum column value for pivoting
     for (MaxPivot = 0, pivot = r = i; r < n; r++) {
-      if (abs (b.get (r, i)) > MaxPivot) {
-	MaxPivot = abs (b.get (r, i));
+      if (abs (B[r * n + i]) > MaxPivot) {
+	MaxPivot = abs (B[r * n + i]);
 	pivot = r;
       }
     }
@@ -227,23 +249,30 @@ tmatrix<nr_type_t> inverse (tmatrix<nr_type_t> a) {
     }
 
     // compute current row
-    f = b.get (i, i);
+    f = B[i * n + i];
     for (c = 0; c < n; c++) {
-      b.set (i, c, b.get (i, c) / f);
-      e.set (i, c, e.get (i, c) / f);
+      B[i * n + c] /= f;
+      E[i * n + c] /= f;
     }
 
     // compute new rows and columns
     for (r = 0; r < n; r++) {
       if (r != i) {
-	f = b.get (r, i);
+	f = B[r * n + i];
 	for (c = 0; c < n; c++) {
-	  b.set (r, c, b.get (r, c) - f * b.get (i, c));
-	  e.set (r, c, e.get (r, c) - f * e.get (i, c));
+	  B[r * n + c] -= f * B[i * n + c];
+	  E[r * n + c] -= f * E[i * n + c];
 	}
       }
     }
   }
+}
+
+// Compute inverse matrix of the given matrix by Gauss-Jordan elimination.
+template <class nr_type_t>
+tmatrix<nr_type_t> inverse (tmatrix<nr_type_t> a) {
+  tmatrix<nr_type_t> e (a.getRows (), a.getCols ());
+  inverse (a, e);
   return e;
 }
 
@@ -257,9 +286,9 @@ tmatrix<nr_type_t> teye (int n) {
 
 // Intrinsic matrix addition.
 template <class nr_type_t>
-tmatrix<nr_type_t> tmatrix<nr_type_t>::operator += (tmatrix<nr_type_t> a) {
-  assert (a.getRows () == rows && a.getCols () == cols);
-  nr_type_t * src = a.getData ();
+tmatrix<nr_type_t>& tmatrix<nr_type_t>::operator += (const tmatrix<nr_type_t> & a) {
+  assert (a.rows == rows && a.cols == cols);
+  const nr_type_t * src = a.data;
   nr_type_t * dst = data;
   for (int i = 0; i < rows * cols; i++) *dst++ += *src++;
   return *this;
@@ -267,57 +296,96 @@ tmatrix<nr_type_t> tmatrix<nr_type_t>::operator += (tmatrix<nr_type_t> a) {
 
 // Intrinsic matrix substraction.
 template <class nr_type_t>
-tmatrix<nr_type_t> tmatrix<nr_type_t>::operator -= (tmatrix<nr_type_t> a) {
-  assert (a.getRows () == rows && a.getCols () == cols);
-  nr_type_t * src = a.getData ();
+tmatrix<nr_type_t>& tmatrix<nr_type_t>::operator -= (const tmatrix<nr_type_t> & a) {
+  assert (a.rows == rows && a.cols == cols);
+  const nr_type_t * src = a.data;
   nr_type_t * dst = data;
   for (int i = 0; i < rows * cols; i++) *dst++ -= *src++;
   return *this;
 }
 
-// Matrix multiplication.
+// Matrix multiplication into the preallocated matrix 'res'.
 template <class nr_type_t>
-tmatrix<nr_type_t> operator * (tmatrix<nr_type_t> a, tmatrix<nr_type_t> b) {
-  assert (a.getCols () == b.getRows ());
-  int r, c, i, n = a.getCols ();
-  nr_type_t z;
-  tmatrix<nr_type_t> res (a.getRows (), b.getCols ());
-  for (r = 0; r < a.getRows (); r++) {
-    for (c = 0; c < b.getCols (); c++) {
-      for (i = 0, z = 0; i < n; i++) z += a.get (r, i) * b.get (i, c);
-      res.set (r, c, z);
+void gemm (const tmatrix<nr_type_t> & a, const tmatrix<nr_type_t> & b,
+	   tmatrix<nr_type_t> & res) {
+  int r, c, i, n = a.getCols (), m = b.getCols ();
+  assert (n == b.getRows () && res.getRows () == a.getRows () &&
+	  res.getCols () == m && &res != &a && &res != &b);
+  const nr_type_t * A = a.getData ();
+  const nr_type_t * B = b.getData ();
+  nr_type_t * R = res.getData ();
+  res.set (0);
+  // row-wise accumulation keeps the inner loop on contiguous memory
+  for (r = 0; r < a.getRows (); r++, A += n, R += m) {
+    for (i = 0; i < n; i++) {
+      nr_type_t z = A[i];
+      if (z == 0.0) continue;
+      const nr_type_t * Bi = &B[i * m];
+      for (c = 0; c < m; c++) R[c] += z * Bi[c];
     }
   }
-  return res;
 }
 
-// Multiplication of matrix and vector.
+// Multiplication of matrix and vector into the preallocated vector 'res'.
 template <class nr_type_t>
-tvector<nr_type_t> operator * (tmatrix<nr_type_t> a, tvector<nr_type_t> b) {
-  assert (a.getCols () == b.size ());
+void gemv (const tmatrix<nr_type_t> & a, const tvector<nr_type_t> & b,
+	   tvector<nr_type_t> & res) {
   int r, c, n = a.getCols ();
-  nr_type_t z;
-  tvector<nr_type_t> res (n);
+  assert (n == (int) b.size () && a.getRows () == (int) res.size () &&
+	  &res != &b);
+  const nr_type_t * A = a.getData ();
+  const nr_type_t * x = b.getData ();
+  nr_type_t * y = res.getData ();
+  for (r = 0; r < a.getRows (); r++, A += n) {
+    nr_type_t z = 0;
+    for (c = 0; c < n; c++) z += A[c] * x[c];
+    y[r] = z;
+  }
+}
 
-  for (r = 0; r < n; r++) {
-    for (c = 0, z = 0; c < n; c++) z += a.get (r, c) * b.get (c);
-    res.set (r, z);
+/* Multiplication of vector (transposed) and matrix into the
+   preallocated vector 'res'. */
+template <class nr_type_t>
+void gevm (const tvector<nr_type_t> & a, const tmatrix<nr_type_t> & b,
+	   tvector<nr_type_t> & res) {
+  int r, c, n = b.getCols ();
+  assert (b.getRows () == (int) a.size () && n == (int) res.size () &&
+	  &res != &a);
+  const nr_type_t * x = a.getData ();
+  const nr_type_t * B = b.getData ();
+  nr_type_t * y = res.getData ();
+  for (c = 0; c < n; c++) y[c] = 0;
+  for (r = 0; r < b.getRows (); r++, B += n) {
+    nr_type_t z = x[r];
+    if (z == 0.0) continue;
+    for (c = 0; c < n; c++) y[c] += z * B[c];
   }
+}
+
+// Matrix multiplication.
+template <class nr_type_t>
+tmatrix<nr_type_t> operator * (const tmatrix<nr_type_t> & a,
+			       const tmatrix<nr_type_t> & b) {
+  tmatrix<nr_type_t> res (a.getRows (), b.getCols ());
+  gemm (a, b, res);
+  return res;
+}
+
+// Multiplication of matrix and vector.
+template <class nr_type_t>
+tvector<nr_type_t> operator * (const tmatrix<nr_type_t> & a,
+			       const tvector<nr_type_t> & b) {
+  tvector<nr_type_t> res (a.getRows ());
+  gemv (a, b, res);
   return res;
 }
 
 // Multiplication of vector (transposed) and matrix.
 template <class nr_type_t>
-tvector<nr_type_t> operator * (tvector<nr_type_t> a, tmatrix<nr_type_t> b) {
-  assert (a.size () == b.getRows ());
-  int r, c, n = b.getRows ();
-  nr_type_t z;
-  tvector<nr_type_t> res (n);
-
-  for (c = 0; c < n; c++) {
-    for (r = 0, z = 0; r < n; r++) z += a.get (r) * b.get (r, c);
-    res.set (c, z);
-  }
+tvector<nr_type_t> operator * (const tvector<nr_type_t> & a,
+			       const tmatrix<nr_type_t> & b) {
+  tvector<nr_type_t> res (b.getCols ());
+  gevm (a, b, res);
   return res;
 }
 
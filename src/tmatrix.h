@@ -38,11 +38,28 @@ tmatrix<nr_type_t> inverse (tmatrix<nr_type_t>);
 template <class nr_type_t>
 tmatrix<nr_type_t> teye (int);
 template <class nr_type_t>
-tmatrix<nr_type_t> operator * (tmatrix<nr_type_t>, tmatrix<nr_type_t>);
+tmatrix<nr_type_t> operator * (const tmatrix<nr_type_t> &,
+			       const tmatrix<nr_type_t> &);
 template <class nr_type_t>
-tvector<nr_type_t> operator * (tmatrix<nr_type_t>, tvector<nr_type_t>);
+tvector<nr_type_t> operator * (const tmatrix<nr_type_t> &,
+			       const tvector<nr_type_t> &);
 template <class nr_type_t>
-tvector<nr_type_t> operator * (tvector<nr_type_t>, tmatrix<nr_type_t>);
+tvector<nr_type_t> operator * (const tvector<nr_type_t> &,
+			       const tmatrix<nr_type_t> &);
+
+/* In-place operations writing into preallocated results, i.e. without
+   any temporary objects.  The results must not alias the operands. */
+template <class nr_type_t>
+void gemv (const tmatrix<nr_type_t> &, const tvector<nr_type_t> &,
+	   tvector<nr_type_t> &);
+template <class nr_type_t>
+void gevm (const tvector<nr_type_t> &, const tmatrix<nr_type_t> &,
+	   tvector<nr_type_t> &);
+template <class nr_type_t>
+void gemm (const tmatrix<nr_type_t> &, const tmatrix<nr_type_t> &,
+	   tmatrix<nr_type_t> &);
+template <class nr_type_t>
+void inverse (tmatrix<nr_type_t> &, tmatrix<nr_type_t> &);
 
 template <class nr_type_t>
 class tmatrix
@@ -52,14 +69,17 @@ class tmatrix
   tmatrix (int);
   tmatrix (int, int);
   tmatrix (const tmatrix &);
+  tmatrix (tmatrix &&);
   const tmatrix& operator = (const tmatrix &);
+  const tmatrix& operator = (tmatrix &&);
   ~tmatrix ();
   nr_type_t get (int, int);
   void set (int, int, nr_type_t);
   void set (nr_type_t);
-  int  getCols (void) { return cols; }
-  int  getRows (void) { return rows; }
+  int  getCols (void) const { return cols; }
+  int  getRows (void) const { return rows; }
   nr_type_t * getData (void) { return data; }
+  const nr_type_t * getData (void) const { return data; }
   tvector<nr_type_t> getRow (int);
   void setRow (int, tvector<nr_type_t>);
   tvector<nr_type_t> getCol (int);
@@ -74,14 +94,16 @@ class tmatrix
 #ifndef _MSC_VER
   friend tmatrix inverse<> (tmatrix);
   friend tmatrix teye<nr_type_t> (int);
-  friend tmatrix operator *<> (tmatrix, tmatrix);
-  friend tvector<nr_type_t> operator *<> (tmatrix, tvector<nr_type_t>);
-  friend tvector<nr_type_t> operator *<> (tvector<nr_type_t>, tmatrix);
+  friend tmatrix operator *<> (const tmatrix &, const tmatrix &);
+  friend tvector<nr_type_t> operator *<> (const tmatrix &,
+					  const tvector<nr_type_t> &);
+  friend tvector<nr_type_t> operator *<> (const tvector<nr_type_t> &,
+					  const tmatrix &);
 #endif
 
   // intrinsic operators
-  tmatrix operator += (tmatrix);
-  tmatrix operator -= (tmatrix);
+  tmatrix& operator += (const tmatrix &);
+  tmatrix& operator -= (const tmatrix &);
 
   // easy accessor operators
   nr_type_t  operator () (int r, int c) const {
@@ -27,9 +27,11 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <float.h>
 #include <algorithm>
+#include <sstream>
 
 #include "compat.h"
 #include "object.h"
@@ -46,6 +48,8 @@
 #include "transient.h"
 #include "exception.h"
 #include "exceptionstack.h"
+#include "profile.h"
+#include "eventsim.h"
 
 #define STEPDEBUG   0 // set to zero for release
 #define BREAKPOINTS 0 // exact breakpoint calculation
@@ -71,6 +75,18 @@ trsolver::trsolver ()
     tHistory = NULL;
     relaxTSR = false;
     initialDC = true;
+    breakpoint = NR_MAX;
+    breakHit = false;
+    chordDelta = 0;
+    chordType = chordOrder = -1;
+    reduceType = REDUCE_NONE;
+    reduceWindow = 1;
+    reduceCount = 0;
+    saveCursor = 0;
+    stateArena = NULL;
+    stateArenaSize = 0;
+    stateArenaCurrent = 0;
+    eventKernel = NULL;
 }
 
 // Constructor creates a named instance of the trsolver class.
@@ -84,6 +100,18 @@ trsolver::trsolver (const std::string &n)
     tHistory = NULL;
     relaxTSR = false;
     initialDC = true;
+    breakpoint = NR_MAX;
+    breakHit = false;
+    chordDelta = 0;
+    chordType = chordOrder = -1;
+    reduceType = REDUCE_NONE;
+    reduceWindow = 1;
+    reduceCount = 0;
+    saveCursor = 0;
+    stateArena = NULL;
+    stateArenaSize = 0;
+    stateArenaCurrent = 0;
+    eventKernel = NULL;
 }
 
 // Destructor deletes the trsolver class object.
@@ -98,6 +126,8 @@ trsolver::~trsolver ()
         }
     }
     delete tHistory;
+    free (stateArena);
+    delete eventKernel;
 }
 
 /* The copy constructor creates a new instance of the trsolver class
@@ -110,6 +140,19 @@ trsolver::trsolver (trsolver & o)
     tHistory = o.tHistory ? new history (*o.tHistory) : NULL;
     relaxTSR = o.relaxTSR;
     initialDC = o.initialDC;
+    breakpoint = o.breakpoint;
+    breakHit = o.breakHit;
+    chordDelta = 0;
+    chordType = chordOrder = -1;
+    savePatterns = o.savePatterns;
+    reduceType = o.reduceType;
+    reduceWindow = o.reduceWindow;
+    reduceCount = 0;
+    saveCursor = 0;
+    stateArena = NULL;
+    stateArenaSize = 0;
+    stateArenaCurrent = 0;
+    eventKernel = NULL;
 }
 
 // This function creates the time sweep if necessary.
@@ -119,6 +162,22 @@ void trsolver::initSteps (void)
     swp = createSweep ("time");
 }
 
+// Chooses the equation system solver according to the properties.
+void trsolver::selectSolver (void)
+{
+    const char * const solver = getPropertyString ("Solver");
+    if (!strcmp (solver, "CroutLU"))
+        eqnAlgo = ALGO_LU_DECOMPOSITION;
+    else if (!strcmp (solver, "DoolittleLU"))
+        eqnAlgo = ALGO_LU_DECOMPOSITION_DOOLITTLE;
+    else if (!strcmp (solver, "HouseholderQR"))
+        eqnAlgo = ALGO_QR_DECOMPOSITION;
+    else if (!strcmp (solver, "HouseholderLQ"))
+        eqnAlgo = ALGO_QR_DECOMPOSITION_LS;
+    else if (!strcmp (solver, "GolubSVD"))
+        eqnAlgo = ALGO_SV_DECOMPOSITION;
+}
+
 // Performs the initial DC analysis.
 int trsolver::dcAnalysis (void)
 {
@@ -174,36 +233,31 @@ int trsolver::dcAnalysis (void)
 int trsolver::solve (void)
 {
     nr_double_t time, saveCurrent;
-    int error = 0, convError = 0;
-    const char * const solver = getPropertyString ("Solver");
+    int error = 0, convError = 0, running = 0;
     relaxTSR = !strcmp (getPropertyString ("relaxTSR"), "yes") ? true : false;
     initialDC = !strcmp (getPropertyString ("initialDC"), "yes") ? true : false;
+    bool useBreakpoints =
+        !strcmp (getPropertyString ("Breakpoints"), "yes") ? true : false;
 
     runs++;
     saveCurrent = current = 0;
     stepDelta = -1;
     converged = 0;
     fixpoint = 0;
+    chord = !strcmp (getPropertyString ("Newton"), "chord");
+    chordDelta = 0;
+    chordType = chordOrder = -1;
     statRejected = statSteps = statIterations = statConvergence = 0;
 
     // Choose a solver.
-    if (!strcmp (solver, "CroutLU"))
-        eqnAlgo = ALGO_LU_DECOMPOSITION;
-    else if (!strcmp (solver, "DoolittleLU"))
-        eqnAlgo = ALGO_LU_DECOMPOSITION_DOOLITTLE;
-    else if (!strcmp (solver, "HouseholderQR"))
-        eqnAlgo = ALGO_QR_DECOMPOSITION;
-    else if (!strcmp (solver, "HouseholderLQ"))
-        eqnAlgo = ALGO_QR_DECOMPOSITION_LS;
-    else if (!strcmp (solver, "GolubSVD"))
-        eqnAlgo = ALGO_SV_DECOMPOSITION;
+    selectSolver ();
 
     // Perform initial DC analysis.
     if (initialDC)
     {
         error = dcAnalysis ();
         if (error)
-            return -1;
+            goto fail;
     }
 
     // Initialize transient analysis.
@@ -215,6 +269,7 @@ int trsolver::solve (void)
     // Create time sweep if necessary.
     initSteps ();
     swp->reset ();
+    initSave ();
 
     // Recall the DC solution.
     recallSolution ();
@@ -226,12 +281,15 @@ int trsolver::solve (void)
     // Tell integrators to be initialized.
     setMode (MODE_INIT);
 
-    int running = 0;
     rejected = 0;
     delta /= 10;
     fillState (dState, delta);
     adjustOrder (1);
 
+    // Fetch the first corner of the transient sources.
+    breakpoint = useBreakpoints ? nextBreakpoint (current) : NR_MAX;
+    breakHit = false;
+
     // Start to sweep through time.
     for (int i = 0; i < swp->getSize (); i++)
     {
@@ -319,7 +377,7 @@ int trsolver::solve (void)
                 break;
             }
             // return if any errors occured other than convergence failure
-            if (error) return -1;
+            if (error) goto fail;
 
             // if the step was rejected, the solution loop is restarted here
             if (rejected) continue;
@@ -330,7 +388,8 @@ int trsolver::solve (void)
                 logprint (LOG_ERROR, "ERROR: %s: Jacobian singular at t = %.3e, "
                           "aborting %s analysis\n", getName (), (double) current,
                           getDescription ().c_str());
-                return -1;
+                error++;
+                goto fail;
             }
 
             // Update statistics and no more damped Newton-Raphson.
@@ -341,7 +400,7 @@ int trsolver::solve (void)
             if (running > 1)
             {
                 adjustDelta (time);
-                adjustOrder ();
+                adjustOrder (breakHit);
             }
             else
             {
@@ -355,6 +414,24 @@ int trsolver::solve (void)
             running++;
             converged++;
 
+            // Let the digital gates follow the accepted time step.
+            if (eventKernel && !rejected)
+            {
+                eventKernel->sample (saveCurrent);
+                eventKernel->advance (saveCurrent);
+                nr_double_t next = eventKernel->nextEvent ();
+                if (useBreakpoints && next < breakpoint)
+                {
+                    // do not step across the next gate output change
+                    breakpoint = next;
+                    if (next < current && next - saveCurrent >= deltaMin)
+                    {
+                        delta = next - saveCurrent;
+                        current = next;
+                    }
+                }
+            }
+
             // Tell integrators to be running.
             setMode (MODE_NONE);
 
@@ -383,6 +460,8 @@ int trsolver::solve (void)
 #endif
     } // for (int i = 0; i < swp->getSize (); i++)
 
+    // Save the last incomplete reduction window.
+    flushResults ();
     solve_post ();
     if (progress) logprogressclear (40);
     logprint (LOG_STATUS, "NOTIFY: %s: average time-step %g, %d rejections\n",
@@ -390,10 +469,18 @@ int trsolver::solve (void)
     logprint (LOG_STATUS, "NOTIFY: %s: average NR-iterations %g, "
               "%d non-convergences\n", getName (),
               (double) statIterations / statSteps, statConvergence);
-
-    // cleanup
+    logprint (LOG_STATUS, "NOTIFY: %s: %d time-steps, %d NR-iterations\n",
+              getName (), statSteps, statIterations);
+    if (eventKernel)
+        logprint (LOG_STATUS, "NOTIFY: %s: %d digital gates, %lu events\n",
+                  getName (), eventKernel->getGates (),
+                  eventKernel->getEvents ());
+
+fail:
+    // cleanup, also after errors
+    releaseCircuits ();
     deinitTR ();
-    return 0;
+    return error ? -1 : 0;
 }
 
 // The function initializes the history.
@@ -569,19 +656,24 @@ void trsolver::predictGear (void)
 int trsolver::corrector (void)
 {
     int error = 0;
+    /* With modified Newton iterations the factorization of the
+       previous step is kept if the step size and the integration
+       method are unchanged, the Jacobian hardly differs then. */
+    chordStart = delta == chordDelta &&
+        corrType == chordType && corrOrder == chordOrder;
+    chordDelta = delta;
+    chordType = corrType;
+    chordOrder = corrOrder;
     error += solve_nonlinear ();
     return error;
 }
 
-// The function advances one more time-step.
+/* The function advances one more time-step.  The states of all
+   circuits live in the state arena and share a single state index, so
+   shifting them is a single operation. */
 void trsolver::nextStates (void)
 {
-    circuit * root = subnet->getRoot ();
-    for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
-    {
-        // for each circuit get the next state
-        c->nextState ();
-    }
+    if (--stateArenaCurrent < 0) stateArenaCurrent = STATE_NUM - 1;
 
     *SOL (0) = *x; // save current solution
     nextState ();
@@ -594,14 +686,56 @@ void trsolver::nextStates (void)
    transient solution. */
 void trsolver::fillStates (void)
 {
-    circuit * root = subnet->getRoot ();
-    for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
+    nr_double_t * p = stateArena;
+    for (int s = 0; s < stateArenaSize; s++, p += STATE_NUM)
+    {
+        nr_double_t val = p[stateArenaCurrent];
+        for (int i = 0; i < STATE_NUM; i++) p[i] = val;
+    }
+}
+
+/* This function places the save-state variables of all circuits into
+   a single contiguous arena owned by the transient solver.  Each
+   circuit gets the slice at its state offset, the states of one
+   circuit keep their layout, i.e. STATE_NUM history values of each
+   state in a row.  Operations on the states of all circuits at once
+   are simple loops over the arena then. */
+void trsolver::initStateArena (void)
+{
+    circuit * c, * root = subnet->getRoot ();
+    std::vector<circuit *> circuits;
+
+    for (c = root; c != NULL; c = (circuit *) c->getNext ())
+        if (c->getStates () > 0) circuits.push_back (c);
+    // also the created circuits
+    for (c = root ? (circuit *) root->getPrev () : NULL; c != NULL;
+         c = (circuit *) c->getPrev ())
+        if (c->getStates () > 0) circuits.push_back (c);
+
+    freeStateArena ();
+    for (circuit * cir : circuits) stateArenaSize += cir->getStates ();
+    if (stateArenaSize == 0) return;
+    stateArena = (nr_double_t *)
+        calloc (stateArenaSize, sizeof (nr_double_t) * STATE_NUM);
+
+    int offset = 0;
+    for (circuit * cir : circuits)
     {
-        for (int s = 0; s < c->getStates (); s++)
-            c->fillState (s, c->getState (s));
+        cir->attachStates (stateArena + offset * STATE_NUM, &stateArenaCurrent);
+        offset += cir->getStates ();
     }
 }
 
+/* The function frees the state arena.  Circuits still attached to it
+   must have been released before, see releaseCircuits(). */
+void trsolver::freeStateArena (void)
+{
+    free (stateArena);
+    stateArena = NULL;
+    stateArenaSize = 0;
+    stateArenaCurrent = 0;
+}
+
 // The function modifies the circuit lists integrator mode.
 void trsolver::setMode (int state)
 {
@@ -673,6 +807,31 @@ void trsolver::adjustDelta (nr_double_t t)
         }
     }
 
+    // delta correction in order to hit the next source breakpoint, only
+    // done if the current step is going to be accepted
+    breakHit = false;
+    if (delta > 0.9 * deltaOld || good)
+    {
+        if (current > breakpoint - deltaMin)
+        {
+            // the current step landed on the breakpoint: restart with a
+            // small step and tell adjustOrder() to reduce the order
+            breakHit = true;
+            breakpoint = nextBreakpoint (current + deltaMin);
+            delta = std::min (delta,
+                              0.1 * std::min (deltaOld, breakpoint - current));
+            if (delta < deltaMin) delta = deltaMin;
+            stepDelta = -1.0;
+            good = 1;
+        }
+        else if (current + delta > breakpoint - deltaMin)
+        {
+            // do not step across the breakpoint nor just short of it
+            delta = breakpoint - current;
+            good = 1;
+        }
+    }
+
     // usual delta correction
     if (delta > 0.9 * deltaOld || good)   // accept current delta
     {
@@ -702,6 +861,26 @@ void trsolver::adjustDelta (nr_double_t t)
     }
 }
 
+/* Returns the earliest corner of all transient sources after the given
+   time, or NR_MAX if there is none. */
+nr_double_t trsolver::nextBreakpoint (nr_double_t t)
+{
+    nr_double_t next = NR_MAX;
+    circuit * root = subnet->getRoot ();
+    for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
+    {
+        nr_double_t bp = c->nextBreakpoint (t);
+        if (bp < next) next = bp;
+    }
+    // pending changes of the digital gates
+    if (eventKernel)
+    {
+        nr_double_t bp = eventKernel->nextEvent ();
+        if (bp > t && bp < next) next = bp;
+    }
+    return next;
+}
+
 /* The function can be used to increase the current order of the
    integration method or to reduce it. */
 void trsolver::adjustOrder (int reduce)
@@ -738,6 +917,7 @@ void trsolver::calcDC (trsolver * self)
     circuit * root = self->getNet()->getRoot ();
     for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
     {
+        profile_device pd (c);
         c->calcDC ();
     }
 }
@@ -749,6 +929,7 @@ void trsolver::calcTR (trsolver * self)
     circuit * root = self->getNet()->getRoot ();
     for (circuit * c = root; c != NULL; c = (circuit *) c->getNext ())
     {
+        profile_device pd (c);
         c->calcTR (self->current);
     }
 }
@@ -819,18 +1000,64 @@ void trsolver::initTR (void)
         setState (sState, (nr_double_t) i, i);
     }
 
-    // tell circuits about the transient analysis
+    // hand the digital gates over to the event driven kernel
     circuit *c, * root = subnet->getRoot ();
+    releaseCircuits ();
+    freeEventKernel ();
+    if (!strcmp (getPropertyString ("Digital"), "event"))
+    {
+        eventKernel = new eventsim ();
+        for (c = root; c != NULL; c = (circuit *) c->getNext ())
+            eventKernel->addCircuit (c);
+        if (eventKernel->getGates () == 0) freeEventKernel ();
+    }
+
+    // tell circuits about the transient analysis
     for (c = root; c != NULL; c = (circuit *) c->getNext ())
         initCircuitTR (c);
     // also initialize created circuits
     for (c = root; c != NULL; c = (circuit *) c->getPrev ())
         initCircuitTR (c);
+    // put the circuit states into one arena
+    initStateArena ();
+
+    // start the digital kernel from the DC solution
+    if (eventKernel) eventKernel->start (current);
+}
+
+/* The function detaches the circuits from the state arena and gives
+   the digital gates back to the analog solver.  It must be called
+   while the circuits still exist, thus not from the destructors run
+   by the netlist after deleting its circuits. */
+void trsolver::releaseCircuits (void)
+{
+    if (stateArena != NULL && subnet != NULL)
+    {
+        circuit * c, * root = subnet->getRoot ();
+        for (c = root; c != NULL; c = (circuit *) c->getNext ())
+            c->detachStates ();
+        for (c = root ? (circuit *) root->getPrev () : NULL; c != NULL;
+             c = (circuit *) c->getPrev ())
+            c->detachStates ();
+    }
+    if (eventKernel) eventKernel->release ();
+}
+
+// Frees the event driven kernel.
+void trsolver::freeEventKernel (void)
+{
+    if (eventKernel)
+    {
+        delete eventKernel;
+        eventKernel = NULL;
+    }
 }
 
 // This function cleans up some memory used by the transient analysis.
 void trsolver::deinitTR (void)
 {
+    freeStateArena ();
+    freeEventKernel ();
     // cleanup solutions
     for (int i = 0; i < 8; i++)
     {
@@ -866,8 +1093,199 @@ void trsolver::saveAllResults (nr_double_t time)
       t = new qucs::vector ("time");
         data->addDependency (t);
     }
-    if (runs == 1) t->add (time);
+    saveCursor = 0;
+    if (reduceType == REDUCE_NONE)
+    {
+        if (runs == 1) t->add (time);
+        saveResults ("Vt", "It", 0, t);
+        return;
+    }
+
+    // feed the reducers and save them once per window
+    if (reduceCount == 0) reduceStart = time;
+    reduceStop = time;
     saveResults ("Vt", "It", 0, t);
+    if (++reduceCount >= reduceWindow) flushResults ();
+}
+
+/* Matches the given name against a glob pattern containing '*' and '?'
+   wildcards. */
+static bool matchPattern (const char * p, const char * s)
+{
+    for (; *p; p++, s++)
+    {
+        if (*p == '*')
+        {
+            while (*p == '*') p++;
+            if (!*p) return true;
+            for (; *s; s++)
+                if (matchPattern (p, s)) return true;
+            return false;
+        }
+        if (!*s || (*p != '?' && *p != *s)) return false;
+    }
+    return !*s;
+}
+
+/* Reads the output filter and reduction properties.  The "Save"
+   property is a list of glob patterns separated by spaces or commas. */
+void trsolver::initSave (void)
+{
+    std::string save = getPropertyString ("Save");
+    const char * const reduce = getPropertyString ("Reduce");
+
+    std::replace (save.begin (), save.end (), ',', ' ');
+    std::istringstream ss (save);
+    std::string pattern;
+    savePatterns.clear ();
+    while (ss >> pattern) savePatterns.push_back (pattern);
+
+    if (!strcmp (reduce, "decimate"))
+        reduceType = REDUCE_DECIMATE;
+    else if (!strcmp (reduce, "envelope"))
+        reduceType = REDUCE_ENVELOPE;
+    else if (!strcmp (reduce, "average"))
+        reduceType = REDUCE_AVERAGE;
+    else if (!strcmp (reduce, "rms"))
+        reduceType = REDUCE_RMS;
+    else
+        reduceType = REDUCE_NONE;
+    reduceWindow = getPropertyInteger ("Window");
+    reduceCount = 0;
+    saveCursor = 0;
+    saveIndex.clear ();
+    saveOrder.clear ();
+    reductions.clear ();
+}
+
+/* Checks whether the given variable passes the output filter.  The
+   patterns are matched against the full variable name (e.g. "out.Vt")
+   and the node or probe name (e.g. "out"). */
+bool trsolver::isSaved (const std::string &n)
+{
+    if (savePatterns.empty ()) return true;
+    std::string base = n.substr (0, n.rfind ('.'));
+    for (auto & p : savePatterns)
+    {
+        if (matchPattern (p.c_str (), n.c_str ()) ||
+            matchPattern (p.c_str (), base.c_str ()))
+            return true;
+    }
+    return false;
+}
+
+/* Saves the given variable into the dataset if it passes the output
+   filter.  With an output reduction the value is accumulated until
+   the end of the current window.  The variables arrive in the same
+   order at each time-step, thus the name is only looked up if the
+   order changes. */
+void trsolver::saveVariable (const std::string &n, nr_complex_t z,
+                             qucs::vector * f)
+{
+    int idx;
+    if (saveCursor < saveOrder.size () && saveOrder[saveCursor]->first == n)
+    {
+        idx = saveOrder[saveCursor]->second;
+    }
+    else
+    {
+        std::map<std::string, int>::iterator it = saveIndex.find (n);
+        if (it == saveIndex.end ())
+        {
+            idx = -1;
+            if (isSaved (n))
+            {
+                reduction_t r;
+                r.name = n;
+                r.dep = f;
+                r.vec[0] = r.vec[1] = NULL;
+                // the variable may first appear within a window
+                r.first = z;
+                r.sum = 0.0;
+                r.sqr = 0.0;
+                r.min = r.max = real (z);
+                idx = reductions.size ();
+                reductions.push_back (r);
+            }
+            it = saveIndex.insert (std::make_pair (n, idx)).first;
+        }
+        idx = it->second;
+        if (saveCursor < saveOrder.size ())
+            saveOrder[saveCursor] = it;
+        else
+            saveOrder.push_back (it);
+    }
+    saveCursor++;
+    if (idx < 0) return;
+
+    if (reduceType == REDUCE_NONE)
+    {
+        saveValue (reductions[idx].vec[0], n, z, f);
+        return;
+    }
+
+    reduction_t & r = reductions[idx];
+    nr_double_t v = real (z);
+    if (reduceCount == 0)
+    {
+        r.first = z;
+        r.sum = 0.0;
+        r.sqr = 0.0;
+        r.min = r.max = v;
+    }
+    r.sum += z;
+    r.sqr += norm (z);
+    if (v < r.min) r.min = v;
+    if (v > r.max) r.max = v;
+}
+
+/* Appends the value to the given dataset vector.  The vector is
+   looked up, or created, only if not yet known. */
+void trsolver::saveValue (qucs::vector *& vec, const std::string &n,
+                          nr_complex_t z, qucs::vector * f)
+{
+    if (vec == NULL)
+    {
+        analysis::saveVariable (n, z, f);
+        vec = data->findVariable (n);
+    }
+    else
+    {
+        vec->add (z);
+    }
+}
+
+/* Saves the reduced values of the current window into the dataset. */
+void trsolver::flushResults (void)
+{
+    if (reduceType == REDUCE_NONE || reduceCount == 0) return;
+
+    qucs::vector * t = data->findDependency ("time");
+    if (runs == 1)
+        t->add (reduceType == REDUCE_DECIMATE ? reduceStart : reduceStop);
+
+    for (auto & r : reductions)
+    {
+        switch (reduceType)
+        {
+        case REDUCE_DECIMATE:
+            saveValue (r.vec[0], r.name, r.first, r.dep);
+            break;
+        case REDUCE_AVERAGE:
+            saveValue (r.vec[0], r.name, r.sum / (nr_double_t) reduceCount,
+                       r.dep);
+            break;
+        case REDUCE_RMS:
+            saveValue (r.vec[0], r.name, std::sqrt (r.sqr / reduceCount),
+                       r.dep);
+            break;
+        case REDUCE_ENVELOPE:
+            saveValue (r.vec[0], r.name + ".min", r.min, r.dep);
+            saveValue (r.vec[1], r.name + ".max", r.max, r.dep);
+            break;
+        }
+    }
+    reduceCount = 0;
 }
 
 /* This function is meant to adapt the current time-step the transient
@@ -957,8 +1375,24 @@ PROP_OPT [] =
     { "LTEfactor", PROP_REAL, { 1, PROP_NO_STR }, PROP_RNGII (1, 16) },
     { "Temp", PROP_REAL, { 26.85, PROP_NO_STR }, PROP_MIN_VAL (K) },
     { "Solver", PROP_STR, { PROP_NO_VAL, "CroutLU" }, PROP_RNG_SOL },
+    { "Ordering", PROP_STR, { PROP_NO_VAL, "none" }, PROP_RNG_ORD },
     { "relaxTSR", PROP_STR, { PROP_NO_VAL, "no" }, PROP_RNG_YESNO },
+    { "Breakpoints", PROP_STR, { PROP_NO_VAL, "yes" }, PROP_RNG_YESNO },
     { "initialDC", PROP_STR, { PROP_NO_VAL, "yes" }, PROP_RNG_YESNO },
+    {
+        "Newton", PROP_STR, { PROP_NO_VAL, "full" },
+        PROP_RNG_STR2 ("full", "chord")
+    },
+    {
+        "Digital", PROP_STR, { PROP_NO_VAL, "analog" },
+        PROP_RNG_STR2 ("analog", "event")
+    },
+    { "Save", PROP_STR, { PROP_NO_VAL, "*" }, PROP_NO_RANGE },
+    {
+        "Reduce", PROP_STR, { PROP_NO_VAL, "none" },
+        PROP_RNG_STR5 ("none", "decimate", "envelope", "average", "rms")
+    },
+    { "Window", PROP_INT, { 1, PROP_NO_STR }, PROP_MIN_VAL (1) },
     PROP_NO_PROP
 };
 struct define_t trsolver::anadef =
@@ -25,14 +25,28 @@
 #ifndef __TRSOLVER_H__
 #define __TRSOLVER_H__
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "nasolver.h"
 #include "states.h"
 
 namespace qucs {
 
+// Output reduction types.
+enum reduce_type {
+    REDUCE_NONE = 0,
+    REDUCE_DECIMATE,
+    REDUCE_ENVELOPE,
+    REDUCE_AVERAGE,
+    REDUCE_RMS
+};
+
 class sweep;
 class circuit;
 class history;
+class eventsim;
 
 class trsolver : public nasolver<nr_double_t>, public states<nr_double_t>
 {
@@ -46,17 +60,29 @@ public:
     int  corrector (void);
     void nextStates (void);
     void fillStates (void);
+    void initStateArena (void);
+    void freeStateArena (void);
+    void freeEventKernel (void);
+    void releaseCircuits (void);
     void setMode (int);
     void setDelta (void);
     void adjustDelta (nr_double_t);
     void adjustOrder (int reduce = 0);
+    nr_double_t nextBreakpoint (nr_double_t);
     void initTR (void);
     void deinitTR (void);
     static void calcTR (trsolver *);
     void initDC (void);
     static void calcDC (trsolver *);
     void initSteps (void);
+    void selectSolver (void);
     void saveAllResults (nr_double_t);
+    void saveVariable (const std::string &, nr_complex_t, qucs::vector *);
+    void saveValue (qucs::vector *&, const std::string &, nr_complex_t,
+                    qucs::vector *);
+    void initSave (void);
+    bool isSaved (const std::string &);
+    void flushResults (void);
     nr_double_t checkDelta (void);
     void updateCoefficients (nr_double_t);
     void initHistory (nr_double_t);
@@ -98,8 +124,44 @@ protected:
     history * tHistory;
     bool relaxTSR;
     bool initialDC;
+    nr_double_t breakpoint; // next corner of the transient sources
+    bool breakHit;          // the last accepted step hit a breakpoint
+    nr_double_t chordDelta; // step size of the last corrector process
+    int chordType;          // its corrector method
+    int chordOrder;         // and order
+
+    // output filter and reduction
+    struct reduction_t
+    {
+        std::string name;
+        qucs::vector * dep;
+        qucs::vector * vec[2]; // dataset vectors, resolved when first saved
+        nr_complex_t first;
+        nr_complex_t sum;
+        nr_double_t sqr;
+        nr_double_t min;
+        nr_double_t max;
+    };
+    std::vector<std::string> savePatterns;
+    std::map<std::string, int> saveIndex;
+    std::vector<std::map<std::string, int>::iterator> saveOrder;
+    size_t saveCursor;
+    std::vector<reduction_t> reductions;
+    int reduceType;
+    int reduceWindow;
+    int reduceCount;
+    nr_double_t reduceStart;
+    nr_double_t reduceStop;
     int ohm;
 
+    // save-state variables of all circuits
+    nr_double_t * stateArena; // STATE_NUM values per state
+    int stateArenaSize;       // number of states in the arena
+    int stateArenaCurrent;    // state index shared by all circuits
+
+    // event driven kernel for the digital gates
+    eventsim * eventKernel;
+
 };
 
 } // namespace qucs
@@ -107,11 +107,9 @@ tvector<nr_type_t> operator + (tvector<nr_type_t> a, tvector<nr_type_t> b) {
 
 // Intrinsic vector addition.
 template <class nr_type_t>
-tvector<nr_type_t> tvector<nr_type_t>::operator += (tvector<nr_type_t> a) {
-  assert (a.getSize () == (int)data.size ());
-  std::vector<nr_type_t> * src = a.getData ();
-  std::vector<nr_type_t> * dst = data;
-  for (int i = 0; i < (int)data.size (); i++) (*dst)[i] += (*src)[i];
+tvector<nr_type_t>& tvector<nr_type_t>::operator += (const tvector<nr_type_t> & a) {
+  assert (a.size () == data.size ());
+  for (std::size_t i = 0; i < data.size (); i++) data[i] += a.data[i];
   return *this;
 }
 
@@ -127,27 +125,23 @@ tvector<nr_type_t> operator - (tvector<nr_type_t> a, tvector<nr_type_t> b) {
 
 // Intrinsic vector subtraction.
 template <class nr_type_t>
-tvector<nr_type_t> tvector<nr_type_t>::operator -= (tvector<nr_type_t> a) {
-  assert (a.size () == (int)data.size ());
-  std::vector<nr_type_t> * src = a.getData ();
-  std::vector<nr_type_t> * dst = data;
-  for (int i = 0; i < (int)data.size (); i++) (*dst)[i] -= (*src)[i];
+tvector<nr_type_t>& tvector<nr_type_t>::operator -= (const tvector<nr_type_t> & a) {
+  assert (a.size () == data.size ());
+  for (std::size_t i = 0; i < data.size (); i++) data[i] -= a.data[i];
   return *this;
 }
 
 // Intrinsic scalar multiplication.
 template <class nr_type_t>
-tvector<nr_type_t> tvector<nr_type_t>::operator *= (nr_double_t s) {
-  std::vector<nr_type_t> * dst = data;
-  for (int i = 0; i < (int)data.size (); i++) (*dst)[i] *= s;
+tvector<nr_type_t>& tvector<nr_type_t>::operator *= (nr_double_t s) {
+  for (std::size_t i = 0; i < data.size (); i++) data[i] *= s;
   return *this;
 }
 
 // Intrinsic scalar division.
 template <class nr_type_t>
-tvector<nr_type_t> tvector<nr_type_t>::operator /= (nr_double_t s) {
-  std::vector<nr_type_t> * dst = data;
-  for (int i = 0; i < (int)data.size (); i++) (*dst)[i] /= s;
+tvector<nr_type_t>& tvector<nr_type_t>::operator /= (nr_double_t s) {
+  for (std::size_t i = 0; i < data.size (); i++) data[i] /= s;
   return *this;
 }
 
@@ -177,25 +171,37 @@ tvector<nr_type_t> operator * (tvector<nr_type_t> a, tvector<nr_type_t> b) {
 
 // Computes the scalar product of two vectors.
 template <class nr_type_t>
-nr_type_t scalar (tvector<nr_type_t> a, tvector<nr_type_t> b) {
+nr_type_t scalar (const tvector<nr_type_t> & a, const tvector<nr_type_t> & b) {
   assert (a.size () == b.size ());
   nr_type_t n = 0;
-  for (int i = 0; i < a.size (); i++) n += a.get (i) * b.get (i);
+  for (std::size_t i = 0; i < a.size (); i++) n += a[i] * b[i];
   return n;
 }
 
+/* Computes res = s * a + b into the preallocated vector 'res' which
+   may alias 'b'. */
+template <class nr_type_t>
+void axpy (nr_double_t s, const tvector<nr_type_t> & a,
+	   const tvector<nr_type_t> & b, tvector<nr_type_t> & res) {
+  assert (a.size () == b.size () && b.size () == res.size ());
+  const nr_type_t * x = a.getData ();
+  const nr_type_t * y = b.getData ();
+  nr_type_t * r = res.getData ();
+  for (std::size_t i = 0; i < res.size (); i++) r[i] = y[i] + s * x[i];
+}
+
 // Constant assignment operation.
 template <class nr_type_t>
-tvector<nr_type_t> tvector<nr_type_t>::operator = (const nr_type_t val) {
-  for (int i = 0; i < (int)data.size (); i++) (*data)[i] = val;
+tvector<nr_type_t>& tvector<nr_type_t>::operator = (const nr_type_t val) {
+  for (std::size_t i = 0; i < data.size (); i++) data[i] = val;
   return *this;
 }
 
 // Returns the sum of the vector elements.
 template <class nr_type_t>
-nr_type_t sum (tvector<nr_type_t> a) {
+nr_type_t sum (const tvector<nr_type_t> & a) {
   nr_type_t res = 0;
-  for (int i = 0; i < a.size (); i++) res += a.get (i);
+  for (std::size_t i = 0; i < a.size (); i++) res += a[i];
   return res;
 }
 
@@ -242,7 +248,7 @@ tvector<nr_type_t> operator + (tvector<nr_type_t> a, nr_type_t s) {
 
 // Mean square norm.
 template <class nr_type_t>
-nr_double_t norm (tvector<nr_type_t> a) {
+nr_double_t norm (const tvector<nr_type_t> & a) {
 #if 0
   nr_double_t k = 0;
   for (int i = 0; i < a.size (); i++) k += norm (a.get (i));
@@ -281,10 +287,10 @@ nr_double_t norm (tvector<nr_type_t> a) {
 
 // Maximum norm.
 template <class nr_type_t>
-nr_double_t maxnorm (tvector<nr_type_t> a) {
+nr_double_t maxnorm (const tvector<nr_type_t> & a) {
   nr_double_t nMax = 0, n;
-  for (int i = 0; i < a.size (); i++) {
-    n = norm (a.get (i));
+  for (std::size_t i = 0; i < a.size (); i++) {
+    n = norm (a[i]);
     if (n > nMax) nMax = n;
   }
   return nMax;
@@ -39,13 +39,16 @@ class tvector;
 
 // Forward declarations of friend functions.
 template <class nr_type_t>
-nr_type_t   scalar (tvector<nr_type_t>, tvector<nr_type_t>);
+nr_type_t   scalar (const tvector<nr_type_t> &, const tvector<nr_type_t> &);
 template <class nr_type_t>
-nr_double_t maxnorm (tvector<nr_type_t>);
+nr_double_t maxnorm (const tvector<nr_type_t> &);
 template <class nr_type_t>
-nr_double_t norm (tvector<nr_type_t>);
+nr_double_t norm (const tvector<nr_type_t> &);
 template <class nr_type_t>
-nr_type_t   sum (tvector<nr_type_t>);
+nr_type_t   sum (const tvector<nr_type_t> &);
+template <class nr_type_t>
+void axpy (nr_double_t, const tvector<nr_type_t> &,
+	   const tvector<nr_type_t> &, tvector<nr_type_t> &);
 template <class nr_type_t>
 tvector<nr_type_t> conj (tvector<nr_type_t>);
 template <class nr_type_t>
@@ -76,7 +79,10 @@ class tvector
   tvector () = default;
   tvector (const std::size_t i) : data(i) {};
   tvector (const tvector &) = default;
+  tvector (tvector &&) = default;
   ~tvector () = default;
+  tvector& operator = (const tvector &) = default;
+  tvector& operator = (tvector &&) = default;
   nr_type_t get (int);
   void set (int, nr_type_t);
   void set (nr_type_t);
@@ -84,6 +90,7 @@ class tvector
   void set (tvector, int, int);
   std::size_t  size (void) const { return data.size (); }
   nr_type_t * getData (void) { return data.data(); }
+  const nr_type_t * getData (void) const { return data.data(); }
   void clear (void);
   void exchangeRows (int, int);
   int  isFinite (void);
@@ -105,10 +112,10 @@ class tvector
 
   // other operations
 #ifndef _MSC_VER
-  friend nr_double_t norm<> (tvector);
-  friend nr_double_t maxnorm<> (tvector);
-  friend nr_type_t   sum<> (tvector);
-  friend nr_type_t   scalar<> (tvector, tvector);
+  friend nr_double_t norm<> (const tvector &);
+  friend nr_double_t maxnorm<> (const tvector &);
+  friend nr_type_t   sum<> (const tvector &);
+  friend nr_type_t   scalar<> (const tvector &, const tvector &);
   friend tvector     conj<> (tvector);
 #endif
 
@@ -119,13 +126,13 @@ class tvector
 #endif
 
   // intrinsic operators
-  tvector operator += (tvector);
-  tvector operator -= (tvector);
-  tvector operator *= (nr_double_t);
-  tvector operator /= (nr_double_t);
+  tvector& operator += (const tvector &);
+  tvector& operator -= (const tvector &);
+  tvector& operator *= (nr_double_t);
+  tvector& operator /= (nr_double_t);
 
   // assignment operators
-  tvector operator = (const nr_type_t);
+  tvector& operator = (const nr_type_t);
 
   // easy accessor operators
   nr_type_t  operator () (int i) const {
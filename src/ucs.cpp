@@ -31,6 +31,7 @@
 #include <assert.h>
 #include <string.h>
 #include <time.h>
+#include <errno.h>
 #include <list>
 #include <iostream>
 #include <fstream>
@@ -47,6 +48,10 @@
 #include "exceptionstack.h"
 #include "check_netlist.h"
 #include "module.h"
+#include "server.h"
+#include "profile.h"
+#include "prima.h"
+#include "netcache.h"
 
 #if HAVE_UNISTD_H
 #include <unistd.h>
@@ -60,6 +65,8 @@ int main (int argc, char ** argv) {
   char * infile = NULL;
   char * outfile = NULL;
   char * projPath = NULL;
+  char * sockfile = NULL;
+  char * profileJSON = NULL;
   net * subnet;
   input * in;
   circuit * gnd;
@@ -68,6 +75,7 @@ int main (int argc, char ** argv) {
   int listing = 0;
   int ret = 0;
   int dynamicLoad = 0;
+  int serverMode = 0;
 
   std::list<std::string> vamodules;
 
@@ -108,6 +116,20 @@ int main (int argc, char ** argv) {
 #endif
     "  -p, --path     project path (or location of dynamic modules)\n"
     "  -m, --module   list of dynamic loaded modules (base names separated by space)\n"
+	"  -s, --server   run as simulation server reading jobs from stdin\n"
+	"  --socket FILE  run as simulation server listening on a local socket\n"
+	"  --profile      print performance counters per analysis to stderr\n"
+	"  --profile-json FILE\n"
+	"                 write performance counters per analysis as JSON\n"
+	"  --reduce N     replace large linear RLC networks by reduced order\n"
+	"                 models matching N block moments at DC and at the\n"
+	"                 expansion frequency; networks with inductors or\n"
+	"                 without DC path are expanded at a thousandth of\n"
+	"                 the expansion frequency instead of DC\n"
+	"  --reduce-freq F\n"
+	"                 expansion frequency (default 1 GHz)\n"
+	"  --cache DIR    keep parsed netlists in DIR and reuse them for\n"
+	"                 unchanged netlist files\n"
 	"\nReport bugs to <" PACKAGE_BUGREPORT ">.\n", argv[0]);
       return 0;
     }
@@ -137,6 +159,29 @@ int main (int argc, char ** argv) {
     else if (!strcmp (argv[i], "-m") || !strcmp (argv[i], "--module")) {
       dynamicLoad = 1;
     }
+    else if (!strcmp (argv[i], "-s") || !strcmp (argv[i], "--server")) {
+      serverMode = 1;
+    }
+    else if (!strcmp (argv[i], "--socket")) {
+      sockfile = argv[++i];
+      serverMode = 1;
+    }
+    else if (!strcmp (argv[i], "--profile")) {
+      profile::enabled = 1;
+    }
+    else if (!strcmp (argv[i], "--profile-json")) {
+      profileJSON = argv[++i];
+      profile::enabled = 1;
+    }
+    else if (!strcmp (argv[i], "--reduce")) {
+      prima::order = atoi (argv[++i]);
+    }
+    else if (!strcmp (argv[i], "--reduce-freq")) {
+      prima::frequency = atof (argv[++i]);
+    }
+    else if (!strcmp (argv[i], "--cache")) {
+      netcache::directory = argv[++i];
+    }
     else {
       if (dynamicLoad) {
         vamodules.push_back(argv[i]);
@@ -161,7 +206,7 @@ int main (int argc, char ** argv) {
     module::registerDynamicModules (projPath, vamodules);
   }
 
-  else { //no argument, look into netlist
+  else if (!serverMode) { //no argument, look into netlist
 
     std::string sLine = "";
     std::ifstream file;
@@ -216,6 +261,19 @@ int main (int argc, char ** argv) {
     file.close();
   }
 
+  // run as persistent simulation server, the modules stay registered
+  // and the netlists are loaded by the jobs
+  if (serverMode) {
+    qucs::server * srv = new qucs::server ();
+    if (sockfile)
+      ret = srv->listen (sockfile);
+    else
+      srv->serve (stdin, stdout);
+    delete srv;
+    module::unregisterModules ();
+    module::closeDynamicLibs ();
+    return ret;
+  }
 
   // create root environment
   root = new environment (std::string("root"));
@@ -252,10 +310,28 @@ int main (int argc, char ** argv) {
   ret |= err;
 
   // evaluate output dataset
-  ret |= root->equationSolver (out);
+  {
+    profile_scope scope ("(output)");
+    profile_timer t (PROFILE_EQUATIONS);
+    ret |= root->equationSolver (out);
+  }
   out->setFile (outfile);
   out->print ();
 
+  // emit performance counters if requested
+  if (profile::enabled) {
+    FILE * f;
+    if (profileJSON == NULL)
+      profile::print (stderr);
+    else if ((f = fopen (profileJSON, "w")) != NULL) {
+      profile::printJSON (f);
+      fclose (f);
+    }
+    else
+      logprint (LOG_ERROR, "cannot create file `%s': %s\n",
+		profileJSON, strerror (errno));
+  }
+
   estack.print ("uncaught");
 
   delete subnet;
@@ -28,6 +28,7 @@
 #endif
 
 #include <limits>
+#include <utility>
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -136,6 +137,38 @@ const vector& vector::operator=(const vector & v) {
   return *this;
 }
 
+/* The move constructor takes over the data and all properties of the
+   given vector object, which is left empty. */
+vector::vector (vector && v) noexcept : object (v) {
+  size = v.size;
+  capacity = v.capacity;
+  data = v.data;
+  dependencies = v.dependencies;
+  origin = v.origin;
+  requested = v.requested;
+  next = v.next;
+  prev = v.prev;
+  v.size = v.capacity = 0;
+  v.data = NULL;
+  v.dependencies = NULL;
+  v.origin = NULL;
+}
+
+/* The move assignment takes over the data of the given vector object
+   without copying it.  Like the copy assignment it leaves any other
+   properties untouched. */
+const vector& vector::operator=(vector && v) noexcept {
+  if (&v != this) {
+    free (data);
+    size = v.size;
+    capacity = v.capacity;
+    data = v.data;
+    v.size = v.capacity = 0;
+    v.data = NULL;
+  }
+  return *this;
+}
+
 // Destructor deletes a vector object.
 vector::~vector () {
   free (data);
@@ -276,39 +309,33 @@ nr_complex_t avg (vector v) {
 }
 
 vector signum (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (signum (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = signum (v.data[i]);
+  return v;
 }
 
 vector sign (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (sign (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = sign (v.data[i]);
+  return v;
 }
 
 vector xhypot (vector v, const nr_complex_t z) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (xhypot (v.get(i), z), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = xhypot (v.data[i], z);
+  return v;
 }
 
 vector xhypot (vector v, const nr_double_t d) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (xhypot (v.get(i), d), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = xhypot (v.data[i], d);
+  return v;
 }
 
 vector xhypot (const nr_complex_t z, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (xhypot (z, v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = xhypot (z, v.data[i]);
+  return v;
 }
 
 vector xhypot (const nr_double_t d, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (xhypot (d, v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = xhypot (d, v.data[i]);
+  return v;
 }
 
 vector xhypot (vector v1, vector v2) {
@@ -329,112 +356,110 @@ vector xhypot (vector v1, vector v2) {
 }
 
 vector sinc (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (sinc (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = sinc (v.data[i]);
+  return v;
 }
 
 vector abs (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (abs (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = abs (v.data[i]);
+  return v;
 }
 
+/* The following functions work on the interleaved real and imaginary
+   parts of the data directly, thus the compiler is able to vectorize
+   their loops. */
 vector norm (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (norm (v.get (i)), i);
-  return result;
+  nr_double_t * d = (nr_double_t *) v.data;
+  for (int i = 0; i < 2 * v.size; i += 2) {
+    d[i] = d[i] * d[i] + d[i + 1] * d[i + 1];
+    d[i + 1] = 0.0;
+  }
+  return v;
 }
 
 vector arg (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (arg (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = arg (v.data[i]);
+  return v;
 }
 
 vector real (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (real (v.get (i)), i);
-  return result;
+  nr_double_t * d = (nr_double_t *) v.data;
+  for (int i = 0; i < 2 * v.size; i += 2) d[i + 1] = 0.0;
+  return v;
 }
 
 vector imag (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (imag (v.get (i)), i);
-  return result;
+  nr_double_t * d = (nr_double_t *) v.data;
+  for (int i = 0; i < 2 * v.size; i += 2) {
+    d[i] = d[i + 1];
+    d[i + 1] = 0.0;
+  }
+  return v;
 }
 
 vector conj (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (conj (v.get (i)), i);
-  return result;
+  nr_double_t * d = (nr_double_t *) v.data;
+  for (int i = 1; i < 2 * v.size; i += 2) d[i] = -d[i];
+  return v;
 }
 
 vector dB (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++)
-    result.set (10.0 * std::log10 (norm (v.get (i))), i);
-  return result;
+  nr_double_t * d = (nr_double_t *) v.data;
+  for (int i = 0; i < 2 * v.size; i += 2) {
+    d[i] = 10.0 * std::log10 (d[i] * d[i] + d[i + 1] * d[i + 1]);
+    d[i + 1] = 0.0;
+  }
+  return v;
 }
 
 vector sqrt (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (sqrt (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = sqrt (v.data[i]);
+  return v;
 }
 
 vector exp (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (exp (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = exp (v.data[i]);
+  return v;
 }
 
 vector limexp (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (limexp (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = limexp (v.data[i]);
+  return v;
 }
 
 vector log (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (log (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = log (v.data[i]);
+  return v;
 }
 
 vector log10 (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (log10 (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = log10 (v.data[i]);
+  return v;
 }
 
 vector log2 (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (log2 (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = log2 (v.data[i]);
+  return v;
 }
 
 vector pow (vector v, const nr_complex_t z) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (pow (v.get(i), z), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = pow (v.data[i], z);
+  return v;
 }
 
 vector pow (vector v, const nr_double_t d) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (pow (v.get(i), d), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = pow (v.data[i], d);
+  return v;
 }
 
 vector pow (const nr_complex_t z, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (pow (z, v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = pow (z, v.data[i]);
+  return v;
 }
 
 vector pow (const nr_double_t d, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (pow (d, v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = pow (d, v.data[i]);
+  return v;
 }
 
 vector pow (vector v1, vector v2) {
@@ -455,145 +480,122 @@ vector pow (vector v1, vector v2) {
 }
 
 vector sin (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (sin (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = sin (v.data[i]);
+  return v;
 }
 
 vector asin (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (asin (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = asin (v.data[i]);
+  return v;
 }
 
 vector acos (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (acos (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = acos (v.data[i]);
+  return v;
 }
 
 vector cos (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (cos (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = cos (v.data[i]);
+  return v;
 }
 
 vector tan (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (tan (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = tan (v.data[i]);
+  return v;
 }
 
 vector atan (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (atan (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = atan (v.data[i]);
+  return v;
 }
 
 vector cot (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (cot (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = cot (v.data[i]);
+  return v;
 }
 
 vector acot (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (acot (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = acot (v.data[i]);
+  return v;
 }
 
 vector sinh (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (sinh (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = sinh (v.data[i]);
+  return v;
 }
 
 vector asinh (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (asinh (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = asinh (v.data[i]);
+  return v;
 }
 
 vector cosh (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (cosh (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = cosh (v.data[i]);
+  return v;
 }
 
 vector sech (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (sech (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = sech (v.data[i]);
+  return v;
 }
 
 vector cosech (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (cosech (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = cosech (v.data[i]);
+  return v;
 }
 
 vector acosh (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (acosh (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = acosh (v.data[i]);
+  return v;
 }
 
 vector asech (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (asech (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = asech (v.data[i]);
+  return v;
 }
 
 vector tanh (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (tanh (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = tanh (v.data[i]);
+  return v;
 }
 
 vector atanh (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (atanh (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = atanh (v.data[i]);
+  return v;
 }
 
 vector coth (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (coth (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = coth (v.data[i]);
+  return v;
 }
 
 vector acoth (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (acoth (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = acoth (v.data[i]);
+  return v;
 }
 
 // converts impedance to reflexion coefficient
 vector ztor (vector v, nr_complex_t zref) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result (i) = ztor (v (i), zref);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = ztor (v.data[i], zref);
+  return v;
 }
 
 // converts admittance to reflexion coefficient
 vector ytor (vector v, nr_complex_t zref) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result (i) = ytor (v (i), zref);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = ytor (v.data[i], zref);
+  return v;
 }
 
 // converts reflexion coefficient to impedance
 vector rtoz (vector v, nr_complex_t zref) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result (i) = rtoz (v (i), zref);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = rtoz (v.data[i], zref);
+  return v;
 }
 
 // converts reflexion coefficient to admittance
 vector rtoy (vector v, nr_complex_t zref) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result (i) = rtoy (v (i), zref);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = rtoy (v.data[i], zref);
+  return v;
 }
 
 // differentiates 'var' with respect to 'dep' exactly 'n' times
@@ -635,29 +637,32 @@ vector diff (vector var, vector dep, int n) {
   return result;
 }
 
-vector vector::operator=(const nr_complex_t c) {
+vector& vector::operator=(const nr_complex_t c) {
   for (int i = 0; i < size; i++) data[i] = c;
   return *this;
 }
 
-vector vector::operator=(const nr_double_t d) {
+vector& vector::operator=(const nr_double_t d) {
   for (int i = 0; i < size; i++) data[i] = d;
   return *this;
 }
 
-vector vector::operator+=(vector v) {
+vector& vector::operator+=(const vector & v) {
   int i, n, len = v.getSize ();
   assert (size % len == 0);
-  for (i = n = 0; i < size; i++) { data[i] += v (n); if (++n >= len) n = 0; }
+  if (len == size)
+    for (i = 0; i < size; i++) data[i] += v.data[i];
+  else
+    for (i = n = 0; i < size; i++) { data[i] += v (n); if (++n >= len) n = 0; }
   return *this;
 }
 
-vector vector::operator+=(const nr_complex_t c) {
+vector& vector::operator+=(const nr_complex_t c) {
   for (int i = 0; i < size; i++) data[i] += c;
   return *this;
 }
 
-vector vector::operator+=(const nr_double_t d) {
+vector& vector::operator+=(const nr_double_t d) {
   for (int i = 0; i < size; i++) data[i] += d;
   return *this;
 }
@@ -666,19 +671,18 @@ vector operator+(vector v1, vector v2) {
   int len1 = v1.getSize (), len2 = v2.getSize ();
   vector result;
   if (len1 >= len2) {
-    result  = v1;
-    result += v2;
+    v1 += v2;
+    result = std::move (v1);
   } else {
-    result  = v2;
-    result += v1;
+    v2 += v1;
+    result = std::move (v2);
   }
   return result;
 }
 
 vector operator+(vector v, const nr_complex_t c) {
-  vector result (v);
-  result += c;
-  return result;
+  v += c;
+  return v;
 }
 
 vector operator+(const nr_complex_t c, vector v) {
@@ -686,9 +690,8 @@ vector operator+(const nr_complex_t c, vector v) {
 }
 
 vector operator+(vector v, const nr_double_t d) {
-  vector result (v);
-  result += d;
-  return result;
+  v += d;
+  return v;
 }
 
 vector operator+(const nr_double_t d, vector v) {
@@ -701,19 +704,22 @@ vector vector::operator-() {
   return result;
 }
 
-vector vector::operator-=(vector v) {
+vector& vector::operator-=(const vector & v) {
   int i, n, len = v.getSize ();
   assert (size % len == 0);
-  for (i = n = 0; i < size; i++) { data[i] -= v (n); if (++n >= len) n = 0; }
+  if (len == size)
+    for (i = 0; i < size; i++) data[i] -= v.data[i];
+  else
+    for (i = n = 0; i < size; i++) { data[i] -= v (n); if (++n >= len) n = 0; }
   return *this;
 }
 
-vector vector::operator-=(const nr_complex_t c) {
+vector& vector::operator-=(const nr_complex_t c) {
   for (int i = 0; i < size; i++) data[i] -= c;
   return *this;
 }
 
-vector vector::operator-=(const nr_double_t d) {
+vector& vector::operator-=(const nr_double_t d) {
   for (int i = 0; i < size; i++) data[i] -= d;
   return *this;
 }
@@ -722,52 +728,55 @@ vector operator-(vector v1, vector v2) {
   int len1 = v1.getSize (), len2 = v2.getSize ();
   vector result;
   if (len1 >= len2) {
-    result  = v1;
-    result -= v2;
+    v1 -= v2;
+    result = std::move (v1);
   } else {
-    result  = -v2;
-    result += v1;
+    assert (len2 % len1 == 0);
+    for (int i = 0, n = 0; i < len2; i++) {
+      v2.data[i] = -v2.data[i] + v1.data[n];
+      if (++n >= len1) n = 0;
+    }
+    result = std::move (v2);
   }
   return result;
 }
 
 vector operator-(vector v, const nr_complex_t c) {
-  vector result (v);
-  result -= c;
-  return result;
+  v -= c;
+  return v;
 }
 
 vector operator-(vector v, const nr_double_t d) {
-  vector result (v);
-  result -= d;
-  return result;
+  v -= d;
+  return v;
 }
 
 vector operator-(const nr_complex_t c, vector v) {
-  vector result (-v);
-  result += c;
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = -v.data[i] + c;
+  return v;
 }
 
 vector operator-(const nr_double_t d, vector v) {
-  vector result (-v);
-  result += d;
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = -v.data[i] + d;
+  return v;
 }
 
-vector vector::operator*=(vector v) {
+vector& vector::operator*=(const vector & v) {
   int i, n, len = v.getSize ();
   assert (size % len == 0);
-  for (i = n = 0; i < size; i++) { data[i] *= v (n); if (++n >= len) n = 0; }
+  if (len == size)
+    for (i = 0; i < size; i++) data[i] *= v.data[i];
+  else
+    for (i = n = 0; i < size; i++) { data[i] *= v (n); if (++n >= len) n = 0; }
   return *this;
 }
 
-vector vector::operator*=(const nr_complex_t c) {
+vector& vector::operator*=(const nr_complex_t c) {
   for (int i = 0; i < size; i++) data[i] *= c;
   return *this;
 }
 
-vector vector::operator*=(const nr_double_t d) {
+vector& vector::operator*=(const nr_double_t d) {
   for (int i = 0; i < size; i++) data[i] *= d;
   return *this;
 }
@@ -776,25 +785,23 @@ vector operator*(vector v1, vector v2) {
   int len1 = v1.getSize (), len2 = v2.getSize ();
   vector result;
   if (len1 >= len2) {
-    result  = v1;
-    result *= v2;
+    v1 *= v2;
+    result = std::move (v1);
   } else {
-    result  = v2;
-    result *= v1;
+    v2 *= v1;
+    result = std::move (v2);
   }
   return result;
 }
 
 vector operator*(vector v, const nr_complex_t c) {
-  vector result (v);
-  result *= c;
-  return result;
+  v *= c;
+  return v;
 }
 
 vector operator*(vector v, const nr_double_t d) {
-  vector result (v);
-  result *= d;
-  return result;
+  v *= d;
+  return v;
 }
 
 vector operator*(const nr_complex_t c, vector v) {
@@ -805,19 +812,22 @@ vector operator*(const nr_double_t d, vector v) {
   return v * d;
 }
 
-vector vector::operator/=(vector v) {
+vector& vector::operator/=(const vector & v) {
   int i, n, len = v.getSize ();
   assert (size % len == 0);
-  for (i = n = 0; i < size; i++) { data[i] /= v (n); if (++n >= len) n = 0; }
+  if (len == size)
+    for (i = 0; i < size; i++) data[i] /= v.data[i];
+  else
+    for (i = n = 0; i < size; i++) { data[i] /= v (n); if (++n >= len) n = 0; }
   return *this;
 }
 
-vector vector::operator/=(const nr_complex_t c) {
+vector& vector::operator/=(const nr_complex_t c) {
   for (int i = 0; i < size; i++) data[i] /= c;
   return *this;
 }
 
-vector vector::operator/=(const nr_double_t d) {
+vector& vector::operator/=(const nr_double_t d) {
   for (int i = 0; i < size; i++) data[i] /= d;
   return *this;
 }
@@ -827,40 +837,38 @@ vector operator/(vector v1, vector v2) {
   vector result;
   if (len1 >= len2) {
     assert (len1 % len2 == 0);
-    result  = v1;
-    result /= v2;
+    v1 /= v2;
+    result = std::move (v1);
   } else {
     assert (len2 % len1 == 0);
-    result  = 1 / v2;
-    result *= v1;
+    for (int i = 0, n = 0; i < len2; i++) {
+      v2.data[i] = 1.0 / v2.data[i];
+      v2.data[i] *= v1.data[n];
+      if (++n >= len1) n = 0;
+    }
+    result = std::move (v2);
   }
   return result;
 }
 
 vector operator/(vector v, const nr_complex_t c) {
-  vector result (v);
-  result /= c;
-  return result;
+  v /= c;
+  return v;
 }
 
 vector operator/(vector v, const nr_double_t d) {
-  vector result (v);
-  result /= d;
-  return result;
+  v /= d;
+  return v;
 }
 
 vector operator/(const nr_complex_t c, vector v) {
-  vector result (v);
-  result  = c;
-  result /= v;
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = c / v.data[i];
+  return v;
 }
 
 vector operator/(const nr_double_t d, vector v) {
-  vector result (v);
-  result  = d;
-  result /= v;
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = d / v.data[i];
+  return v;
 }
 
 vector operator%(vector v, const nr_complex_t z) {
@@ -999,69 +1007,60 @@ vector logspace (nr_double_t start, nr_double_t stop, int points) {
 }
 
 vector cumsum (vector v) {
-  vector result (v);
   nr_complex_t val (0.0);
-  for (int i = 0; i < v.getSize (); i++) {
-    val += v.get (i);
-    result.set (val, i);
+  for (int i = 0; i < v.size; i++) {
+    val += v.data[i];
+    v.data[i] = val;
   }
-  return result;
+  return v;
 }
 
 vector cumavg (vector v) {
-  vector result (v);
   nr_complex_t val (0.0);
-  for (int i = 0; i < v.getSize (); i++) {
-    val = (val * (nr_double_t) i + v.get (i)) / (i + 1.0);
-    result.set (val, i);
+  for (int i = 0; i < v.size; i++) {
+    val = (val * (nr_double_t) i + v.data[i]) / (i + 1.0);
+    v.data[i] = val;
   }
-  return result;
+  return v;
 }
 
 vector cumprod (vector v) {
-  vector result (v);
   nr_complex_t val (1.0);
-  for (int i = 0; i < v.getSize (); i++) {
-    val *= v.get (i);
-    result.set (val, i);
+  for (int i = 0; i < v.size; i++) {
+    val *= v.data[i];
+    v.data[i] = val;
   }
-  return result;
+  return v;
 }
 
 vector ceil (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (ceil (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = ceil (v.data[i]);
+  return v;
 }
 
 vector fix (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (fix (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = fix (v.data[i]);
+  return v;
 }
 
 vector floor (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (floor (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = floor (v.data[i]);
+  return v;
 }
 
 vector round (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (round (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = round (v.data[i]);
+  return v;
 }
 
 vector sqr (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (sqr (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = sqr (v.data[i]);
+  return v;
 }
 
 vector step (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (step (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = step (v.data[i]);
+  return v;
 }
 
 static nr_double_t integrate_n (vector v) { /* using trapezoidal rule */
@@ -1091,69 +1090,58 @@ nr_double_t vector::stddev (void) {
 }
 
 vector erf (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (erf (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = erf (v.data[i]);
+  return v;
 }
 
 vector erfc (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (erfc (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = erfc (v.data[i]);
+  return v;
 }
 
 vector erfinv (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (erfinv (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = erfinv (v.data[i]);
+  return v;
 }
 
 vector erfcinv (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (erfcinv (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = erfcinv (v.data[i]);
+  return v;
 }
 
 vector rad2deg (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (rad2deg (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = rad2deg (v.data[i]);
+  return v;
 }
 
 vector deg2rad (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (deg2rad (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = deg2rad (v.data[i]);
+  return v;
 }
 
 vector i0 (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (i0 (v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = i0 (v.data[i]);
+  return v;
 }
 
 vector jn (const int n, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (jn (n, v.get (i)), i);
-  return result;
+  jn (n, v.data, v.data, v.size);
+  return v;
 }
 
 vector yn (const int n, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (yn (n, v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = yn (n, v.data[i]);
+  return v;
 }
 
 vector polar (const nr_complex_t a, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (qucs::polar (a, v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = qucs::polar (a, v.data[i]);
+  return v;
 }
 
 vector polar (vector v, const nr_complex_t p) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++) result.set (qucs::polar (v.get (i), p), i);
-  return result;
+  for (int i = 0; i < v.size; i++) v.data[i] = qucs::polar (v.data[i], p);
+  return v;
 }
 
 vector polar (vector a, vector p) {
@@ -1174,17 +1162,15 @@ vector polar (vector a, vector p) {
 }
 
 vector atan2 (const nr_double_t y, vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++)
-    result.set (atan2 (y, v.get (i)), i);
-  return result;
+  for (int i = 0; i < v.size; i++)
+    v.data[i] = atan2 (y, v.data[i]);
+  return v;
 }
 
 vector atan2 (vector v, const nr_double_t x) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++)
-    result.set (atan2 (v.get (i), x) , i);
-  return result;
+  for (int i = 0; i < v.size; i++)
+    v.data[i] = atan2 (v.data[i], x);
+  return v;
 }
 
 vector atan2 (vector y, vector x) {
@@ -1205,17 +1191,15 @@ vector atan2 (vector y, vector x) {
 }
 
 vector w2dbm (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++)
-    result.set (10.0 * log10 (v.get (i) / 0.001), i);
-  return result;
+  for (int i = 0; i < v.size; i++)
+    v.data[i] = 10.0 * log10 (v.data[i] / 0.001);
+  return v;
 }
 
 vector dbm2w (vector v) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++)
-    result.set (0.001 * pow (10.0 , v.get (i) / 10.0), i);
-  return result;
+  for (int i = 0; i < v.size; i++)
+    v.data[i] = 0.001 * pow (10.0 , v.data[i] / 10.0);
+  return v;
 }
 
 nr_double_t integrate (vector v, const nr_double_t h) {
@@ -1234,10 +1218,9 @@ nr_complex_t integrate (vector v, const nr_complex_t h) {
 }
 
 vector dbm (vector v, const nr_complex_t z) {
-  vector result (v);
-  for (int i = 0; i < v.getSize (); i++)
-    result.set (10.0 * log10 (norm (v.get (i)) / conj (z) / 0.001), i);
-  return result;
+  for (int i = 0; i < v.size; i++)
+    v.data[i] = 10.0 * log10 (norm (v.data[i]) / conj (z) / 0.001);
+  return v;
 }
 
 vector runavg (const nr_complex_t x, const int n) {
@@ -64,7 +64,9 @@ class vector : public object
   vector (int, nr_complex_t);
   vector (const std::string &, int);
   vector (const vector &);
+  vector (vector &&) noexcept;
   const vector& operator = (const vector &);
+  const vector& operator = (vector &&) noexcept;
   ~vector ();
   void add (nr_complex_t);
   void add (vector *);
@@ -214,20 +216,20 @@ class vector : public object
 
   // assignment operations
   vector operator  - ();
-  vector operator  = (const nr_complex_t);
-  vector operator  = (const nr_double_t);
-  vector operator += (vector);
-  vector operator += (const nr_complex_t);
-  vector operator += (const nr_double_t);
-  vector operator -= (vector);
-  vector operator -= (const nr_complex_t);
-  vector operator -= (const nr_double_t);
-  vector operator *= (vector);
-  vector operator *= (const nr_complex_t);
-  vector operator *= (const nr_double_t);
-  vector operator /= (vector);
-  vector operator /= (const nr_complex_t);
-  vector operator /= (const nr_double_t);
+  vector& operator  = (const nr_complex_t);
+  vector& operator  = (const nr_double_t);
+  vector& operator += (const vector &);
+  vector& operator += (const nr_complex_t);
+  vector& operator += (const nr_double_t);
+  vector& operator -= (const vector &);
+  vector& operator -= (const nr_complex_t);
+  vector& operator -= (const nr_double_t);
+  vector& operator *= (const vector &);
+  vector& operator *= (const nr_complex_t);
+  vector& operator *= (const nr_double_t);
+  vector& operator /= (const vector &);
+  vector& operator /= (const nr_complex_t);
+  vector& operator /= (const nr_double_t);
 
   // easy accessor operators
   nr_complex_t  operator () (int i) const { return data[i]; }
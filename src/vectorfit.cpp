@@ -0,0 +1,477 @@
+/*
+ * vectorfit.cpp - rational approximation by vector fitting implementation
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#if HAVE_CONFIG_H
+# include <config.h>
+#endif
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "complex.h"
+#include "vectorfit.h"
+
+namespace qucs {
+
+// Constructor creates an instance of the vectorfit class.
+vectorfit::vectorfit () {
+  error = 0;
+}
+
+// Destructor deletes the vectorfit class object.
+vectorfit::~vectorfit () {
+}
+
+/* The function sets the frequencies and the responses to be fitted,
+   each response holds a value for each frequency. */
+void vectorfit::setData (const std::vector<nr_double_t> & f,
+			 const std::vector< std::vector<nr_complex_t> > & h) {
+  freq = f;
+  data = h;
+
+  // weights of the samples: inverse magnitudes limited to a floor
+  scale.resize (data.size ());
+  for (size_t m = 0; m < data.size (); m++) {
+    nr_double_t hmax = 0;
+    for (auto & v : data[m]) hmax = std::max (hmax, std::abs (v));
+    scale[m] = hmax > 0 ? hmax * 1e-4 : 1;
+  }
+}
+
+// Returns the weight of the given sample of the given response.
+nr_double_t vectorfit::weight (int m, int k) {
+  return 1 / std::max (std::abs (data[m][k]), scale[m]);
+}
+
+/* The function places the given number of starting poles as weakly
+   damped pairs over the frequency range, logarithmically spaced if
+   the range covers more than two decades. */
+void vectorfit::startPoles (int n) {
+  nr_double_t fmin = 0, fmax = 0;
+  for (auto f : freq) {
+    if (f > 0 && (fmin == 0 || f < fmin)) fmin = f;
+    fmax = std::max (fmax, f);
+  }
+  if (fmin == 0) fmin = fmax = 1;
+  nr_double_t wmin = 2 * pi * fmin, wmax = 2 * pi * fmax;
+  bool log = fmax > 100 * fmin;
+
+  poles.clear ();
+  int pairs = n / 2;
+  for (int i = 0; i < pairs; i++) {
+    nr_double_t x = pairs > 1 ? (nr_double_t) i / (pairs - 1) : 0.5;
+    nr_double_t w = log ? wmin * std::pow (wmax / wmin, x) :
+      wmin + (wmax - wmin) * x;
+    poles.push_back (nr_complex_t (-w / 100, w));
+  }
+  if (n & 1) poles.push_back (-wmin);
+}
+
+// Returns the number of real valued basis functions.
+int vectorfit::columns (void) {
+  int n = 0;
+  for (auto & p : poles) n += imag (p) == 0 ? 1 : 2;
+  return n;
+}
+
+/* Evaluates the real valued basis functions at the given frequency.
+   A real pole contributes 1/(s-p), a complex pair the two functions
+   1/(s-p) + 1/(s-p*) and j/(s-p) - j/(s-p*). */
+void vectorfit::basis (nr_complex_t s, std::vector<nr_complex_t> & phi) {
+  phi.clear ();
+  for (auto & p : poles) {
+    if (imag (p) == 0) {
+      phi.push_back (1.0 / (s - p));
+    } else {
+      nr_complex_t a = 1.0 / (s - p), b = 1.0 / (s - std::conj (p));
+      phi.push_back (a + b);
+      phi.push_back (nr_complex_t (0, 1) * (a - b));
+    }
+  }
+}
+
+/* Householder QR factorization of the row-major rows x cols matrix A
+   in place.  The transformations are applied to the right hand side b
+   as well.  The upper triangle of A holds R afterwards. */
+static void triangularize (std::vector<nr_double_t> & A, int rows, int cols,
+			   std::vector<nr_double_t> & b) {
+  for (int c = 0; c < cols && c < rows; c++) {
+    nr_double_t n = 0;
+    for (int r = c; r < rows; r++) n += A[r * cols + c] * A[r * cols + c];
+    n = std::sqrt (n);
+    if (n == 0) continue;
+    nr_double_t alpha = A[c * cols + c] > 0 ? -n : n;
+    // v = x - alpha e1, stored in column c
+    A[c * cols + c] -= alpha;
+    nr_double_t vtv = 0;
+    for (int r = c; r < rows; r++) vtv += A[r * cols + c] * A[r * cols + c];
+    for (int j = c + 1; j < cols; j++) {
+      nr_double_t s = 0;
+      for (int r = c; r < rows; r++) s += A[r * cols + c] * A[r * cols + j];
+      s = 2 * s / vtv;
+      for (int r = c; r < rows; r++) A[r * cols + j] -= s * A[r * cols + c];
+    }
+    nr_double_t s = 0;
+    for (int r = c; r < rows; r++) s += A[r * cols + c] * b[r];
+    s = 2 * s / vtv;
+    for (int r = c; r < rows; r++) b[r] -= s * A[r * cols + c];
+    A[c * cols + c] = alpha;
+    for (int r = c + 1; r < rows; r++) A[r * cols + c] = 0;
+  }
+}
+
+/* Solves the overdetermined system A x = b in the least squares sense.
+   The columns are scaled to unit length first.  Returns non-zero if
+   the system is rank deficient. */
+int vectorfit::lsqr (std::vector<nr_double_t> & A, int rows, int cols,
+		     std::vector<nr_double_t> & b, std::vector<nr_double_t> & x) {
+  std::vector<nr_double_t> cs (cols, 0.0);
+  for (int r = 0; r < rows; r++)
+    for (int c = 0; c < cols; c++) cs[c] += A[r * cols + c] * A[r * cols + c];
+  for (int c = 0; c < cols; c++) {
+    cs[c] = cs[c] > 0 ? 1 / std::sqrt (cs[c]) : 1;
+    for (int r = 0; r < rows; r++) A[r * cols + c] *= cs[c];
+  }
+  triangularize (A, rows, cols, b);
+
+  int error = 0;
+  x.assign (cols, 0.0);
+  for (int c = cols - 1; c >= 0; c--) {
+    nr_double_t s = b[c];
+    for (int j = c + 1; j < cols; j++) s -= A[c * cols + j] * x[j];
+    if (std::fabs (A[c * cols + c]) < 1e-13) {
+      error++;
+      x[c] = 0;
+    }
+    else x[c] = s / A[c * cols + c];
+  }
+  for (int c = 0; c < cols; c++) x[c] *= cs[c];
+  return error;
+}
+
+/* The function performs one pole relocation step.  The weighting
+   function sigma(s) = 1 + sum c_i phi_i(s) is identified from the
+   linear problem (d_m + sum r_mi phi_i) - sigma H_m = 0 for all
+   responses.  The residues of the responses are eliminated per
+   response by a QR factorization, only the trailing rows belonging
+   to sigma are stacked and solved.  The new poles are the zeros of
+   sigma. */
+int vectorfit::relocate (void) {
+  int n = columns (), K = (int) freq.size ();
+  int rows = 2 * K, cols = 2 * n + 1;
+  std::vector<nr_complex_t> phi;
+  std::vector<nr_double_t> S (data.size () * n * n), sb (data.size () * n);
+
+  // column norms of the basis functions
+  std::vector<nr_double_t> cn (n, 0.0);
+  for (int k = 0; k < K; k++) {
+    basis (nr_complex_t (0, 2 * pi * freq[k]), phi);
+    for (int i = 0; i < n; i++) cn[i] += norm (phi[i]);
+  }
+  for (int i = 0; i < n; i++) cn[i] = cn[i] > 0 ? 1 / std::sqrt (cn[i]) : 1;
+
+  for (size_t m = 0; m < data.size (); m++) {
+    std::vector<nr_double_t> A (rows * cols), b (rows);
+    for (int k = 0; k < K; k++) {
+      basis (nr_complex_t (0, 2 * pi * freq[k]), phi);
+      nr_double_t w = weight (m, k);
+      nr_complex_t h = data[m][k];
+      nr_double_t * re = &A[(2 * k) * cols], * im = &A[(2 * k + 1) * cols];
+      for (int i = 0; i < n; i++) {
+	nr_complex_t v = w * phi[i] * cn[i];
+	re[i] = real (v); im[i] = imag (v);
+	v = -v * h;
+	re[n + 1 + i] = real (v); im[n + 1 + i] = imag (v);
+      }
+      re[n] = w; im[n] = 0;
+      b[2 * k] = w * real (h); b[2 * k + 1] = w * imag (h);
+    }
+    triangularize (A, rows, cols, b);
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++)
+	S[(m * n + i) * n + j] = A[(n + 1 + i) * cols + n + 1 + j];
+      sb[m * n + i] = b[n + 1 + i];
+    }
+  }
+
+  std::vector<nr_double_t> c;
+  lsqr (S, (int) data.size () * n, n, sb, c);
+  for (int i = 0; i < n; i++) c[i] *= cn[i];
+
+  // zeros of sigma are the eigenvalues of A - b c^T
+  std::vector<nr_double_t> H (n * n, 0.0);
+  std::vector<nr_double_t> bv (n, 0.0);
+  int i = 0;
+  for (auto & p : poles) {
+    if (imag (p) == 0) {
+      H[i * n + i] = real (p);
+      bv[i] = 1;
+      i++;
+    } else {
+      H[i * n + i] = H[(i + 1) * n + i + 1] = real (p);
+      H[i * n + i + 1] = imag (p);
+      H[(i + 1) * n + i] = -imag (p);
+      bv[i] = 2;
+      i += 2;
+    }
+  }
+  for (int r = 0; r < n; r++)
+    for (int j = 0; j < n; j++) H[r * n + j] -= bv[r] * c[j];
+
+  std::vector<nr_complex_t> z;
+  eigenvalues (H, n, z);
+  if ((int) z.size () != n) return -1;
+
+  // keep the real zeros and the upper ones of the pairs, all stable
+  nr_double_t wmin = 0;
+  for (auto f : freq) if (f > 0 && (wmin == 0 || f < wmin)) wmin = f;
+  wmin = 2 * pi * (wmin > 0 ? wmin : 1) * 1e-3;
+  poles.clear ();
+  for (auto & e : z) {
+    nr_double_t re = -std::fabs (real (e)), im = imag (e);
+    if (std::fabs (im) <= 1e-8 * std::abs (e)) {
+      poles.push_back (std::min (re, -wmin));
+    } else if (im > 0) {
+      poles.push_back (nr_complex_t (re, im));
+    }
+  }
+  return 0;
+}
+
+/* The function computes the residues and constant terms of all
+   responses for the current poles and the resulting relative
+   error. */
+int vectorfit::residues (void) {
+  int n = columns (), K = (int) freq.size ();
+  int rows = 2 * K, cols = n + 1, err = 0;
+  std::vector<nr_complex_t> phi;
+  nr_double_t e = 0;
+
+  res.assign (data.size (), std::vector<nr_complex_t> ());
+  d.assign (data.size (), 0.0);
+  for (size_t m = 0; m < data.size (); m++) {
+    std::vector<nr_double_t> A (rows * cols), b (rows), x;
+    for (int k = 0; k < K; k++) {
+      basis (nr_complex_t (0, 2 * pi * freq[k]), phi);
+      nr_double_t w = weight (m, k);
+      for (int i = 0; i < n; i++) {
+	A[(2 * k) * cols + i] = w * real (phi[i]);
+	A[(2 * k + 1) * cols + i] = w * imag (phi[i]);
+      }
+      A[(2 * k) * cols + n] = w;
+      A[(2 * k + 1) * cols + n] = 0;
+      b[2 * k] = w * real (data[m][k]);
+      b[2 * k + 1] = w * imag (data[m][k]);
+    }
+    err += lsqr (A, rows, cols, b, x) ? 1 : 0;
+
+    int i = 0;
+    for (auto & p : poles) {
+      if (imag (p) == 0) {
+	res[m].push_back (x[i++]);
+      } else {
+	res[m].push_back (nr_complex_t (x[i], x[i + 1]));
+	i += 2;
+      }
+    }
+    d[m] = x[n];
+
+    for (int k = 0; k < K; k++) {
+      nr_complex_t h = evaluate (m, nr_complex_t (0, 2 * pi * freq[k]));
+      e += norm ((h - data[m][k]) * weight (m, k));
+    }
+  }
+  error = std::sqrt (e / std::max<size_t> (1, data.size () * freq.size ()));
+  return err;
+}
+
+/* The function fits the data with the given number of poles.  Returns
+   zero on success. */
+int vectorfit::fit (int n, int iterations) {
+  startPoles (n);
+  for (int i = 0; i < iterations; i++) {
+    if (relocate ()) return -1;
+  }
+  residues ();
+  return 0;
+}
+
+/* The function increases the number of poles until the relative error
+   falls below the given tolerance or the maximum number of poles is
+   reached.  The best fit is kept, its number of poles is returned. */
+int vectorfit::fitOrder (int maxPoles, nr_double_t tol) {
+  int best = -1;
+  nr_double_t berr = 0;
+  maxPoles = std::min (maxPoles, (int) freq.size () - 1);
+  for (int n = 2; n <= maxPoles; n += 2) {
+    if (fit (n)) continue;
+    if (best < 0 || error < berr) {
+      best = n;
+      berr = error;
+    }
+    if (error < tol) return n;
+  }
+  if (best > 0) fit (best);
+  return best;
+}
+
+// Evaluates the fitted rational function of the given response.
+nr_complex_t vectorfit::evaluate (int m, nr_complex_t s) {
+  nr_complex_t h = d[m];
+  for (size_t i = 0; i < poles.size (); i++) {
+    nr_complex_t p = poles[i], r = res[m][i];
+    h += r / (s - p);
+    if (imag (p) != 0) h += std::conj (r) / (s - std::conj (p));
+  }
+  return h;
+}
+
+/* The function computes the eigenvalues of the real row-major n x n
+   matrix A, which is destroyed.  The matrix is balanced and reduced to
+   Hessenberg form, then the eigenvalues are found by the shifted QR
+   algorithm in complex arithmetic. */
+void vectorfit::eigenvalues (std::vector<nr_double_t> & A, int n,
+			     std::vector<nr_complex_t> & ev) {
+  ev.clear ();
+
+  // balancing
+  bool done = false;
+  while (!done) {
+    done = true;
+    for (int i = 0; i < n; i++) {
+      nr_double_t c = 0, r = 0;
+      for (int j = 0; j < n; j++) {
+	if (j == i) continue;
+	c += std::fabs (A[j * n + i]);
+	r += std::fabs (A[i * n + j]);
+      }
+      if (c == 0 || r == 0) continue;
+      nr_double_t g = r / 2, f = 1, s = c + r;
+      while (c < g) { f *= 2; c *= 4; }
+      g = r * 2;
+      while (c > g) { f /= 2; c /= 4; }
+      if ((c + r) / f < 0.95 * s) {
+	done = false;
+	for (int j = 0; j < n; j++) A[i * n + j] /= f;
+	for (int j = 0; j < n; j++) A[j * n + i] *= f;
+      }
+    }
+  }
+
+  // Householder reduction to Hessenberg form
+  for (int k = 0; k < n - 2; k++) {
+    std::vector<nr_double_t> v (n - k - 1);
+    nr_double_t nx = 0;
+    for (int i = k + 1; i < n; i++) {
+      v[i - k - 1] = A[i * n + k];
+      nx += v[i - k - 1] * v[i - k - 1];
+    }
+    nx = std::sqrt (nx);
+    if (nx == 0) continue;
+    v[0] -= v[0] > 0 ? -nx : nx;
+    nr_double_t vtv = 0;
+    for (auto x : v) vtv += x * x;
+    if (vtv == 0) continue;
+    for (int j = 0; j < n; j++) {
+      nr_double_t s = 0;
+      for (int i = k + 1; i < n; i++) s += v[i - k - 1] * A[i * n + j];
+      s = 2 * s / vtv;
+      for (int i = k + 1; i < n; i++) A[i * n + j] -= s * v[i - k - 1];
+    }
+    for (int i = 0; i < n; i++) {
+      nr_double_t s = 0;
+      for (int j = k + 1; j < n; j++) s += A[i * n + j] * v[j - k - 1];
+      s = 2 * s / vtv;
+      for (int j = k + 1; j < n; j++) A[i * n + j] -= s * v[j - k - 1];
+    }
+  }
+
+  // shifted QR iterations on the Hessenberg matrix
+  std::vector<nr_complex_t> H (n * n);
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++)
+      H[i * n + j] = (j < i - 1) ? 0.0 : A[i * n + j];
+  std::vector<nr_complex_t> ra (n), rb (n);
+  std::vector<nr_double_t> rr (n);
+  const nr_double_t eps = std::numeric_limits<nr_double_t>::epsilon ();
+  int hi = n - 1, iter = 0;
+  while (hi >= 0) {
+    int l;
+    for (l = hi; l > 0; l--) {
+      nr_double_t s = std::abs (H[(l - 1) * n + l - 1]) + std::abs (H[l * n + l]);
+      if (std::abs (H[l * n + l - 1]) <= eps * s) {
+	H[l * n + l - 1] = 0;
+	break;
+      }
+    }
+    if (l == hi) {
+      ev.push_back (H[hi * n + hi]);
+      hi--;
+      iter = 0;
+      continue;
+    }
+    if (++iter > 60) {
+      // no convergence, return the diagonal
+      for (; hi >= 0; hi--) ev.push_back (H[hi * n + hi]);
+      break;
+    }
+
+    // Wilkinson shift, exceptional shifts from time to time
+    nr_complex_t mu;
+    nr_complex_t a = H[(hi - 1) * n + hi - 1], b = H[(hi - 1) * n + hi];
+    nr_complex_t c = H[hi * n + hi - 1], dd = H[hi * n + hi];
+    if (iter % 10 == 0) {
+      mu = dd + std::abs (c);
+    } else {
+      nr_complex_t tr = (a + dd) / 2.0, det = a * dd - b * c;
+      nr_complex_t disc = std::sqrt (tr * tr - det);
+      nr_complex_t m1 = tr + disc, m2 = tr - disc;
+      mu = std::abs (m1 - dd) < std::abs (m2 - dd) ? m1 : m2;
+    }
+
+    for (int i = l; i <= hi; i++) H[i * n + i] -= mu;
+    for (int k = l; k < hi; k++) {
+      nr_complex_t x = H[k * n + k], y = H[(k + 1) * n + k];
+      nr_double_t r = std::sqrt (norm (x) + norm (y));
+      if (r == 0) { x = 1; y = 0; r = 1; }
+      ra[k] = x; rb[k] = y; rr[k] = r;
+      for (int j = k; j <= hi; j++) {
+	nr_complex_t u = H[k * n + j], v = H[(k + 1) * n + j];
+	H[k * n + j] = (std::conj (x) * u + std::conj (y) * v) / r;
+	H[(k + 1) * n + j] = (-y * u + x * v) / r;
+      }
+    }
+    for (int k = l; k < hi; k++) {
+      nr_complex_t x = ra[k], y = rb[k];
+      nr_double_t r = rr[k];
+      for (int i = l; i <= std::min (k + 2, hi); i++) {
+	nr_complex_t u = H[i * n + k], v = H[i * n + k + 1];
+	H[i * n + k] = (u * x + v * y) / r;
+	H[i * n + k + 1] = (-u * std::conj (y) + v * std::conj (x)) / r;
+      }
+    }
+    for (int i = l; i <= hi; i++) H[i * n + i] += mu;
+  }
+}
+
+} // namespace qucs
@@ -0,0 +1,85 @@
+/*
+ * vectorfit.h - rational approximation by vector fitting definitions
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#ifndef __VECTORFIT_H__
+#define __VECTORFIT_H__
+
+#include <vector>
+
+namespace qucs {
+
+/*!\brief Rational approximation by vector fitting
+
+   The class approximates a set of frequency responses H_m(s) sampled
+   at s = j 2 pi f_k by rational functions with common poles
+
+     H_m(s) = d_m + sum_i r_mi / (s - p_i)
+
+   using the vector fitting algorithm of Gustavsen and Semlyen.  The
+   poles are relocated iteratively to the zeros of a weighting
+   function, unstable poles are flipped into the left half plane.  The
+   data are weighted by the inverse of their magnitude, thus the
+   relative error is minimized.  Complex poles come in conjugate pairs,
+   only the one with positive imaginary part is stored.
+*/
+class vectorfit
+{
+ public:
+  vectorfit ();
+  ~vectorfit ();
+
+  void setData (const std::vector<nr_double_t> &,
+		const std::vector< std::vector<nr_complex_t> > &);
+  int  fit (int, int iterations = 8);
+  int  fitOrder (int, nr_double_t);
+  nr_double_t getError (void) { return error; }
+  int  getResponses (void) { return (int) data.size (); }
+  nr_complex_t evaluate (int, nr_complex_t);
+
+  static void eigenvalues (std::vector<nr_double_t> &, int,
+			   std::vector<nr_complex_t> &);
+
+ private:
+  void startPoles (int);
+  int  columns (void);
+  void basis (nr_complex_t, std::vector<nr_complex_t> &);
+  int  relocate (void);
+  int  residues (void);
+  nr_double_t weight (int, int);
+  static int lsqr (std::vector<nr_double_t> &, int, int,
+		   std::vector<nr_double_t> &, std::vector<nr_double_t> &);
+
+ public:
+  std::vector<nr_complex_t> poles;
+  std::vector< std::vector<nr_complex_t> > res;
+  std::vector<nr_double_t> d;
+
+ private:
+  std::vector<nr_double_t> freq;
+  std::vector< std::vector<nr_complex_t> > data;
+  std::vector<nr_double_t> scale;
+  nr_double_t error;
+};
+
+} // namespace qucs
+
+#endif /* __VECTORFIT_H__ */
@@ -23,7 +23,10 @@
 #include "qucs_typedefs.h"
 #include "real.h"
 #include "complex.h"
+#include "object.h"
+#include "vector.h"
 #include "matrix.h"
+#include "matvec.h"
 
 #include "gtest/gtest.h"  // Google Test
 
@@ -32,3 +35,39 @@ TEST (matrix, getCols) {
     EXPECT_EQ ( 3 , data.getCols() );
 }
 
+
+/* compares the batched matrix vector conversions against the single
+   matrix conversions for two and three ports */
+TEST (matvec, conversions) {
+  for (int n = 2; n <= 3; n++) {
+    qucs::matvec s (4, n, n);
+    qucs::vector z0 (n);
+    for (int i = 0; i < n; i++) z0.set (nr_complex_t (50.0 + 25 * i, 5.0 * i), i);
+    for (int f = 0; f < s.getSize (); f++) {
+      qucs::matrix m (n, n);
+      for (int r = 0; r < n; r++)
+        for (int c = 0; c < n; c++)
+          m.set (r, c, nr_complex_t (0.1 * (r + 1) + 0.05 * f,
+                                      0.03 * (c - r) - 0.02 * f));
+      s.set (m, f);
+    }
+    qucs::matvec y = qucs::stoy (s, z0);
+    qucs::matvec z = qucs::stoz (s, z0);
+    qucs::matvec sy = qucs::ytos (y, z0);
+    qucs::matvec sz = qucs::ztos (z, z0);
+    qucs::matvec yz = qucs::ztoy (z);
+    for (int f = 0; f < s.getSize (); f++) {
+      qucs::matrix ym = qucs::stoy (s.get (f), z0);
+      qucs::matrix zm = qucs::stoz (s.get (f), z0);
+      for (int r = 0; r < n; r++) {
+        for (int c = 0; c < n; c++) {
+          EXPECT_NEAR (0, abs (y.get (f).get (r, c) - ym.get (r, c)), 1e-12);
+          EXPECT_NEAR (0, abs (z.get (f).get (r, c) - zm.get (r, c)), 1e-9);
+          EXPECT_NEAR (0, abs (sy.get (f).get (r, c) - s.get (f).get (r, c)), 1e-12);
+          EXPECT_NEAR (0, abs (sz.get (f).get (r, c) - s.get (f).get (r, c)), 1e-12);
+          EXPECT_NEAR (0, abs (yz.get (f).get (r, c) - ym.get (r, c)), 1e-12);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,108 @@
+/*
+ * PSS.cpp - Unit test for the periodic steady-state solver
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <string>
+
+#include "qucs_typedefs.h"
+#include "object.h"
+#include "complex.h"
+#include "circuit.h"
+#include "net.h"
+#include "netdefs.h"
+#include "dataset.h"
+#include "environment.h"
+#include "psssolver.h"
+#include "components.h"
+
+#include "gtest/gtest.h"  // Google Test
+
+#include "testDefine.h"
+
+using namespace qucs;
+
+/* adds the default values of all properties not yet given */
+static void defaults (object * o, struct define_t * d) {
+  for (int k = 0; k < 2; k++) {
+    struct property_t * p = k ? d->optional : d->required;
+    for (int i = 0; PROP_IS_PROP (p[i]); i++) {
+      if (o->hasProperty (p[i].key)) continue;
+      if (PROP_IS_STR (p[i]))
+	o->addProperty (p[i].key, p[i].defaultval.s, true);
+      else
+	o->addProperty (p[i].key, p[i].defaultval.d, true);
+    }
+  }
+}
+
+static void insert (net * n, circuit * c, struct define_t * d,
+		    const char * name, const char * a, const char * b) {
+  defaults (c, d);
+  c->setName (name);
+  c->setNode (0, a);
+  c->setNode (1, b);
+  n->insertCircuit (c);
+}
+
+/* runs a PSS analysis of a DC source feeding a resistor through the
+   given two-port and returns the result of the solver */
+static int runPSS (circuit * twoport, struct define_t * d) {
+  net * n = new net ("net");
+  circuit * v = new vdc ();
+  v->addProperty ("U", 1.0);
+  insert (n, v, &vdc::cirdef, "V1", "n1", "gnd");
+  insert (n, twoport, d, "X1", "n1", "n2");
+  circuit * r = new resistor ();
+  r->addProperty ("R", 50.0);
+  insert (n, r, &resistor::cirdef, "R1", "n2", "gnd");
+
+  psssolver * pss = new psssolver ("PSS1");
+  pss->addProperty ("f", 1e6);
+  defaults (pss, &psssolver::anadef);
+  pss->setNet (n);
+  pss->setData (new dataset ());
+  pss->setEnv (new environment ("root"));
+  pss->setProgress (false);
+  n->insertAnalysis (pss);
+  pss->initialize ();
+  int error = pss->solve ();
+  pss->cleanup ();
+  return error;
+}
+
+/* the shooting method restarts the period at a given solution, which
+   a circuit with recursive convolution states cannot do */
+TEST (psssolver, rejectConvolution) {
+  substrate * subst = new substrate ();
+  subst->addProperty ("er", 9.8);
+  subst->addProperty ("h", 0.635e-3);
+  subst->addProperty ("t", 17.5e-6);
+
+  circuit * bw = new bondwire ();
+  bw->setSubstrate (subst);
+  EXPECT_EQ (-1, runPSS (bw, &bondwire::cirdef));
+  EXPECT_TRUE (bw->isConvolved ());
+
+  circuit * r = new resistor ();
+  r->addProperty ("R", 1.0);
+  EXPECT_EQ (0, runPSS (r, &resistor::cirdef));
+  EXPECT_FALSE (r->isConvolved ());
+}
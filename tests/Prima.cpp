@@ -0,0 +1,159 @@
+/*
+ * Prima.cpp - Unit test for the model order reduction
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <string>
+
+#include "qucs_typedefs.h"
+#include "object.h"
+#include "complex.h"
+#include "circuit.h"
+#include "net.h"
+#include "netdefs.h"
+#include "vector.h"
+#include "dataset.h"
+#include "environment.h"
+#include "dcsolver.h"
+#include "acsolver.h"
+#include "prima.h"
+#include "components.h"
+
+#include "gtest/gtest.h"  // Google Test
+
+#include "testDefine.h"
+
+using namespace qucs;
+
+/* adds the default values of all properties not yet given */
+static void defaults (object * o, struct define_t * d) {
+  for (int k = 0; k < 2; k++) {
+    struct property_t * p = k ? d->optional : d->required;
+    for (int i = 0; PROP_IS_PROP (p[i]); i++) {
+      if (o->hasProperty (p[i].key)) continue;
+      if (PROP_IS_STR (p[i]))
+	o->addProperty (p[i].key, p[i].defaultval.s, true);
+      else
+	o->addProperty (p[i].key, p[i].defaultval.d, true);
+    }
+  }
+}
+
+static void insert (net * n, circuit * c, struct define_t * d,
+		    const std::string & name, const std::string & a,
+		    const std::string & b) {
+  defaults (c, d);
+  c->setName (name);
+  c->setNode (0, a);
+  c->setNode (1, b);
+  n->insertCircuit (c);
+}
+
+/* builds a ladder of 40 sections driven by a DC and an AC current
+   source at node n0.  Each section is a series resistor followed by a
+   shunt capacitor to ground (RC), or a series inductor followed by a
+   shunt resistor to ground (RL). */
+static net * ladder (bool rl) {
+  net * n = new net ("net");
+  circuit * c = new idc ();
+  c->addProperty ("I", 1e-3);
+  insert (n, c, &idc::cirdef, "I1", "gnd", "n0");
+  c = new iac ();
+  c->addProperty ("I", 1e-3);
+  insert (n, c, &iac::cirdef, "I2", "gnd", "n0");
+  for (int k = 1; k <= 40; k++) {
+    std::string a = "n" + std::to_string (k - 1), b = "n" + std::to_string (k);
+    if (rl) {
+      c = new inductor ();
+      c->addProperty ("L", 1e-9);
+      insert (n, c, &inductor::cirdef, "L" + b, a, b);
+      c = new resistor ();
+      c->addProperty ("R", 1e3);
+      insert (n, c, &resistor::cirdef, "R" + b, b, "gnd");
+    }
+    else {
+      c = new resistor ();
+      c->addProperty ("R", 10.0);
+      insert (n, c, &resistor::cirdef, "R" + b, a, b);
+      c = new capacitor ();
+      c->addProperty ("C", 1e-12);
+      insert (n, c, &capacitor::cirdef, "C" + b, b, "gnd");
+    }
+  }
+  c = new resistor ();
+  c->addProperty ("R", 50.0);
+  insert (n, c, &resistor::cirdef, "RL", "n40", "gnd");
+  return n;
+}
+
+/* runs the given analysis of the network and returns the dataset */
+static dataset * run (net * n, analysis * a, struct define_t * d) {
+  dataset * data = new dataset ();
+  defaults (a, d);
+  a->setNet (n);
+  a->setData (data);
+  a->setEnv (new environment ("root"));
+  a->setProgress (false);
+  n->insertAnalysis (a);
+  a->initialize ();
+  a->solve ();
+  a->cleanup ();
+  return data;
+}
+
+/* computes the DC voltage and the AC voltages at the driven node of
+   the ladder, with the linear network reduced if order is non-zero */
+static void response (bool rl, int order, nr_double_t & dc,
+		      qucs::vector & ac) {
+  net * n = ladder (rl);
+  prima reducer (n);
+  if (order > 0) ASSERT_EQ (1, reducer.reduce (order));
+  dataset * data = run (n, new dcsolver ("DC1"), &dcsolver::anadef);
+  dc = real (data->findVariable ("n0.V")->get (0));
+
+  analysis * a = new acsolver ("AC1");
+  a->addProperty ("Type", "log");
+  a->addProperty ("Start", 1e6);
+  a->addProperty ("Stop", 1e9);
+  a->addProperty ("Points", 31.0);
+  data = run (n, a, &acsolver::anadef);
+  ac = *data->findVariable ("n0.v");
+}
+
+static void compare (bool rl) {
+  nr_double_t dc, dcr;
+  qucs::vector ac, acr;
+  response (rl, 0, dc, ac);
+  response (rl, 4, dcr, acr);
+  EXPECT_NEAR (0, std::abs (dcr - dc) / std::abs (dc), tol);
+  ASSERT_EQ (ac.getSize (), acr.getSize ());
+  for (int i = 0; i < ac.getSize (); i++)
+    EXPECT_NEAR (0, std::abs (acr (i) - ac (i)) / std::abs (ac (i)), tol);
+}
+
+TEST (prima, rcLadder) {
+  compare (false);
+}
+
+/* the RL ladder is expanded at a thousandth of the expansion frequency
+   instead of DC, the DC response must match nevertheless */
+TEST (prima, rlLadder) {
+  compare (true);
+}
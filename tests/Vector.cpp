@@ -33,3 +33,35 @@ TEST (vector, sum) {
     vec.set(1, k);
   EXPECT_EQ ( 3.0 , qucs::sum(vec) );
 }
+
+TEST (vector, move) {
+  qucs::vector a = qucs::vector (4, 2.0);
+  qucs::vector b (std::move (a));
+  EXPECT_EQ ( 0 , a.getSize() );
+  EXPECT_EQ ( 4 , b.getSize() );
+  EXPECT_EQ ( 8.0 , qucs::sum(b) );
+  a = std::move (b);
+  EXPECT_EQ ( 4 , a.getSize() );
+  EXPECT_EQ ( 0 , b.getSize() );
+}
+
+TEST (vector, inplace) {
+  qucs::vector a = qucs::vector (4, nr_complex_t (3.0, 4.0));
+  qucs::vector b = qucs::vector (2, 1.0);
+  b.set (2.0, 1);
+  // shorter vectors are repeated
+  qucs::vector c = b - a;
+  EXPECT_EQ ( 4 , c.getSize() );
+  EXPECT_EQ ( nr_complex_t (-2.0, -4.0) , c (0) );
+  EXPECT_EQ ( nr_complex_t (-1.0, -4.0) , c (1) );
+  c = b / a;
+  EXPECT_NEAR ( 0.24 , real (c (1)), 1e-15 );
+  EXPECT_NEAR ( -0.32 , imag (c (1)), 1e-15 );
+  // arguments are left untouched
+  EXPECT_EQ ( nr_complex_t (3.0, 4.0) , a (3) );
+  EXPECT_EQ ( 2.0 , real (b (1)) );
+  EXPECT_EQ ( 25.0 , real (qucs::norm (a) (0)) );
+  EXPECT_EQ ( -4.0 , imag (qucs::conj (a) (0)) );
+  EXPECT_EQ ( 4.0 , real (qucs::imag (a) (0)) );
+  EXPECT_NEAR ( 20 * std::log10 (5.0) , real (qucs::dB (a) (2)), 1e-12 );
+}
@@ -0,0 +1,102 @@
+/*
+ * VectorFit.cpp - Unit test for vector fitting and recursive convolution
+ *
+ * Copyright (C) 2026 Qucs Team
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this package; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ */
+
+#include <vector>
+
+#include "qucs_typedefs.h"
+#include "real.h"
+#include "complex.h"
+#include "states.h"
+#include "integrator.h"
+#include "vectorfit.h"
+#include "rconv.h"
+
+#include "gtest/gtest.h"  // Google Test
+
+#include "testDefine.h"
+
+/* fits the sampled response of a known rational function with a real
+   pole and a complex pole pair and compares the recovered poles and
+   residues */
+TEST (vectorfit, knownPoles) {
+  const nr_double_t w = 2 * qucs::pi * 1e9;
+  const nr_complex_t p1 (-0.2 * w, 0), r1 (0.1 * w, 0);
+  const nr_complex_t p2 (-0.05 * w, w), r2 (0.02 * w, 0.03 * w);
+  const nr_double_t d = 0.5;
+
+  std::vector<nr_double_t> f;
+  std::vector< std::vector<nr_complex_t> > h (1);
+  for (int k = 0; k <= 100; k++) {
+    nr_double_t fk = 1e7 + k * 3e7;
+    nr_complex_t s (0, 2 * qucs::pi * fk);
+    f.push_back (fk);
+    h[0].push_back (d + r1 / (s - p1) + r2 / (s - p2) +
+		    std::conj (r2) / (s - std::conj (p2)));
+  }
+
+  qucs::vectorfit vf;
+  vf.setData (f, h);
+  ASSERT_EQ (0, vf.fit (3));
+  EXPECT_LT (vf.getError (), tol);
+  ASSERT_EQ (2u, vf.poles.size ());
+
+  // one real pole and the upper pole of the pair, in any order
+  int real = imag (vf.poles[0]) == 0 ? 0 : 1, pair = 1 - real;
+  EXPECT_NEAR (0, std::abs (vf.poles[real] - p1) / std::abs (p1), tol);
+  EXPECT_NEAR (0, std::abs (vf.poles[pair] - p2) / std::abs (p2), tol);
+  EXPECT_NEAR (0, std::abs (vf.res[0][real] - r1) / std::abs (r1), tol);
+  EXPECT_NEAR (0, std::abs (vf.res[0][pair] - r2) / std::abs (r2), tol);
+  EXPECT_NEAR (d, vf.d[0], tol);
+}
+
+/* applies H(s) = a / (s + a) to a unit step by recursive convolution
+   and compares the output with the closed form.  The input is linear
+   within a time-step, so the step rises over the first one and the
+   response is 1 - exp(-a t) (exp(a h) - 1) / (a h) afterwards. */
+TEST (rconv, stepResponse) {
+  const nr_double_t a = 1e6, h = 1e-8;
+
+  qucs::vectorfit vf;
+  vf.poles.push_back (-a);
+  vf.res.push_back (std::vector<nr_complex_t> (1, a));
+  vf.d.push_back (0);
+
+  qucs::rconv conv;
+  int index = 0;
+  conv.setModel (vf, 1, 1, &index);
+
+  qucs::integrator c;
+  c.setStates (conv.getStates ());
+  c.initStates ();
+
+  nr_double_t u = 0, G, y;
+  conv.initState (&c, &u, &G, &y);
+  EXPECT_NEAR (1, G, tol);
+  u = 1;
+  for (int n = 1; n <= 500; n++) {
+    c.nextState ();
+    conv.calcState (&c, h, &u, &G, &y);
+    nr_double_t t = n * h;
+    EXPECT_NEAR (1 - std::exp (-a * t) * std::expm1 (a * h) / (a * h),
+		 G * u + y, tol);
+  }
+}
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+#
+# qucsbench.py - benchmark suite and timing harness for qucsator
+#
+# Copyright (C) 2026 Qucs Team
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this package; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+# Boston, MA 02110-1301, USA.
+#
+
+"""Benchmark suite for the qucsator solver core.
+
+Generates scalable netlists (RC ladders, transmission line meshes,
+BJT/MOSFET arrays, HB mixers, SP filter networks and long transients),
+runs qucsator on them at several sizes and reports wall time, Newton
+iterations, time-steps and peak resident set size as JSON.
+
+Examples:
+
+  qucsbench.py -q src/qucsator -o bench.json
+  qucsbench.py -q src/qucsator --sizes large rc_ladder hb_mixer
+  qucsbench.py --list
+"""
+
+import argparse
+import datetime
+import json
+import os
+import platform
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+HEADER = "# Qucs benchmark netlist: %s (size %d)\n"
+
+# Complete property lists of the devices, in the order the Qucs
+# schematic editor writes them.
+BJT = ('Type="npn" Is="1e-16" Nf="1" Nr="1" Ikf="0" Ikr="0" Vaf="0" '
+       'Var="0" Ise="0" Ne="1.5" Isc="0" Nc="2" Bf="100" Br="1" Rbm="0" '
+       'Irb="0" Rc="0" Re="0" Rb="0" Cje="1p" Vje="0.75" Mje="0.33" '
+       'Cjc="1p" Vjc="0.75" Mjc="0.33" Xcjc="1" Cjs="0" Vjs="0.75" '
+       'Mjs="0" Fc="0.5" Tf="10p" Xtf="0" Vtf="0" Itf="0" Tr="1n" '
+       'Temp="26.85" Kf="0" Af="1" Ffe="1" Kb="0" Ab="1" Fb="1" Ptf="0" '
+       'Xtb="0" Xti="3" Eg="1.11" Tnom="26.85" Area="1"')
+
+MOSFET = ('Type="%s" Vt0="%s" Kp="2e-5" Gamma="0" Phi="0.6" '
+          'Lambda="0.01" Rd="0" Rs="0" Rg="0" Is="1e-14" N="1" W="10u" '
+          'L="1u" Ld="0" Tox="0.1u" Cgso="1e-10" Cgdo="1e-10" Cgbo="0" '
+          'Cbd="0" Cbs="0" Pb="0.8" Mj="0.5" Fc="0.5" Cjsw="0" '
+          'Mjsw="0.33" Tt="0" Nsub="0" Nss="0" Tpg="1" Uo="600" Rsh="0" '
+          'Nrd="1" Nrs="1" Cj="0" Js="0" Ad="0" As="0" Pd="0" Ps="0" '
+          'Kf="0" Af="1" Ffe="1" Temp="26.85" Tnom="26.85" capModel="2"')
+
+DIODE = ('Is="1e-15" N="1" Cj0="10e-15" M="0.5" Vj="0.7" Fc="0.5" '
+         'Cp="0" Isr="0" Nr="2" Rs="0" Tt="0" Ikf="0" Kf="0" Af="1" '
+         'Ffe="1" Bv="0" Ibv="1e-3" Temp="26.85" Xti="3" Eg="1.11" '
+         'Tbv="0" Trs="0" Ttt1="0" Ttt2="0" Tm1="0" Tm2="0" Tnom="26.85" '
+         'Area="1"')
+
+
+def rc_ladder(n):
+    """Transient of an n stage RC ladder driven by a pulse source."""
+    s = 'Vpulse:V1 n0 gnd U1="0" U2="1" T1="1 us" T2="50 us" ' \
+        'Tr="10 ns" Tf="10 ns"\n'
+    for i in range(n):
+        s += 'R:R%d n%d n%d R="100 Ohm"\n' % (i, i, i + 1)
+        s += 'C:C%d n%d gnd C="10 pF"\n' % (i, i + 1)
+    s += '.TR:TR1 Type="lin" Start="0" Stop="100 us" Points="1001"\n'
+    return s
+
+
+def tline_mesh(n):
+    """S-parameters of an n x n mesh of transmission lines."""
+    s = 'Pac:P1 m0_0 gnd Num="1" Z="50 Ohm" P="0 dBm" f="1 GHz"\n'
+    s += 'Pac:P2 m%d_%d gnd Num="2" Z="50 Ohm" P="0 dBm" f="1 GHz"\n' \
+        % (n - 1, n - 1)
+    k = 0
+    for i in range(n):
+        for j in range(n):
+            if j + 1 < n:
+                s += 'TLIN:T%d m%d_%d m%d_%d Z="50 Ohm" L="%g mm"\n' \
+                    % (k, i, j, i, j + 1, 10 + (i + j) % 3)
+                k += 1
+            if i + 1 < n:
+                s += 'TLIN:T%d m%d_%d m%d_%d Z="70 Ohm" L="%g mm"\n' \
+                    % (k, i, j, i + 1, j, 12 + (i * j) % 5)
+                k += 1
+            s += 'R:R%d_%d m%d_%d gnd R="1 kOhm"\n' % (i, j, i, j)
+    s += '.SP:SP1 Type="lin" Start="100 MHz" Stop="10 GHz" Points="201"\n'
+    return s
+
+
+def bjt_array(n):
+    """DC operating point and transient of n common emitter stages."""
+    s = 'Vdc:VCC vcc gnd U="5 V"\n'
+    s += 'Vac:VIN in gnd U="10 mV" f="1 MHz" Phase="0" Theta="0"\n'
+    for i in range(n):
+        b = 'in' if i == 0 else 'c%d' % (i - 1)
+        s += 'R:RB%d vcc b%d R="470 kOhm"\n' % (i, i)
+        s += 'C:CC%d %s b%d C="100 nF"\n' % (i, b, i)
+        s += 'R:RC%d vcc c%d R="4.7 kOhm"\n' % (i, i)
+        s += 'BJT:Q%d b%d c%d gnd gnd %s\n' % (i, i, i, BJT)
+    s += '.DC:DC1 saveOPs="yes"\n'
+    s += '.TR:TR1 Type="lin" Start="0" Stop="10 us" Points="501"\n'
+    return s
+
+
+def mosfet_array(n):
+    """Transient of a chain of n CMOS inverters."""
+    s = 'Vdc:VDD vdd gnd U="3.3 V"\n'
+    s += 'Vpulse:VIN i0 gnd U1="0" U2="3.3" T1="10 ns" T2="60 ns" ' \
+        'Tr="1 ns" Tf="1 ns"\n'
+    for i in range(n):
+        s += 'MOSFET:MP%d i%d i%d vdd vdd %s\n' \
+            % (i, i, i + 1, MOSFET % ("pfet", "-0.7"))
+        s += 'MOSFET:MN%d i%d i%d gnd gnd %s\n' \
+            % (i, i, i + 1, MOSFET % ("nfet", "0.7"))
+        s += 'C:CL%d i%d gnd C="10 fF"\n' % (i, i + 1)
+    s += '.TR:TR1 Type="lin" Start="0" Stop="200 ns" Points="401"\n'
+    return s
+
+
+def hb_mixer(n):
+    """Harmonic balance of a single diode mixer with n harmonics."""
+    s = 'Vac:VLO lo gnd U="1 V" f="1 GHz" Phase="0" Theta="0"\n'
+    s += 'Vac:VRF rf gnd U="10 mV" f="1.1 GHz" Phase="0" Theta="0"\n'
+    s += 'R:RLO lo a R="50 Ohm"\n'
+    s += 'R:RRF rf a R="50 Ohm"\n'
+    s += 'Diode:D1 a if %s\n' % DIODE
+    s += 'R:RIF if gnd R="50 Ohm"\n'
+    s += 'C:CIF if gnd C="1 pF"\n'
+    s += '.HB:HB1 n="%d" f="1 GHz"\n' % n
+    return s
+
+
+def sp_filter(n):
+    """S-parameters of an n section LC ladder lowpass filter."""
+    s = 'Pac:P1 f0 gnd Num="1" Z="50 Ohm" P="0 dBm" f="1 GHz"\n'
+    s += 'Pac:P2 f%d gnd Num="2" Z="50 Ohm" P="0 dBm" f="1 GHz"\n' % n
+    for i in range(n):
+        s += 'L:L%d f%d f%d L="8 nH"\n' % (i, i, i + 1)
+        s += 'C:C%d f%d gnd C="3.2 pF"\n' % (i, i + 1)
+    s += '.SP:SP1 Type="lin" Start="10 MHz" Stop="3 GHz" Points="1001"\n'
+    return s
+
+
+def long_transient(n):
+    """Transient of a diode rectifier with LC filter over n periods."""
+    s = 'Vac:V1 in gnd U="10 V" f="50 kHz" Phase="0" Theta="0"\n'
+    s += 'Diode:D1 in a %s\n' % DIODE
+    s += 'L:L1 a out L="100 uH"\n'
+    s += 'C:C1 out gnd C="10 uF"\n'
+    s += 'R:RL out gnd R="10 Ohm"\n'
+    s += '.TR:TR1 Type="lin" Start="0" Stop="%g" Points="%d" MaxStep="1 us"\n' \
+        % (n / 50e3, 20 * n + 1)
+    return s
+
+
+# name: (generator, small, medium and large sizes)
+CASES = {
+    'rc_ladder':      (rc_ladder,      (50, 200, 800)),
+    'tline_mesh':     (tline_mesh,     (4, 8, 16)),
+    'bjt_array':      (bjt_array,      (5, 20, 80)),
+    'mosfet_array':   (mosfet_array,   (5, 20, 80)),
+    'hb_mixer':       (hb_mixer,       (4, 8, 16)),
+    'sp_filter':      (sp_filter,      (10, 50, 200)),
+    'long_transient': (long_transient, (100, 1000, 5000)),
+}
+
+SIZES = {'small': (0,), 'medium': (0, 1), 'large': (0, 1, 2)}
+
+
+def netlist(name, size):
+    """Returns the netlist of the given benchmark case and size."""
+    return HEADER % (name, size) + CASES[name][0](size)
+
+
+def parse_log(text):
+    """Extracts solver statistics from the qucsator output."""
+    stats = {'newton_iterations': 0, 'time_steps': 0, 'rejections': 0}
+    for m in re.finditer(r'(\d+) time-steps, (\d+) NR-iterations', text):
+        stats['time_steps'] += int(m.group(1))
+        stats['newton_iterations'] += int(m.group(2))
+    for m in re.finditer(r'(\d+) rejections', text):
+        stats['rejections'] += int(m.group(1))
+    for m in re.finditer(r'convergence reached after (\d+) iterations', text):
+        stats['newton_iterations'] += int(m.group(1))
+    return stats
+
+
+def run(qucsator, name, size, workdir, repeat):
+    """Runs qucsator on a single case and returns its measurements."""
+    net = os.path.join(workdir, '%s_%d.net' % (name, size))
+    dat = os.path.join(workdir, '%s_%d.dat' % (name, size))
+    with open(net, 'w') as f:
+        f.write(netlist(name, size))
+
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        proc = subprocess.Popen([qucsator, '-i', net, '-o', dat],
+                                stdout=subprocess.PIPE,
+                                stderr=subprocess.STDOUT)
+        output = proc.stdout.read().decode(errors='replace')
+        proc.stdout.close()
+        if hasattr(os, 'wait4'):
+            _, status, usage = os.wait4(proc.pid, 0)
+            code = os.waitstatus_to_exitcode(status) \
+                if hasattr(os, 'waitstatus_to_exitcode') else status >> 8
+            rss = usage.ru_maxrss
+            if sys.platform == 'darwin':
+                rss //= 1024
+        else:
+            code = proc.wait()
+            rss = None
+        wall = time.perf_counter() - start
+
+        result = {'case': name, 'size': size, 'status': code,
+                  'wall_time': wall, 'peak_rss_kb': rss}
+        result.update(parse_log(output))
+        if best is None or wall < best['wall_time']:
+            best = result
+    best['runs'] = repeat
+    return best
+
+
+def version(qucsator):
+    try:
+        out = subprocess.check_output([qucsator, '-v'])
+        return out.decode(errors='replace').splitlines()[0]
+    except (OSError, subprocess.CalledProcessError, IndexError):
+        return None
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawTextHelpFormatter)
+    parser.add_argument('cases', nargs='*', metavar='case',
+                        help='benchmark cases to run (default all)')
+    parser.add_argument('-q', '--qucsator', default='qucsator',
+                        help='qucsator executable')
+    parser.add_argument('-o', '--output',
+                        help='write JSON results to file (default stdout)')
+    parser.add_argument('-s', '--sizes', choices=sorted(SIZES),
+                        default='medium', help='set of problem sizes')
+    parser.add_argument('-r', '--repeat', type=int, default=1,
+                        help='runs per case, the fastest one is reported')
+    parser.add_argument('-k', '--keep', metavar='DIR',
+                        help='keep netlists and datasets in DIR')
+    parser.add_argument('-l', '--list', action='store_true',
+                        help='list the available cases and exit')
+    parser.add_argument('-n', '--netlist', nargs=2, metavar=('CASE', 'SIZE'),
+                        help='print the netlist of a case and exit')
+    args = parser.parse_args()
+
+    if args.list:
+        for name in sorted(CASES):
+            print('%-16s %-18s %s' % (name, CASES[name][1],
+                                      CASES[name][0].__doc__))
+        return 0
+    if args.netlist:
+        sys.stdout.write(netlist(args.netlist[0], int(args.netlist[1])))
+        return 0
+
+    cases = args.cases or sorted(CASES)
+    for name in cases:
+        if name not in CASES:
+            parser.error('unknown case %s' % name)
+
+    workdir = args.keep or tempfile.mkdtemp(prefix='qucsbench')
+    if args.keep and not os.path.isdir(workdir):
+        os.makedirs(workdir)
+
+    results = []
+    failed = 0
+    for name in cases:
+        for i in SIZES[args.sizes]:
+            size = CASES[name][1][i]
+            r = run(args.qucsator, name, size, workdir, args.repeat)
+            results.append(r)
+            failed += r['status'] != 0
+            sys.stderr.write('%-16s %6d %10.3f s %8s kB %8d NR %8d steps%s\n'
+                             % (name, size, r['wall_time'], r['peak_rss_kb'],
+                                r['newton_iterations'], r['time_steps'],
+                                '' if r['status'] == 0 else '  FAILED'))
+
+    report = {
+        'qucsator': version(args.qucsator),
+        'date': datetime.datetime.now().isoformat(timespec='seconds'),
+        'host': platform.node(),
+        'platform': platform.platform(),
+        'sizes': args.sizes,
+        'results': results,
+    }
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(report, f, indent=2)
+            f.write('\n')
+    else:
+        json.dump(report, sys.stdout, indent=2)
+        sys.stdout.write('\n')
+
+    if not args.keep:
+        for f in os.listdir(workdir):
+            os.remove(os.path.join(workdir, f))
+        os.rmdir(workdir)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+#
+# qucsclient.py - stand-in client for the qucsator simulation server
+#
+# Copyright (C) 2026 Qucs Team
+#
+# This is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2, or (at your option)
+# any later version.
+#
+# This software is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this package; see the file COPYING.  If not, write to
+# the Free Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+# Boston, MA 02110-1301, USA.
+#
+
+"""Stand-in client for the qucsator simulation server.
+
+Loads a netlist once and runs it repeatedly, optionally sweeping a
+netlist variable, either through a "qucsator --server" child process
+or through a server listening on a local socket.  Reports the time
+per run and optionally stores the returned datasets.
+
+Examples:
+
+  qucsclient.py -q src/qucsator netlist.txt --runs 100
+  qucsclient.py -q src/qucsator netlist.txt --set R1 100 200 300 -o out
+  qucsclient.py --socket /tmp/qucsator.sock netlist.txt --analysis SP1
+"""
+
+import argparse
+import os
+import socket
+import subprocess
+import sys
+import time
+
+
+class Server:
+    """Talks to the simulation server over a pair of binary streams."""
+
+    def __init__(self, qucsator=None, path=None):
+        self.proc = None
+        self.sock = None
+        if path:
+            self.sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            self.sock.connect(path)
+            self.rd = self.sock.makefile('rb')
+            self.wr = self.sock.makefile('wb')
+        else:
+            self.proc = subprocess.Popen([qucsator, '--server'],
+                                         stdin=subprocess.PIPE,
+                                         stdout=subprocess.PIPE,
+                                         stderr=subprocess.DEVNULL)
+            self.rd = self.proc.stdout
+            self.wr = self.proc.stdin
+
+    def job(self, line):
+        """Sends a job and returns (status line, dataset or None)."""
+        self.wr.write((line + '\n').encode())
+        self.wr.flush()
+        reply = self.rd.readline().decode().strip()
+        if not reply:
+            raise RuntimeError('server closed the connection')
+        if reply.startswith('error'):
+            raise RuntimeError('%s: %s' % (line, reply))
+        if reply.startswith('dataset'):
+            _, size, status = reply.split()
+            return int(status), self.rd.read(int(size)).decode()
+        return 0, None
+
+    def close(self, shutdown=False):
+        self.wr.write(b'shutdown\n' if shutdown else b'quit\n')
+        self.wr.flush()
+        if self.proc:
+            self.proc.wait()
+        if self.sock:
+            self.sock.close()
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__,
+                                 formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument('netlist', help='netlist to load')
+    ap.add_argument('-q', '--qucsator', default='qucsator',
+                    help='qucsator binary to start as server')
+    ap.add_argument('--socket', help='connect to a server on this socket')
+    ap.add_argument('--shutdown', action='store_true',
+                    help='stop the socket server when done')
+    ap.add_argument('--analysis', help='run only the named analysis')
+    ap.add_argument('--set', nargs='+', metavar=('NAME', 'VALUE'),
+                    help='run once for each value of the variable NAME')
+    ap.add_argument('--runs', type=int, default=1,
+                    help='number of runs without --set (default 1)')
+    ap.add_argument('-o', '--output', help='directory for the datasets')
+    args = ap.parse_args()
+
+    if args.set and len(args.set) < 2:
+        ap.error('--set needs a variable name and at least one value')
+
+    srv = Server(args.qucsator, args.socket)
+    t0 = time.perf_counter()
+    srv.job('load %s' % os.path.abspath(args.netlist))
+    print('load: %.3f ms' % ((time.perf_counter() - t0) * 1e3))
+
+    values = args.set[1:] if args.set else [None] * args.runs
+    run = 'run %s' % args.analysis if args.analysis else 'run'
+    if args.output:
+        os.makedirs(args.output, exist_ok=True)
+
+    total = 0.0
+    for i, value in enumerate(values):
+        t0 = time.perf_counter()
+        if value is not None:
+            srv.job('set %s %s' % (args.set[0], value))
+        status, data = srv.job(run)
+        dt = time.perf_counter() - t0
+        total += dt
+        print('run %d%s: %.3f ms, status %d, %d bytes' %
+              (i, '' if value is None else ' (%s=%s)' % (args.set[0], value),
+               dt * 1e3, status, len(data)))
+        if args.output:
+            with open(os.path.join(args.output, 'run%d.dat' % i), 'w') as f:
+                f.write(data)
+
+    print('average: %.3f ms per run' % (total / len(values) * 1e3))
+    srv.close(args.shutdown)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())